@@ -36,6 +36,7 @@
 #define OPENTESTPOINT_PROBEBUILDER_HEADER_
 
 #include "otestpoint/controller.h"
+#include "otestpoint/probeoptions.h"
 #include "otestpoint/toolkit/log/service.h"
 #include "otestpoint/toolkit/log/client.h"
 
@@ -67,6 +68,7 @@ namespace OpenTestPoint
     /**
      * Builds a Controller instance
      *
+     * @param sNodeId Controller id. Same for all controller probes.
      * @param logService Log service instance used to create
      * additional log clients. Shared reference with the main
      * application.
@@ -79,7 +81,8 @@ namespace OpenTestPoint
      *
      * @throws Toolkit::Exception on build error.
      */
-    void buildController(Toolkit::Log::Service & logService,
+    void buildController(const std::string & sNodeId,
+                         Toolkit::Log::Service & logService,
                          Toolkit::Log::Client & logClient,
                          const std::string & sServiceEndpoint,
                          const std::string & sPublishEndpoint);
@@ -93,6 +96,7 @@ namespace OpenTestPoint
      * @param commTimeout %Probe communication timeout threshold
      * @param sConfigurationFile Name of the plugin configuration
      * file. May be an empty string.
+     * @param options Optional probe settings.
      *
      * @throws Toolkit::Exception on build error.
      */
@@ -100,7 +104,8 @@ namespace OpenTestPoint
                           const std::string & sLibrary,
                           const std::chrono::seconds & probeRate,
                           const std::chrono::seconds & commTimeout,
-                          const std::string & sConfigurationFile);
+                          const std::string & sConfigurationFile,
+                          const ProbeOptions & options = ProbeOptions{});
 
     /**
      * Builds a probe instance from a python module
@@ -113,6 +118,7 @@ namespace OpenTestPoint
      * @param commTimeout %Probe communication timeout threshold
      * @param sConfigurationFile Name of the plugin configuration
      * file. May be an empty string.
+     * @param options Optional probe settings.
      *
      * @throws Toolkit::Exception on build error.
      */
@@ -121,7 +127,8 @@ namespace OpenTestPoint
                           const std::string & sClass,
                           const std::chrono::seconds & probeRate,
                           const std::chrono::seconds & commTimeout,
-                          const std::string & sConfigurationFile);
+                          const std::string & sConfigurationFile,
+                          const ProbeOptions & options = ProbeOptions{});
 
     /**
      * Gets the Controller instance.
@@ -135,6 +142,30 @@ namespace OpenTestPoint
      */
     Controller * getController();
 
+    /**
+     * Begins reconfiguring a Controller previously created by a
+     * ProbeBuilder. Probes built until endReconfiguration() is called
+     * describe the complete new set of probes.
+     *
+     * @param pController Controller to reconfigure. Ownership is not
+     * transferred.
+     *
+     * @throws Toolkit::Exception if the controller was not created by
+     * a ProbeBuilder.
+     */
+    void beginReconfiguration(Controller * pController);
+
+    /**
+     * Ends reconfiguration. Running probes built again with identical
+     * settings are left running, a changed rate is applied in place.
+     * Running probes not built again are stopped and destroyed, and
+     * new or changed probes are created, initialized and started if
+     * the controller is running.
+     *
+     * @throws Toolkit::Exception on build error.
+     */
+    void endReconfiguration();
+
   private:
     class Impl;
     Impl * pImpl_;
@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2026 - Adjacent Link LLC, Bridgewater, New Jersey
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  * Neither the name of Adjacent Link LLC nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * See toplevel COPYING for more information.
+ */
+
+#ifndef OPENTESTPOINT_PROBEDATABUFFER_HEADER_
+#define OPENTESTPOINT_PROBEDATABUFFER_HEADER_
+
+#include "otestpoint/types.h"
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace OpenTestPoint
+{
+  /**
+   * @class ProbeDataBuffer
+   *
+   * @brief Caller-provided storage for probe data.
+   *
+   * A buffer is owned by the probe manager and handed to
+   * ProbePlugin::probeInto() on every probe interval. Clearing the
+   * buffer does not release entries, so the string storage of an
+   * entry is reused by the next interval and a plugin that assigns
+   * into an existing entry does not allocate once its outputs have
+   * reached their steady state size.
+   */
+  class ProbeDataBuffer
+  {
+  public:
+    /**
+     * @class Entry
+     *
+     * @brief A single probe data item.
+     *
+     * A plugin that already holds the message serialization in its
+     * own storage may reference it with pSerialization and
+     * serializationSize instead of copying it into
+     * sSerialization. Referenced storage must remain valid until the
+     * next call to ProbePlugin::probeInto().
+     */
+    class Entry
+    {
+    public:
+      Entry():
+        u32Version{},
+        pSerialization{},
+        serializationSize{}{}
+
+      std::string sTopic;            ///< probe name
+      std::string sSerialization;    ///< probe message serialization
+      std::string sName;             ///< probe message name
+      std::string sModule;           ///< probe message module
+      std::uint32_t u32Version;      ///< probe message version
+      const char * pSerialization;   ///< referenced serialization, overrides sSerialization when set
+      std::size_t serializationSize; ///< referenced serialization length
+
+      /**
+       * Gets the serialization data
+       *
+       * @return Pointer to the referenced serialization if set,
+       * otherwise to sSerialization
+       */
+      const char * data() const;
+
+      /**
+       * Gets the serialization length
+       *
+       * @return Length in bytes
+       */
+      std::size_t size() const;
+    };
+
+    using const_iterator = std::vector<Entry>::const_iterator;
+
+    /**
+     * Creates an instance
+     */
+    ProbeDataBuffer();
+
+    /**
+     * Appends an entry
+     *
+     * The returned entry may contain data from a previous
+     * interval. All fields must be assigned, except that a
+     * referenced serialization is cleared.
+     *
+     * @return Reference to the appended entry, valid until the next
+     * call to append() or clear().
+     */
+    Entry & append();
+
+    /**
+     * Removes all entries while retaining their storage
+     */
+    void clear();
+
+    /**
+     * Gets the number of entries
+     *
+     * @return number of entries
+     */
+    std::size_t size() const;
+
+    /**
+     * Checks whether the buffer has no entries
+     *
+     * @return @a true if empty
+     */
+    bool empty() const;
+
+    const_iterator begin() const;
+
+    const_iterator end() const;
+
+    /**
+     * Appends entries from a legacy probe data list
+     *
+     * @param probeData %Probe data to move into the buffer
+     */
+    void append(ProbeData && probeData);
+
+  private:
+    std::vector<Entry> entries_;
+    std::size_t size_;
+  };
+}
+
+#include "otestpoint/probedatabuffer.inl"
+
+#endif // OPENTESTPOINT_PROBEDATABUFFER_HEADER_
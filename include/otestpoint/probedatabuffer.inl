@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2026 - Adjacent Link LLC, Bridgewater, New Jersey
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  * Neither the name of Adjacent Link LLC nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * See toplevel COPYING for more information.
+ */
+
+inline
+const char * OpenTestPoint::ProbeDataBuffer::Entry::data() const
+{
+  return pSerialization ? pSerialization : sSerialization.data();
+}
+
+inline
+std::size_t OpenTestPoint::ProbeDataBuffer::Entry::size() const
+{
+  return pSerialization ? serializationSize : sSerialization.size();
+}
+
+inline
+OpenTestPoint::ProbeDataBuffer::ProbeDataBuffer():
+  entries_{},
+  size_{}{}
+
+inline
+OpenTestPoint::ProbeDataBuffer::Entry & OpenTestPoint::ProbeDataBuffer::append()
+{
+  if(size_ == entries_.size())
+    {
+      entries_.emplace_back();
+    }
+
+  auto & entry = entries_[size_++];
+
+  entry.pSerialization = nullptr;
+  entry.serializationSize = 0;
+
+  return entry;
+}
+
+inline
+void OpenTestPoint::ProbeDataBuffer::append(ProbeData && probeData)
+{
+  for(auto & data : probeData)
+    {
+      auto & entry = append();
+
+      entry.sTopic = std::move(std::get<0>(data));
+      entry.sSerialization = std::move(std::get<1>(data));
+      entry.sName = std::move(std::get<2>(data));
+      entry.sModule = std::move(std::get<3>(data));
+      entry.u32Version = std::get<4>(data);
+    }
+}
+
+inline
+void OpenTestPoint::ProbeDataBuffer::clear()
+{
+  size_ = 0;
+}
+
+inline
+std::size_t OpenTestPoint::ProbeDataBuffer::size() const
+{
+  return size_;
+}
+
+inline
+bool OpenTestPoint::ProbeDataBuffer::empty() const
+{
+  return !size_;
+}
+
+inline
+OpenTestPoint::ProbeDataBuffer::const_iterator OpenTestPoint::ProbeDataBuffer::begin() const
+{
+  return entries_.begin();
+}
+
+inline
+OpenTestPoint::ProbeDataBuffer::const_iterator OpenTestPoint::ProbeDataBuffer::end() const
+{
+  return entries_.begin() + size_;
+}
@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) 2026 - Adjacent Link LLC, Bridgewater, New Jersey
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  * Neither the name of Adjacent Link LLC nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * See toplevel COPYING for more information.
+ */
+
+#ifndef OPENTESTPOINT_PROBEOPTIONS_HEADER_
+#define OPENTESTPOINT_PROBEOPTIONS_HEADER_
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace OpenTestPoint
+{
+  /**
+   * @class ProbeOptions
+   *
+   * @brief Optional per probe settings passed to the ProbeBuilder.
+   *
+   * Default constructed options reproduce the behavior of a probe
+   * configured with only a rate and communication threshold.
+   */
+  class ProbeOptions
+  {
+  public:
+    /**
+     * Probe interval phase
+     */
+    enum class Phase
+      {
+        ALIGNED,       ///< fire on the rate boundary
+        DETERMINISTIC, ///< fixed offset derived from node id and probe index
+        RANDOM         ///< fixed offset chosen at random when the probe is created
+      };
+
+    /**
+     * Host process scheduling policy
+     */
+    enum class Scheduler
+      {
+        INHERIT, ///< keep the policy inherited from otestpointd
+        OTHER,   ///< SCHED_OTHER at the configured nice level
+        FIFO     ///< SCHED_FIFO at the configured priority
+      };
+
+    ProbeOptions():
+      phase{Phase::ALIGNED},
+      phaseWindow{},
+      group{},
+      budget{},
+      affinity{},
+      scheduler{Scheduler::INHERIT},
+      nice{},
+      priority{},
+      cgroup{},
+      zygote{},
+      onDemand{},
+      idleRate{},
+      trace{}{}
+
+    /**
+     * Phase mode. Reports always carry the aligned (rate boundary)
+     * timestamp regardless of phase, only the time at which the
+     * probe is run and its report published is offset.
+     */
+    Phase phase;
+
+    /**
+     * Window the phase offset is chosen from. Zero selects the probe
+     * rate. Windows larger than the probe rate are limited to the
+     * probe rate.
+     */
+    std::chrono::milliseconds phaseWindow;
+
+    /**
+     * Host process group. Probes with the same non-empty group are
+     * hosted by a single otestpoint-probe process sharing one
+     * control and publish channel. An empty group runs the probe in
+     * its own process.
+     */
+    std::string group;
+
+    /**
+     * probe() execution time budget. Executions exceeding the budget
+     * are counted as overruns. Zero selects the probe rate.
+     */
+    std::chrono::milliseconds budget;
+
+    /**
+     * CPUs the host process is restricted to. Empty inherits the
+     * affinity of otestpointd.
+     *
+     * Affinity, scheduler and cgroup are applied by the host process
+     * as it starts, before it runs any threads. Probes sharing a
+     * group use the settings of the first probe built in the group.
+     */
+    std::vector<std::uint16_t> affinity;
+
+    /**
+     * Host process scheduling policy
+     */
+    Scheduler scheduler;
+
+    /**
+     * Nice level [-20,19], used with Scheduler::OTHER
+     */
+    int nice;
+
+    /**
+     * Realtime priority [1,99], used with Scheduler::FIFO
+     */
+    int priority;
+
+    /**
+     * cgroup (v2) the host process joins. A relative path is
+     * relative to /sys/fs/cgroup. Empty leaves the process in the
+     * cgroup of otestpointd.
+     */
+    std::string cgroup;
+
+    /**
+     * Start the host process by forking a pre-initialized
+     * otestpoint-probe zygote instead of executing otestpoint-probe.
+     * The zygote is started on first use and shared by all host
+     * processes. Falls back to executing otestpoint-probe when the
+     * zygote is unavailable.
+     */
+    bool zygote;
+
+    /**
+     * Run the probe only while one of its probe names has a
+     * subscriber on the controller publish endpoint. Brokers and
+     * recorders count as subscribers.
+     */
+    bool onDemand;
+
+    /**
+     * Rate used by an on demand probe without subscribers. Zero
+     * skips the probe until a subscriber is present.
+     */
+    std::chrono::seconds idleRate;
+
+    /**
+     * Add trace stamps to the probe reports: probe() start and end,
+     * the publish time and a stamp for every controller and broker
+     * forwarding the report. Stamps are microseconds since the
+     * epoch, hops on other hosts require synchronized clocks.
+     */
+    bool trace;
+  };
+}
+
+#endif // OPENTESTPOINT_PROBEOPTIONS_HEADER_
@@ -36,6 +36,7 @@
 #define OPENTESTPOINT_PROBEPLUGIN_HEADER_
 
 #include "otestpoint/types.h"
+#include "otestpoint/probedatabuffer.h"
 #include "otestpoint/probeserviceuser.h"
 
 #include <string>
@@ -55,8 +56,9 @@ namespace OpenTestPoint
    *   - stop
    *   - destory
    *
-   * and a virtual method to query probe data:
+   * and virtual methods to query probe data:
    *   - probe
+   *   - probeInto
    *
    * @dot
    * digraph G {
@@ -124,6 +126,21 @@ namespace OpenTestPoint
      */
     virtual ProbeData probe() = 0;
 
+    /**
+     * Retrieves the current probe data into caller-provided storage
+     *
+     * The default implementation appends the result of probe().
+     * Plugins that override this method and assign into the
+     * appended entries avoid per interval allocations.
+     *
+     * @param buffer Buffer to append entries to. The buffer is
+     * cleared by the caller before each call.
+     */
+    virtual void probeInto(ProbeDataBuffer & buffer)
+    {
+      buffer.append(probe());
+    }
+
     /**
      * Gets the probe index
      *
@@ -77,45 +77,53 @@ namespace OpenTestPoint
  * Logs a printf style log message at ERROR level.
  *
  * @param pService PlatformService reference
- * @param fmt format string (see printf)
+ * @param fmt format string (see printf), formatted by the
+ * log service
  * @param args Variable data (see printf)
  */
 #define OPENTESTPOINT_PROBESERVICE_LOG_ERROR(pService,fmt,args...)      \
-  (pService)->logClient()->log(OpenTestPoint::Toolkit::Log::Level::ERROR_LEVEL, \
-                               fmt,## args)
+  OPENTESTPOINT_TOOLKIT_LOG_DEFERRED((pService)->logClient(),                \
+                                     OpenTestPoint::Toolkit::Log::Level::ERROR_LEVEL, \
+                                     fmt,## args)
 
 /**
  * Logs a printf style log message at ABORT level.
  *
  * @param pService PlatformService reference
- * @param fmt format string (see printf)
+ * @param fmt format string (see printf), formatted by the
+ * log service
  * @param args Variable data (see printf)
  */
 #define OPENTESTPOINT_PROBESERVICE_LOG_ABORT(pService,fmt,args...)      \
-  (pService)->logClient()->log(OpenTestPoint::Toolkit::Log::Level::ABORT_LEVEL, \
-                               fmt,## args)
+  OPENTESTPOINT_TOOLKIT_LOG_DEFERRED((pService)->logClient(),                \
+                                     OpenTestPoint::Toolkit::Log::Level::ABORT_LEVEL, \
+                                     fmt,## args)
 
 /**
  * Logs a printf style log message at INFO level.
  *
  * @param pService PlatformService reference
- * @param fmt format string (see printf)
+ * @param fmt format string (see printf), formatted by the
+ * log service
  * @param args Variable data (see printf)
  */
 #define OPENTESTPOINT_PROBESERVICE_LOG_INFO(pService,fmt,args...)       \
-  (pService)->logClient()->log(OpenTestPoint::Toolkit::Log::Level::INFO_LEVEL, \
-                               fmt,## args)
+  OPENTESTPOINT_TOOLKIT_LOG_DEFERRED((pService)->logClient(),                \
+                                     OpenTestPoint::Toolkit::Log::Level::INFO_LEVEL, \
+                                     fmt,## args)
 
 /**
  * Logs a printf style log message at DEBUG level.
  *
  * @param pService PlatformService reference
- * @param fmt format string (see printf)
+ * @param fmt format string (see printf), formatted by the
+ * log service
  * @param args Variable data (see printf)
  */
 #define OPENTESTPOINT_PROBESERVICE_LOG_DEBUG(pService,fmt,args...)      \
-  (pService)->logClient()->log(OpenTestPoint::Toolkit::Log::Level::DEBUG_LEVEL, \
-                               fmt,## args)
+  OPENTESTPOINT_TOOLKIT_LOG_DEFERRED((pService)->logClient(),                \
+                                     OpenTestPoint::Toolkit::Log::Level::DEBUG_LEVEL, \
+                                     fmt,## args)
 
 /**
  * Logs a printf style log message at ERROR level with appended
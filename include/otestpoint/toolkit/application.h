@@ -74,6 +74,9 @@ namespace OpenTestPoint
 
       virtual void doDestroy(){}
 
+      // called on SIGHUP while running
+      virtual void doReload(const std::string &){}
+
       virtual std::vector<option> doGetOptions() const
       {
         return {};
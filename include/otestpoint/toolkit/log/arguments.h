@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2026 - Adjacent Link LLC, Bridgewater, New Jersey
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  * Neither the name of Adjacent Link LLC nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * See toplevel COPYING for more information.
+ */
+
+#ifndef OPENTESTPOINT_TOOLKIT_LOG_ARGUMENTS_HEADER_
+#define OPENTESTPOINT_TOOLKIT_LOG_ARGUMENTS_HEADER_
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+namespace OpenTestPoint
+{
+  namespace Toolkit
+  {
+    namespace Log
+    {
+      // binary encoding of printf style arguments, formatted later by
+      // the log service: each argument is a type octet followed by
+      // its value, strings are a 16 bit length followed by their
+      // characters
+      class Arguments
+      {
+      public:
+        enum Type : std::uint8_t
+        {
+          TYPE_INT = 1,
+          TYPE_UINT = 2,
+          TYPE_LONG = 3,
+          TYPE_ULONG = 4,
+          TYPE_LONGLONG = 5,
+          TYPE_ULONGLONG = 6,
+          TYPE_DOUBLE = 7,
+          TYPE_STRING = 8,
+          TYPE_POINTER = 9,
+        };
+
+        static const std::size_t MAX_SIZE{1024};
+
+        Arguments():
+          size_{}{}
+
+        void add(int iValue){put(TYPE_INT,iValue);}
+
+        void add(unsigned int u32Value){put(TYPE_UINT,u32Value);}
+
+        void add(long lValue){put(TYPE_LONG,lValue);}
+
+        void add(unsigned long ulValue){put(TYPE_ULONG,ulValue);}
+
+        void add(long long llValue){put(TYPE_LONGLONG,llValue);}
+
+        void add(unsigned long long ullValue){put(TYPE_ULONGLONG,ullValue);}
+
+        void add(double dValue){put(TYPE_DOUBLE,dValue);}
+
+        void add(const void * pValue){put(TYPE_POINTER,pValue);}
+
+        void add(const char * pzValue);
+
+        const char * data() const
+        {
+          return buffer_;
+        }
+
+        std::size_t size() const
+        {
+          return size_;
+        }
+
+        // formats an encoding, missing or mismatched arguments are
+        // left as their conversion specification
+        static std::string format(const char * pzFormat,
+                                  const char * pArguments,
+                                  std::size_t length);
+
+      private:
+        char buffer_[MAX_SIZE];
+        std::size_t size_;
+
+        template<typename T>
+        void put(Type type, T value);
+      };
+    }
+  }
+}
+
+template<typename T>
+inline
+void OpenTestPoint::Toolkit::Log::Arguments::put(Type type, T value)
+{
+  if(size_ + 1 + sizeof(value) <= MAX_SIZE)
+    {
+      buffer_[size_++] = type;
+
+      std::memcpy(buffer_ + size_,&value,sizeof(value));
+
+      size_ += sizeof(value);
+    }
+}
+
+inline
+void OpenTestPoint::Toolkit::Log::Arguments::add(const char * pzValue)
+{
+  if(!pzValue)
+    {
+      pzValue = "(null)";
+    }
+
+  std::uint16_t u16Length{};
+
+  if(size_ + 1 + sizeof(u16Length) <= MAX_SIZE)
+    {
+      // strings are truncated to the remaining space
+      u16Length = std::min(std::strlen(pzValue),MAX_SIZE - size_ - 1 - sizeof(u16Length));
+
+      buffer_[size_++] = TYPE_STRING;
+
+      std::memcpy(buffer_ + size_,&u16Length,sizeof(u16Length));
+
+      size_ += sizeof(u16Length);
+
+      std::memcpy(buffer_ + size_,pzValue,u16Length);
+
+      size_ += u16Length;
+    }
+}
+
+#endif // OPENTESTPOINT_TOOLKIT_LOG_ARGUMENTS_HEADER_
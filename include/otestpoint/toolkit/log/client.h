@@ -41,6 +41,8 @@
 #include <chrono>
 
 #include "otestpoint/toolkit/log/level.h"
+#include "otestpoint/toolkit/log/arguments.h"
+#include "otestpoint/toolkit/log/statistics.h"
 
 namespace OpenTestPoint
 {
@@ -61,10 +63,42 @@ namespace OpenTestPoint
         void logfn(Level level, Function fn,const char *fmt,...)
           __attribute__ ((format (printf, 4, 5)));
 
+        // records a copy of the format and a binary encoding of the
+        // arguments, formatting is done by the log service. Use
+        // OPENTESTPOINT_TOOLKIT_LOG_DEFERRED to check the arguments
+        // against the format.
+        template <typename... Args>
+        void logDeferred(Level level, const char * pzFormat, const Args &... args);
+
+        // as logDeferred, rate limited by the given call site identity,
+        // used where one call site logs on behalf of several sources.
+        // Use OPENTESTPOINT_TOOLKIT_LOG_SITE.
+        template <typename... Args>
+        void logSite(Level level,
+                     const void * pSite,
+                     const char * pzFormat,
+                     const Args &... args);
+
+        // logs a formatted message rate limited by the given call
+        // site identity, used where the format does not identify the
+        // call site
+        void logMessage(Level level, const void * pSite, const char * pzMessage);
+
+        // limits every call site logging at the level to dRate records
+        // per second, in bursts of up to dBurst records, per calling
+        // thread. A call site is identified by its format. The number
+        // of suppressed records is logged ahead of the next record the
+        // call site is allowed. A rate of 0 removes the limit.
+        virtual void setRateLimit(Level level, double dRate, double dBurst) = 0;
+
+        // endpoints of the process log multiplexer, shared by every
+        // client in the process
         virtual std::string getControlEndpoint() const = 0;
 
         virtual std::string getPublishEndpoint() const = 0;
 
+        virtual ClientStatistics getStatistics() const = 0;
+
       protected:
         Client(const std::string & sLabel);
 
@@ -73,14 +107,38 @@ namespace OpenTestPoint
       private:
         virtual bool allowLog_i(Level level) = 0;
 
+        virtual bool allowSite_i(Level level, const void * pSite) = 0;
+
         virtual void log_i(Level level,
                            const std::chrono::high_resolution_clock::time_point & timestamp,
                            const std::list<std::string> & strings) = 0;
+
+        // formats immediately unless overridden
+        virtual void logDeferred_i(Level level,
+                                   const std::chrono::high_resolution_clock::time_point & timestamp,
+                                   const char * pzFormat,
+                                   const Arguments & arguments);
       };
+
+      // never called, checks deferred log arguments against the format
+      int checkFormat(const char * fmt,...) __attribute__ ((format (printf, 1, 2)));
     }
   }
 }
 
+#define OPENTESTPOINT_TOOLKIT_LOG_DEFERRED(pClient,level,fmt,args...)   \
+  (pClient)->logDeferred((level),                                       \
+                         (static_cast<void>(sizeof(OpenTestPoint::Toolkit::Log::checkFormat(fmt,## args))), \
+                          fmt),                                         \
+                         ## args)
+
+#define OPENTESTPOINT_TOOLKIT_LOG_SITE(pClient,level,pSite,fmt,args...) \
+  (pClient)->logSite((level),                                           \
+                     (pSite),                                           \
+                     (static_cast<void>(sizeof(OpenTestPoint::Toolkit::Log::checkFormat(fmt,## args))), \
+                      fmt),                                             \
+                     ## args)
+
 #include "otestpoint/toolkit/log/client.inl"
 
 #endif // OPENTESTPOINT_TOOLKIT_LOG_CLIENT_HEADER_
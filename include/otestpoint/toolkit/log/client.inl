@@ -41,7 +41,7 @@ void OpenTestPoint::Toolkit::Log::Client::logfn(Level level,
                                                 const char *fmt,
                                                 ...)
 {
-  if(allowLog_i(level))
+  if(allowLog_i(level) && allowSite_i(level,fmt))
     {
       auto now = std::chrono::high_resolution_clock::now();
 
@@ -62,3 +62,47 @@ void OpenTestPoint::Toolkit::Log::Client::logfn(Level level,
       log_i(level,now,strings);
     }
 }
+
+template <typename... Args>
+void OpenTestPoint::Toolkit::Log::Client::logDeferred(Level level,
+                                                      const char * pzFormat,
+                                                      const Args &... args)
+{
+  logSite(level,pzFormat,pzFormat,args...);
+}
+
+template <typename... Args>
+void OpenTestPoint::Toolkit::Log::Client::logSite(Level level,
+                                                  const void * pSite,
+                                                  const char * pzFormat,
+                                                  const Args &... args)
+{
+  if(allowLog_i(level) && allowSite_i(level,pSite))
+    {
+      auto now = std::chrono::high_resolution_clock::now();
+
+      Arguments arguments{};
+
+      int expand[]{0,(arguments.add(args),0)...};
+
+      static_cast<void>(expand);
+
+      logDeferred_i(level,now,pzFormat,arguments);
+    }
+}
+
+inline void OpenTestPoint::Toolkit::Log::Client::logMessage(Level level,
+                                                            const void * pSite,
+                                                            const char * pzMessage)
+{
+  if(allowLog_i(level) && allowSite_i(level,pSite))
+    {
+      auto now = std::chrono::high_resolution_clock::now();
+
+      Arguments arguments{};
+
+      arguments.add(pzMessage);
+
+      logDeferred_i(level,now,"%s",arguments);
+    }
+}
@@ -36,8 +36,11 @@
 #define OPENTESTPOINT_TOOLKIT_LOG_SERVICE_HEADER_
 
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "otestpoint/toolkit/log/level.h"
+#include "otestpoint/toolkit/log/statistics.h"
 
 namespace OpenTestPoint
 {
@@ -45,17 +48,46 @@ namespace OpenTestPoint
   {
     namespace Log
     {
+      // label pattern and the level of matching clients
+      using LevelRules = std::vector<std::pair<std::string,Level>>;
+
       class Service
       {
       public:
         virtual ~Service(){};
 
+        // subscribes to the log records of a process and pushes it
+        // the level and rules without waiting for a reply. Records
+        // logged before the push arrives use the process's own level.
         virtual void add(const std::string & sControlEndpoint,
                          const std::string & sPublishEndpoint) = 0;
 
+        // ends the subscription of a process added with add(), call
+        // once the process has exited or been replaced
+        virtual void remove(const std::string & sControlEndpoint,
+                            const std::string & sPublishEndpoint) = 0;
 
         virtual void setLevel(Level level) = 0;
 
+        // replaces the label level rules, the level passed to
+        // setLevel() applies to labels no rule matches. A pattern
+        // matches a client label:
+        //
+        //   label    exactly
+        //   label/*  exactly or any label below it
+        //   label*   by prefix
+        //
+        // A pattern starting with / is matched against the label
+        // without its first segment, /node3/7/* matches
+        // otestpoint-probe/node3/7. The longest matching pattern
+        // wins. Rules are applied by the clients, filtered records
+        // are never sent.
+        virtual void setLevelRules(const LevelRules & rules) = 0;
+
+        // record and output write counters, safe to call from any
+        // thread
+        virtual ServiceStatistics getStatistics() const = 0;
+
       protected:
         Service(){}
       };
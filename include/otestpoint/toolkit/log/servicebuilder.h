@@ -38,6 +38,7 @@
 #include <string>
 
 #include "otestpoint/toolkit/log/service.h"
+#include "otestpoint/toolkit/log/sinkoptions.h"
 
 namespace OpenTestPoint
 {
@@ -49,7 +50,8 @@ namespace OpenTestPoint
       {
       public:
         Service * buildService(Level level,
-                               const std::string & sLogFileName = "");
+                               const std::string & sLogFileName = "",
+                               const SinkOptions & options = SinkOptions{});
       };
     }
   }
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2026 - Adjacent Link LLC, Bridgewater, New Jersey
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  * Neither the name of Adjacent Link LLC nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * See toplevel COPYING for more information.
+ */
+
+#ifndef OPENTESTPOINT_TOOLKIT_LOG_SINKOPTIONS_HEADER_
+#define OPENTESTPOINT_TOOLKIT_LOG_SINKOPTIONS_HEADER_
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace OpenTestPoint
+{
+  namespace Toolkit
+  {
+    namespace Log
+    {
+      /**
+       * @enum SinkFormat
+       *
+       * @brief Log service output format
+       */
+      enum class SinkFormat
+      {
+        /** HH:MM:SS.uuuuuu LEVEL [label] message */
+        TEXT,
+        /** one object per line: timestamp (usec), level, label and message */
+        JSON,
+        /** varint length delimited LogPublisher.Record messages holding
+            timestamp, level, label and the message as its single log */
+        BINARY,
+      };
+
+      /**
+       * @struct SinkOptions
+       *
+       * @brief Log service output buffering, rotation and format
+       *
+       * Rotation only applies to log files. A value of 0 disables the
+       * corresponding rotation trigger.
+       */
+      struct SinkOptions
+      {
+        SinkFormat format{SinkFormat::TEXT};
+
+        /** bytes buffered before writing */
+        std::size_t bufferSize{65536};
+
+        /** longest time a record is buffered */
+        std::chrono::milliseconds flushInterval{100};
+
+        /** rotate once the log file reaches this many bytes */
+        std::uint64_t u64RotateSize{};
+
+        /** rotate once the log file holds this many records */
+        std::uint64_t u64RotateRecords{};
+
+        /** rotated files kept as FILE.1 (newest) through FILE.N */
+        std::uint32_t u32RotateKeep{5};
+      };
+
+      /**
+       * Converts a format name: text, json or binary
+       *
+       * @throw Exception on an unknown name
+       */
+      SinkFormat toSinkFormat(const std::string & sFormat);
+    }
+  }
+}
+
+#endif // OPENTESTPOINT_TOOLKIT_LOG_SINKOPTIONS_HEADER_
@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2026 - Adjacent Link LLC, Bridgewater, New Jersey
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  * Neither the name of Adjacent Link LLC nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * See toplevel COPYING for more information.
+ */
+
+#ifndef OPENTESTPOINT_TOOLKIT_LOG_STATISTICS_HEADER_
+#define OPENTESTPOINT_TOOLKIT_LOG_STATISTICS_HEADER_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace OpenTestPoint
+{
+  namespace Toolkit
+  {
+    namespace Log
+    {
+      /**
+       * @struct ClientStatistics
+       *
+       * @brief Log client counters since the client was created
+       */
+      struct ClientStatistics
+      {
+        std::string sLabel;
+
+        /** records accepted for publishing */
+        std::uint64_t u64Emitted{};
+
+        /** records below the client level or rate limited */
+        std::uint64_t u64Filtered{};
+
+        /** records lost to a full ring or a failed publish */
+        std::uint64_t u64Dropped{};
+
+        /** message bytes of the emitted records */
+        std::uint64_t u64Bytes{};
+      };
+
+      using ClientStatisticsList = std::vector<ClientStatistics>;
+
+      /**
+       * @struct ServiceStatistics
+       *
+       * @brief Log service counters since the service was created
+       */
+      struct ServiceStatistics
+      {
+        /** records received from log clients */
+        std::uint64_t u64Received{};
+
+        /** records written to the log output */
+        std::uint64_t u64Written{};
+
+        /** records lost to a failed write */
+        std::uint64_t u64Lost{};
+
+        /** writes of the output buffer */
+        std::uint64_t u64Writes{};
+
+        /** total and longest time spent in output buffer writes */
+        std::uint64_t u64WriteTotalUsec{};
+
+        std::uint64_t u64WriteMaxUsec{};
+      };
+
+      /**
+       * Gets the counters of every log client in the calling process
+       */
+      ClientStatisticsList getClientStatistics();
+    }
+  }
+}
+
+#endif // OPENTESTPOINT_TOOLKIT_LOG_STATISTICS_HEADER_
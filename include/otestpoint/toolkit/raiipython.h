@@ -53,6 +53,27 @@ namespace OpenTestPoint
     };
 
     using RAIIPyObject = RAIIObject<PyObject,PyObjectDestory>;
+
+    // holds the GIL for the lifetime of the object, usable from
+    // any thread once the interpreter has been initialized
+    class RAIIPyGIL
+    {
+    public:
+      RAIIPyGIL():
+        state_{PyGILState_Ensure()}{}
+
+      ~RAIIPyGIL()
+      {
+        PyGILState_Release(state_);
+      }
+
+      RAIIPyGIL(const RAIIPyGIL &) = delete;
+
+      RAIIPyGIL & operator=(const RAIIPyGIL &) = delete;
+
+    private:
+      PyGILState_STATE state_;
+    };
   }
 }
 
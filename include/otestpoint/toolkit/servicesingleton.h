@@ -64,20 +64,20 @@ namespace OpenTestPoint
 }
 
 #define OPENTESTPOINT_TOOLKIT_LOG_ERROR(fmt,args...)                    \
-  OpenTestPoint::Toolkit::ServiceSingleton::instance()->logClient()->   \
-  log(OpenTestPoint::Toolkit::Log::Level::ERROR_LEVEL,fmt,## args)
+  OPENTESTPOINT_TOOLKIT_LOG_DEFERRED(OpenTestPoint::Toolkit::ServiceSingleton::instance()->logClient(), \
+                                     OpenTestPoint::Toolkit::Log::Level::ERROR_LEVEL,fmt,## args)
 
 #define OPENTESTPOINT_TOOLKIT_LOG_ABORT(fmt,args...)                    \
-  OpenTestPoint::Toolkit::ServiceSingleton::instance()->logClient()->   \
-  log(OpenTestPoint::Toolkit::Log::Level::ABORT_LEVEL,fmt,## args)
+  OPENTESTPOINT_TOOLKIT_LOG_DEFERRED(OpenTestPoint::Toolkit::ServiceSingleton::instance()->logClient(), \
+                                     OpenTestPoint::Toolkit::Log::Level::ABORT_LEVEL,fmt,## args)
 
 #define OPENTESTPOINT_TOOLKIT_LOG_INFO(fmt,args...)                     \
-  OpenTestPoint::Toolkit::ServiceSingleton::instance()->logClient()->   \
-  log(OpenTestPoint::Toolkit::Log::Level::INFO_LEVEL,fmt,## args)
+  OPENTESTPOINT_TOOLKIT_LOG_DEFERRED(OpenTestPoint::Toolkit::ServiceSingleton::instance()->logClient(), \
+                                     OpenTestPoint::Toolkit::Log::Level::INFO_LEVEL,fmt,## args)
 
 #define OPENTESTPOINT_TOOLKIT_LOG_DEBUG(fmt,args...)                    \
-  OpenTestPoint::Toolkit::ServiceSingleton::instance()->logClient()->   \
-  log(OpenTestPoint::Toolkit::Log::Level::DEBUG_LEVEL,fmt,## args)
+  OPENTESTPOINT_TOOLKIT_LOG_DEFERRED(OpenTestPoint::Toolkit::ServiceSingleton::instance()->logClient(), \
+                                     OpenTestPoint::Toolkit::Log::Level::DEBUG_LEVEL,fmt,## args)
 
 #define OPENTESTPOINT_TOOLKIT_LOG_FN_ERROR(fn,fmt,args...)              \
   OpenTestPoint::Toolkit::ServiceSingleton::instance()->logClient()->   \
@@ -32,12 +32,22 @@
  * See toplevel COPYING for more information.
  */
 #include <Python.h>
-#include "otestpoint/toolkit/stringto.h"
 #include "probemanager.h"
 #include <google/protobuf/stubs/common.h>
 #include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
 #include <cstdlib>
+#include <cstring>
+#include <cstdint>
 #include <signal.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
 #include <uuid.h>
 
 #ifndef HAVE_SECURE_GETENV
@@ -48,58 +58,272 @@
 #  endif
 #endif
 
-int main()
+namespace
 {
-  GOOGLE_PROTOBUF_VERIFY_VERSION;
-  Py_InitializeEx(0);
+  // imported by the zygote so forked probes start with them loaded
+  const char * PreloadModules[] =
+    {
+      "google.protobuf",
+      "google.protobuf.message",
+      "otestpoint.interface.probe",
+      "otestpoint.interface.measurementtable_pb2",
+      "otestpoint.toolkit.logger",
+    };
 
-#if PY_MAJOR_VERSION < 3 || (PY_MAJOR_VERSION == 3 && PY_MINOR_VERSION <= 6)
+  // applies the placement and scheduling environment entries set by
+  // libotestpoint, called while the process is single threaded
+  bool configure()
+  {
+    const char * pzCGroup = secure_getenv("cgroup");
 
-  PyEval_InitThreads();
+    if(pzCGroup && *pzCGroup)
+      {
+        std::string sProcs{*pzCGroup == '/' ?
+            pzCGroup : std::string{"/sys/fs/cgroup/"} + pzCGroup};
+
+        sProcs.append("/cgroup.procs");
+
+        std::ofstream ofs{sProcs};
+
+        // 0 moves the writing process
+        if(!(ofs<<0<<std::flush))
+          {
+            std::cerr<<"unable to join cgroup "<<pzCGroup<<std::endl;
+            return false;
+          }
+      }
+
+    const char * pzAffinity = secure_getenv("affinity");
+
+    if(pzAffinity)
+      {
+        cpu_set_t cpuSet;
+
+        CPU_ZERO(&cpuSet);
+
+        std::istringstream iss{pzAffinity};
+
+        std::string sCPU{};
+
+        while(std::getline(iss,sCPU,','))
+          {
+            CPU_SET(std::stoul(sCPU),&cpuSet);
+          }
+
+        if(sched_setaffinity(0,sizeof(cpuSet),&cpuSet))
+          {
+            std::cerr<<"unable to set cpu affinity: "<<strerror(errno)<<std::endl;
+            return false;
+          }
+      }
+
+    const char * pzScheduler = secure_getenv("scheduler");
+
+    if(pzScheduler && !strcmp(pzScheduler,"other"))
+      {
+        const char * pzNice = secure_getenv("nice");
+
+        int iNice{pzNice ? atoi(pzNice) : 0};
+
+        // otestpointd may be running realtime
+        struct sched_param schedParam{0};
+
+        if(sched_setscheduler(0,SCHED_OTHER,&schedParam))
+          {
+            std::cerr<<"unable to set scheduler: "<<strerror(errno)<<std::endl;
+            return false;
+          }
+
+        if(setpriority(PRIO_PROCESS,0,iNice))
+          {
+            std::cerr<<"unable to set nice level "<<iNice<<": "<<strerror(errno)<<std::endl;
+            return false;
+          }
+      }
+    else if(pzScheduler && !strcmp(pzScheduler,"fifo"))
+      {
+        const char * pzPriority = secure_getenv("priority");
+
+        struct sched_param schedParam{pzPriority ? atoi(pzPriority) : 0};
+
+        if(sched_setscheduler(0,SCHED_FIFO,&schedParam))
+          {
+            std::cerr<<"unable to set realtime priority "<<schedParam.sched_priority
+                     <<": "<<strerror(errno)<<std::endl;
+            return false;
+          }
+      }
+
+    return true;
+  }
+
+  int probe()
+  {
+    // release the GIL, python probes acquire it on their worker thread
+    PyThreadState * pThreadState{PyEval_SaveThread()};
+
+    try
+      {
+        const char * pzStatus = secure_getenv("status");
+        const char * pzNodeId = secure_getenv("nodeid");
+        const char * pzHostId = secure_getenv("hostid");
+        const char * pzUUID = secure_getenv("uuid");
+
+        if(!pzStatus || !pzNodeId || !pzHostId || !pzUUID)
+          {
+            std::cerr<<"Error otestpoint-probe is for use by libotestpoint."<<std::endl;
+            return EXIT_FAILURE;
+          }
+
+        uuid_t uuid;
+
+        uuid_parse(pzUUID,uuid);
+
+        OpenTestPoint::ProbeManager probeManager{pzStatus,
+            pzNodeId,
+            pzHostId,
+            uuid};
+
+        probeManager.run();
+
+      }
+    catch(std::exception & exp)
+      {
+        std::cerr<<exp.what()<<std::endl;
+
+        return EXIT_FAILURE;
+      }
+
+    PyEval_RestoreThread(pThreadState);
 
+    Py_Finalize();
+
+    return EXIT_SUCCESS;
+  }
+
+  // serves spawn requests from libotestpoint until the channel
+  // closes, each request is a datagram of nul terminated environment
+  // entries, placement included, answered with the pid of the forked
+  // probe
+  int zygote(int iFd)
+  {
+    for(const auto & pzModule : PreloadModules)
+      {
+        PyObject * pModule{PyImport_ImportModule(pzModule)};
+
+        if(pModule)
+          {
+            Py_DECREF(pModule);
+          }
+        else
+          {
+            PyErr_Clear();
+          }
+      }
+
+    std::vector<char> request(65536);
+
+    while(true)
+      {
+        ssize_t len{recv(iFd,request.data(),request.size() - 1,0)};
+
+        if(len < 0 && errno == EINTR)
+          {
+            continue;
+          }
+
+        if(len <= 0)
+          {
+            break;
+          }
+
+        request[len] = '\0';
+
+#if PY_VERSION_HEX >= 0x03070000
+        PyOS_BeforeFork();
 #endif
 
-  try
-    {
-      const char * pzStatus = secure_getenv("status");
-      const char * pzNodeId = secure_getenv("nodeid");
-      const char * pzProbeIndex = secure_getenv("probeindex");
-      const char * pzProbeRate = secure_getenv("proberate");
-      const char * pzUUID = secure_getenv("uuid");
+        // CLONE_PARENT makes the probe a child of the requesting
+        // process, so it is supervised and reaped as if exec'd
+        // directly, which fork() cannot do. The raw clone skips the
+        // pthread_atfork handlers and the lock resets glibc performs
+        // in fork(). Neither is needed: the zygote is single
+        // threaded, so no lock can be held by another thread, and the
+        // only fork handlers registered are Python's, which
+        // PyOS_BeforeFork() and PyOS_AfterFork_Child() run.
+        pid_t pid = syscall(SYS_clone,CLONE_PARENT | SIGCHLD,0,0,0,0);
 
-      if(!pzStatus || !pzNodeId || !pzProbeIndex ||
-         !pzUUID || !pzProbeRate)
-        {
-          std::cerr<<"Error otestpoint-probe is for use by libotestpoint."<<std::endl;
-          return EXIT_FAILURE;
-        }
+        std::int32_t i32Pid{pid < 0 ? -errno : pid};
 
-      struct sigaction action;
+        if(pid == 0)
+          {
+            // child
+#if PY_VERSION_HEX >= 0x03070000
+            PyOS_AfterFork_Child();
+#else
+            PyOS_AfterFork();
+#endif
+            close(iFd);
 
-      memset(&action,0,sizeof(action));
-      action.sa_handler = SIG_IGN;
-      sigaction(SIGINT,&action,nullptr);
-      sigaction(SIGQUIT,&action,nullptr);
+            for(char * pzEntry = request.data();
+                pzEntry < request.data() + len;
+                pzEntry += strlen(pzEntry) + 1)
+              {
+                putenv(pzEntry);
+              }
 
-      uuid_t uuid;
+            // still single threaded
+            if(!configure())
+              {
+                exit(EXIT_FAILURE);
+              }
 
-      uuid_parse(pzUUID,uuid);
+            exit(probe());
+          }
 
-      OpenTestPoint::ProbeManager probeManager{pzStatus,
-          pzNodeId,
-          OpenTestPoint::Toolkit::strToUINT16(pzProbeIndex),
-          uuid,
-          OpenTestPoint::Toolkit::strToUINT16(pzProbeRate)};
+#if PY_VERSION_HEX >= 0x03070000
+        PyOS_AfterFork_Parent();
+#endif
 
-      probeManager.run();
+        send(iFd,&i32Pid,sizeof(i32Pid),MSG_NOSIGNAL);
+      }
 
-    }
-  catch(std::exception & exp)
-    {
-      std::cerr<<exp.what()<<std::endl;
+    Py_Finalize();
 
+    return EXIT_SUCCESS;
+  }
+}
+
+int main()
+{
+  GOOGLE_PROTOBUF_VERIFY_VERSION;
+
+  const char * pzZygote = secure_getenv("zygote");
+
+  if(!pzZygote && !configure())
+    {
       return EXIT_FAILURE;
     }
 
-  Py_Finalize();
+  Py_InitializeEx(0);
+
+#if PY_MAJOR_VERSION < 3 || (PY_MAJOR_VERSION == 3 && PY_MINOR_VERSION <= 6)
+
+  PyEval_InitThreads();
+
+#endif
+
+  struct sigaction action;
+
+  memset(&action,0,sizeof(action));
+  action.sa_handler = SIG_IGN;
+  sigaction(SIGINT,&action,nullptr);
+  sigaction(SIGQUIT,&action,nullptr);
+
+  if(pzZygote)
+    {
+      return zygote(atoi(pzZygote));
+    }
+
+  return probe();
 }
@@ -96,3 +96,8 @@ OpenTestPoint::PluginProbeAdapter::probe()
 {
   return pPlugin_->probe();
 }
+
+void OpenTestPoint::PluginProbeAdapter::probeInto(ProbeDataBuffer & buffer)
+{
+  pPlugin_->probeInto(buffer);
+}
@@ -60,6 +60,8 @@ namespace OpenTestPoint
 
     ProbeData probe() override;
 
+    void probeInto(ProbeDataBuffer & buffer) override;
+
   private:
     void * pLib_;
     ProbePlugin * pPlugin_;
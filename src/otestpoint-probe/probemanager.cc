@@ -38,6 +38,7 @@
 #include "libotestpoint.pb.h"
 #include "probereport.pb.h"
 #include "probeserviceimpl.h"
+#include "probereportpublisher.h"
 
 #include "otestpoint/toolkit/exception.h"
 #include "otestpoint/toolkit/transaction.h"
@@ -48,28 +49,195 @@
 #include <sys/timerfd.h>
 #include <chrono>
 #include <sstream>
+#include <limits>
+#include <ctime>
 
-std::int64_t scheduleNextProbe(int iFd,int iDelta);
+#include <unistd.h>
+#include <vector>
+
+std::int64_t scheduleNextProbe(int iFd,
+                               int iDelta,
+                               const std::chrono::microseconds & phaseOffset);
+
+namespace
+{
+  // seconds between probe timing and log statistics reports
+  const std::int64_t TimingReportInterval{10};
+
+  // errors logged per second and burst per call site and slot, a
+  // probe failing every tick reports once every 10 seconds after the
+  // first few
+  const double ErrorLogRate{0.1};
+  const double ErrorLogBurst{5};
+
+  std::uint64_t epochMicroseconds()
+  {
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+  }
+}
+
+OpenTestPoint::ProbeManager::Slot::Slot():
+  iTimerFd_{-1},
+  u16ProbeRate_{},
+  phaseOffset_{},
+  i64Timestamp_{},
+  i64TimingTimestamp_{},
+  bRateBudget_{},
+  bOnDemand_{},
+  u16IdleRate_{},
+  bInterest_{true},
+  bRunning_{},
+  pWorkerSocket_{},
+  bBusy_{},
+  bCancelled_{},
+  bStopPending_{},
+  bDestroyPending_{},
+  i64DispatchTimestamp_{},
+  u64Skipped_{},
+  latency_{},
+  bTrace_{},
+  u64ProbeStart_{},
+  u64ProbeEnd_{},
+  errorSites_{}{}
+
+OpenTestPoint::ProbeManager::Slot::~Slot()
+{
+  stopWorker();
+
+  if(iTimerFd_ >= 0)
+    {
+      close(iTimerFd_);
+    }
+}
+
+void OpenTestPoint::ProbeManager::Slot::startWorker(void * pContext,
+                                                    ProbeIndex probeIndex)
+{
+  std::string sEndpoint{"inproc://probemanager.worker." + std::to_string(probeIndex)};
+
+  if(!(pWorkerSocket_ = zmq_socket(pContext,ZMQ_PAIR)))
+    {
+      throw Toolkit::Exception{"unable to create worker socket: %s",
+          zmq_strerror(errno)};
+    }
+
+  if(zmq_bind(pWorkerSocket_,sEndpoint.c_str()) < 0)
+    {
+      throw Toolkit::Exception{"unable to bind worker socket: %s",
+          zmq_strerror(errno)};
+    }
+
+  void * pSocket{zmq_socket(pContext,ZMQ_PAIR)};
+
+  if(!pSocket)
+    {
+      throw Toolkit::Exception{"unable to create worker socket: %s",
+          zmq_strerror(errno)};
+    }
+
+  if(zmq_connect(pSocket,sEndpoint.c_str()) < 0)
+    {
+      zmq_close(pSocket);
+
+      throw Toolkit::Exception{"unable to connect worker socket: %s",
+          zmq_strerror(errno)};
+    }
+
+  // the worker owns its end of the pair from here on
+  worker_ = std::thread(&Slot::work,this,pSocket);
+}
+
+void OpenTestPoint::ProbeManager::Slot::stopWorker()
+{
+  if(worker_.joinable())
+    {
+      zmq_send(pWorkerSocket_,"e",1,0);
+
+      worker_.join();
+    }
+
+  if(pWorkerSocket_)
+    {
+      zmq_close(pWorkerSocket_);
+
+      pWorkerSocket_ = nullptr;
+    }
+}
+
+std::uint16_t OpenTestPoint::ProbeManager::Slot::rate() const
+{
+  return bOnDemand_ && !bInterest_ ? u16IdleRate_ : u16ProbeRate_;
+}
+
+void OpenTestPoint::ProbeManager::Slot::work(void * pSocket)
+{
+  char command{};
+
+  while(true)
+    {
+      if(zmq_recv(pSocket,&command,sizeof(command),0) < 0)
+        {
+          if(errno == EINTR)
+            {
+              continue;
+            }
+
+          break;
+        }
+
+      if(command == 'e')
+        {
+          break;
+        }
+
+      // buffer, error and latency are handed back to the poll
+      // thread by the completion message
+      sError_.clear();
+
+      auto start = std::chrono::steady_clock::now();
+
+      if(bTrace_)
+        {
+          u64ProbeStart_ = epochMicroseconds();
+        }
+
+      try
+        {
+          probeDataBuffer_.clear();
+
+          pProbePlugin_->probeInto(probeDataBuffer_);
+        }
+      catch(std::exception & exp)
+        {
+          sError_ = exp.what();
+        }
+
+      latency_ = std::chrono::steady_clock::now() - start;
+
+      if(bTrace_)
+        {
+          u64ProbeEnd_ = epochMicroseconds();
+        }
+
+      zmq_send(pSocket,"c",1,0);
+    }
+
+  zmq_close(pSocket);
+}
 
 OpenTestPoint::ProbeManager::ProbeManager(const std::string & sStatusEndpoint,
                                           const std::string & sNodeId,
-                                          ProbeIndex probeIndex,
-                                          const uuid_t & uuid,
-                                          std::uint16_t u16ProbeRate):
+                                          const std::string & sHostId,
+                                          const uuid_t & uuid):
   sNodeId_{sNodeId},
-  probeIndex_{probeIndex},
-  u16ProbeRate_{u16ProbeRate},
   pContext_{},
-  pServer_{}
+  pServer_{},
+  pProbeLogStatistics_{new ProbeLogStatistics{sHostId}},
+  i64LogStatisticsTimestamp_{}
 {
   uuid_copy(uuid_,uuid);
 
-  Toolkit::Log::ClientBuilder logClientBuilder{};
-
-  std::stringstream ssLabel{};
-  ssLabel<<"otestpoint-probe/"<<sNodeId<<"/"<<probeIndex;
-
-  auto pLogClient = logClientBuilder.buildClient(ssLabel.str());
+  auto pLogClient = buildLogClient(sHostId);
 
   pProbeService_.reset(new ProbeServiceImpl{pLogClient});
 
@@ -176,8 +344,29 @@ OpenTestPoint::ProbeManager::ProbeManager(const std::string & sStatusEndpoint,
   zmq_close(pStatusSocket);
 }
 
+OpenTestPoint::Toolkit::Log::Client *
+OpenTestPoint::ProbeManager::buildLogClient(const std::string & sId)
+{
+  Toolkit::Log::ClientBuilder logClientBuilder{};
+
+  std::stringstream ssLabel{};
+  ssLabel<<"otestpoint-probe/"<<sNodeId_<<"/"<<sId;
+
+  auto pLogClient = logClientBuilder.buildClient(ssLabel.str());
+
+  pLogClient->setRateLimit(Toolkit::Log::Level::ERROR_LEVEL,ErrorLogRate,ErrorLogBurst);
+
+  return pLogClient;
+}
+
 OpenTestPoint::ProbeManager::~ProbeManager()
 {
+  // worker sockets must be closed before the context is destroyed
+  for(auto & entry : slots_)
+    {
+      entry.second->stopWorker();
+    }
+
   zmq_close(pPublisher_);
   zmq_close(pServer_);
   zmq_ctx_destroy(pContext_);
@@ -187,28 +376,35 @@ void OpenTestPoint::ProbeManager::run()
 {
   try
     {
-      std::chrono::high_resolution_clock::time_point absTimeout{};
+      bool bRun{true};
 
-      int iFd{};
-      std::int64_t i64Timestamp{};
+      std::vector<zmq_pollitem_t> items{};
 
-      // create an interval timer with CLOCK_MONOTONIC
-      if((iFd = timerfd_create(CLOCK_REALTIME,0)) < 0)
-        {
-          throw Toolkit::Exception{"unable to create timer"};
-        }
-
-      bool bRun{true};
+      std::vector<Slot *> polledSlots{};
 
       while(bRun)
         {
-          zmq_pollitem_t items[] =
+          items.clear();
+          polledSlots.clear();
+
+          items.push_back({pServer_,0,ZMQ_POLLIN,0});
+
+          // each slot polls its timer and its worker completions
+          for(const auto & entry : slots_)
             {
-              {pServer_,0,ZMQ_POLLIN,0},
-              {nullptr,iFd,ZMQ_POLLIN,0},
-            };
+              items.push_back({nullptr,entry.second->iTimerFd_,ZMQ_POLLIN,0});
+              items.push_back({entry.second->pWorkerSocket_,0,ZMQ_POLLIN,0});
+              polledSlots.push_back(entry.second.get());
 
-          int rc = zmq_poll(items, 2, -1);
+              // a deferred request has not been answered, the server
+              // socket cannot receive until it is
+              if(entry.second->pPendingRequest_)
+                {
+                  items[0].events = 0;
+                }
+            }
+
+          int rc = zmq_poll(&items[0], items.size(), -1);
 
           if(rc == -1)
             {
@@ -242,256 +438,52 @@ void OpenTestPoint::ProbeManager::run()
 
               zmq_msg_close(&message);
 
-              switch(request.type())
+              ProbeIndex probeIndex{static_cast<ProbeIndex>(request.index())};
+
+              if(request.type() == OpenTestPoint::ProbeRequest::TYPE_CREATE)
                 {
-                case OpenTestPoint::ProbeRequest::TYPE_CREATE:
+                  handleCreate(probeIndex,request);
 
-                  if(request.has_create())
-                    {
-                      auto & create = request.create();
-
-                      switch(create.type())
-                        {
-                        case OpenTestPoint::ProbeRequest::Create::TYPE_PLUGIN:
-                          if(create.has_plugin())
-                            {
-                              try
-                                {
-                                  OPENTESTPOINT_PROBESERVICE_LOG_DEBUG(pProbeService_,
-                                                                       "/manager creating probe from plugin %s",
-                                                                       create.plugin().name().c_str());
-
-                                  pProbePlugin_.reset(new PluginProbeAdapter{probeIndex_,
-                                        create.plugin().name(),
-                                        pProbeService_.get()});
-
-                                  pProbePlugin_->setProbeService(pProbeService_.get());
-
-                                  Toolkit::sendSuccessResponse<OpenTestPoint::ProbeResponse>(pServer_);
-                                }
-                              catch(Toolkit::Exception & exp)
-                                {
-                                  Toolkit::sendFailureResponse<OpenTestPoint::ProbeResponse>(pServer_,
-                                                                                             "%s",
-                                                                                             exp.what());
-                                  //throw;
-                                }
-                            }
-                          else
-                            {
-                              Toolkit::sendFailureResponse<OpenTestPoint::ProbeResponse>(pServer_,
-                                                                                         "malformed create message");
-
-                              break;
-                            }
-
-                          break;
-
-                        case  OpenTestPoint::ProbeRequest::Create::TYPE_PYTHON:
-
-                          if(create.has_python())
-                            {
-                              try
-                                {
-                                  OPENTESTPOINT_PROBESERVICE_LOG_DEBUG(pProbeService_,
-                                                                       "/manager creating probe from python class %s.%s",
-                                                                       create.python().module().c_str(),
-                                                                       create.python().class_().c_str());
-
-                                  pProbePlugin_.reset(new PythonProbeAdapter{probeIndex_,
-                                        create.python().module(),
-                                        create.python().class_(),
-                                        pProbeService_.get()});
-
-                                  pProbePlugin_->setProbeService(pProbeService_.get());
-
-                                  Toolkit::sendSuccessResponse<OpenTestPoint::ProbeResponse>(pServer_);
-                                }
-                              catch(Toolkit::Exception & exp)
-                                {
-                                  OPENTESTPOINT_PROBESERVICE_LOG_ABORT(pProbeService_,"/manager %s",exp.what());
-
-                                  Toolkit::sendFailureResponse<OpenTestPoint::ProbeResponse>(pServer_,
-                                                                                             "%s",
-                                                                                             exp.what());
-                                }
-                            }
-                          else
-                            {
-                              Toolkit::sendFailureResponse<OpenTestPoint::ProbeResponse>(pServer_,
-                                                                                         "malformed create message");
-
-                              break;
-                            }
-                          break;
-
-                        default:
-                          break;
-
-                        }
-                    }
-                  break;
+                  // slot timers may have changed
+                  continue;
+                }
 
-                case OpenTestPoint::ProbeRequest::TYPE_INITIALIZE:
+              auto iter = slots_.find(probeIndex);
+
+              if(iter == slots_.end())
+                {
+                  Toolkit::sendFailureResponse<OpenTestPoint::ProbeResponse>(pServer_,
+                                                                             "probe %hu not created",
+                                                                             probeIndex);
+                  continue;
+                }
 
-                  OPENTESTPOINT_PROBESERVICE_LOG_DEBUG(pProbeService_,
-                                                       "/manager initialize");
+              auto & slot = *iter->second;
 
-                  if(pProbePlugin_)
-                    {
-                      if(request.has_initialize())
-                        {
-                          auto & initialize = request.initialize();
-
-                          ProbeNames names{};
-
-                          try
-                            {
-                              if(initialize.has_configuration())
-                                {
-                                  names = pProbePlugin_->initialize(initialize.configuration());
-                                }
-                              else
-                                {
-                                  names = pProbePlugin_->initialize();
-                                }
-
-                              OPENTESTPOINT_PROBESERVICE_LOG_FN_INFO(pProbeService_,
-                                                                     [names]()
-                                                                     {
-                                                                       std::list<std::string> output;
-
-                                                                       for(const auto & name : names)
-                                                                         {
-                                                                           output.push_back(name);
-                                                                         }
-
-                                                                       return output;
-                                                                     },
-                                                                     "/manager available probes:");
-
-                              OpenTestPoint::ProbeResponse response{};
-
-                              response.set_type(OpenTestPoint::ProbeResponse::TYPE_INITIALIZE);
-
-                              auto pInitialize = response.mutable_initialize();
-
-                              for(const auto & name : names)
-                                {
-                                  pInitialize->add_names(name + "." + sNodeId_);
-                                }
-
-                              std::string sSerialization;
-
-                              if(!response.SerializeToString(&sSerialization))
-                                {
-                                  throw Toolkit::Exception{"unable to serialize message"};
-                                }
-
-                              if(zmq_send(pServer_,sSerialization.c_str(),sSerialization.size(),0) < 0)
-                                {
-                                  throw Toolkit::Exception{"unable to send message: %s",zmq_strerror(errno)};
-                                }
-
-                            }
-                          catch(Toolkit::Exception & exp)
-                            {
-                              Toolkit::sendFailureResponse<OpenTestPoint::ProbeResponse>(pServer_,
-                                                                                         "%s",
-                                                                                         exp.what());
-                            }
-                        }
-                      else
-                        {
-                          Toolkit::sendFailureResponse<OpenTestPoint::ProbeResponse>(pServer_,
-                                                                                     "malformed create message");
-                        }
-                    }
-                  else
-                    {
-                      Toolkit::sendFailureResponse<OpenTestPoint::ProbeResponse>(pServer_,
-                                                                                 "probe not created");
-                    }
+              switch(request.type())
+                {
+                case OpenTestPoint::ProbeRequest::TYPE_INITIALIZE:
+                  handleInitialize(slot,request);
                   break;
 
                 case OpenTestPoint::ProbeRequest::TYPE_START:
-
-                  OPENTESTPOINT_PROBESERVICE_LOG_DEBUG(pProbeService_,"/manager start");
-
-                  if(pProbePlugin_)
-                    {
-                      try
-                        {
-                          pProbePlugin_->start();
-
-                          Toolkit::sendSuccessResponse<OpenTestPoint::ProbeResponse>(pServer_);
-
-                          OPENTESTPOINT_PROBESERVICE_LOG_DEBUG(pProbeService_,"/manager start success");
-
-                          i64Timestamp = scheduleNextProbe(iFd,u16ProbeRate_);
-                        }
-                      catch(Toolkit::Exception & exp)
-                        {
-                          Toolkit::sendFailureResponse<OpenTestPoint::ProbeResponse>(pServer_,
-                                                                                     "%s",
-                                                                                     exp.what());
-                        }
-                    }
-                  else
-                    {
-                      Toolkit::sendFailureResponse<OpenTestPoint::ProbeResponse>(pServer_,
-                                                                                 "probe not initialized");
-                    }
-
+                  handleStart(slot,request);
                   break;
 
                 case OpenTestPoint::ProbeRequest::TYPE_STOP:
-
-                  OPENTESTPOINT_PROBESERVICE_LOG_DEBUG(pProbeService_,"/manager stop");
-
-                  if(pProbePlugin_)
-                    {
-                      try
-                        {
-                          pProbePlugin_->stop();
-
-                          Toolkit::sendSuccessResponse<OpenTestPoint::ProbeResponse>(pServer_);
-                        }
-                      catch(Toolkit::Exception & exp)
-                        {
-                          Toolkit::sendFailureResponse<OpenTestPoint::ProbeResponse>(pServer_,
-                                                                                     "%s",
-                                                                                     exp.what());
-                        }
-                    }
-                  else
-                    {
-                      Toolkit::sendFailureResponse<OpenTestPoint::ProbeResponse>(pServer_,
-                                                                                 "manager probe not running");
-
-                    }
-
+                  handleStop(slot);
                   break;
 
                 case OpenTestPoint::ProbeRequest::TYPE_DESTROY:
+                  handleDestroy(slot);
+                  break;
 
-                  OPENTESTPOINT_PROBESERVICE_LOG_DEBUG(pProbeService_,"/manager destroy");
-
-                  try
-                    {
-                      if(pProbePlugin_)
-                        {
-                          pProbePlugin_->destroy();
-                        }
-                    }
-                  catch(Toolkit::Exception & exp)
-                    {
-                      OPENTESTPOINT_PROBESERVICE_LOG_ERROR(pProbeService_,"/manager %s",exp.what());
-                    }
-
-                  Toolkit::sendSuccessResponse<OpenTestPoint::ProbeResponse>(pServer_);
+                case OpenTestPoint::ProbeRequest::TYPE_SET_RATE:
+                  handleSetRate(slot,request);
+                  break;
 
-                  bRun = false;
+                case OpenTestPoint::ProbeRequest::TYPE_SET_INTEREST:
+                  handleSetInterest(slot,request);
                   break;
 
                 default:
@@ -500,65 +492,48 @@ void OpenTestPoint::ProbeManager::run()
                   //throw Toolkit::Exception{"unknown message type"};
                 }
             }
-          else if(items[1].revents & ZMQ_POLLIN)
+          else
             {
-              std::uint64_t u64Expired{};
-
-              // wait for an interval timer to expire
-              if(read(iFd,&u64Expired,sizeof(u64Expired)) > 0)
+              for(std::size_t i = 1; i < items.size(); i += 2)
                 {
-                  try
+                  auto & slot = *polledSlots[(i - 1) / 2];
+
+                  if(items[i].revents & ZMQ_POLLIN)
                     {
-                      auto info = pProbePlugin_->probe();
-
-                      for(const auto & entry  : info)
-                        {
-                          std::string sTopic{std::get<0>(entry) +"." + sNodeId_};
-                          const std::string & sData(std::get<1>(entry));
-
-                          OpenTestPoint::ProbeReport report{};
-
-                          report.set_index(probeIndex_);
-                          report.set_tag(sNodeId_);
-                          report.set_uuid(reinterpret_cast<const char *>(uuid_),sizeof(uuid_));
-                          report.set_timestamp(i64Timestamp);
-                          report.set_type(OpenTestPoint::ProbeReport::TYPE_DATA);
-
-                          auto pData = report.mutable_data();
-
-                          pData->set_name(std::get<2>(entry));
-                          pData->set_module(std::get<3>(entry));
-                          pData->set_version(std::get<4>(entry));
-                          pData->set_blob(sData.c_str(),sData.length());
-
-                          std::string sReport{};
-
-                          if(report.SerializeToString(&sReport))
-                            {
-                              OPENTESTPOINT_PROBESERVICE_LOG_DEBUG(pProbeService_,
-                                                                   "/manager sending %s",
-                                                                   sTopic.c_str());
-
-                              zmq_send(pPublisher_,sTopic.c_str(),sTopic.length(),ZMQ_SNDMORE);
-                              zmq_send(pPublisher_,sReport.c_str(),sReport.length(),0);
-                            }
-                          else
-                            {
-                              OPENTESTPOINT_PROBESERVICE_LOG_ERROR(pProbeService_,
-                                                                   "/manager probe report serialization error");
-                            }
-                        }
+                      handleProbe(slot);
                     }
-                  catch(std::exception & exp)
+
+                  if(items[i + 1].revents & ZMQ_POLLIN)
                     {
-                      OPENTESTPOINT_PROBESERVICE_LOG_ERROR(pProbeService_,
-                                                           "/manager probe error: %s",
-                                                           exp.what());
+                      handleComplete(slot);
                     }
+                }
+            }
 
-                  i64Timestamp = scheduleNextProbe(iFd,u16ProbeRate_);
+          // destroy probes once their worker is idle
+          bool bDestroyed{};
+
+          for(auto iter = slots_.begin(); iter != slots_.end();)
+            {
+              if(iter->second->bDestroyPending_ && !iter->second->bBusy_)
+                {
+                  destroy(*iter->second);
+
+                  iter = slots_.erase(iter);
+
+                  bDestroyed = true;
+                }
+              else
+                {
+                  ++iter;
                 }
             }
+
+          // the host exits once its last probe is destroyed
+          if(bDestroyed && slots_.empty())
+            {
+              bRun = false;
+            }
         }
     }
   catch(std::exception & exp)
@@ -571,21 +546,623 @@ void OpenTestPoint::ProbeManager::run()
   OPENTESTPOINT_PROBESERVICE_LOG_DEBUG(pProbeService_,"/manager thread exiting");
 }
 
+void OpenTestPoint::ProbeManager::handleCreate(ProbeIndex probeIndex,
+                                               const ProbeRequest & request)
+{
+  if(slots_.count(probeIndex))
+    {
+      Toolkit::sendFailureResponse<OpenTestPoint::ProbeResponse>(pServer_,
+                                                                 "probe %hu already created",
+                                                                 probeIndex);
+      return;
+    }
+
+  if(!request.has_create())
+    {
+      Toolkit::sendFailureResponse<OpenTestPoint::ProbeResponse>(pServer_,
+                                                                 "malformed create message");
+      return;
+    }
+
+  auto & create = request.create();
+
+  std::unique_ptr<Slot> pSlot{new Slot{}};
+
+  pSlot->u16ProbeRate_ = create.rate();
+
+  pSlot->phaseOffset_ = std::chrono::microseconds{create.phase()};
+
+  pSlot->bOnDemand_ = create.ondemand();
+
+  pSlot->u16IdleRate_ = create.idlerate();
+
+  pSlot->bInterest_ = create.interest();
+
+  pSlot->bTrace_ = create.trace();
+
+  if(!pSlot->u16ProbeRate_)
+    {
+      Toolkit::sendFailureResponse<OpenTestPoint::ProbeResponse>(pServer_,
+                                                                 "invalid probe rate");
+      return;
+    }
+
+  try
+    {
+      pSlot->pProbeService_.reset(new ProbeServiceImpl{buildLogClient(std::to_string(probeIndex))});
+
+      switch(create.type())
+        {
+        case OpenTestPoint::ProbeRequest::Create::TYPE_PLUGIN:
+          if(create.has_plugin())
+            {
+              OPENTESTPOINT_PROBESERVICE_LOG_DEBUG(pProbeService_,
+                                                   "/manager creating probe %hu from plugin %s",
+                                                   probeIndex,
+                                                   create.plugin().name().c_str());
+
+              pSlot->pProbePlugin_.reset(new PluginProbeAdapter{probeIndex,
+                    create.plugin().name(),
+                    pSlot->pProbeService_.get()});
+            }
+          break;
+
+        case  OpenTestPoint::ProbeRequest::Create::TYPE_PYTHON:
+          if(create.has_python())
+            {
+              OPENTESTPOINT_PROBESERVICE_LOG_DEBUG(pProbeService_,
+                                                   "/manager creating probe %hu from python class %s.%s",
+                                                   probeIndex,
+                                                   create.python().module().c_str(),
+                                                   create.python().class_().c_str());
+
+              pSlot->pProbePlugin_.reset(new PythonProbeAdapter{probeIndex,
+                    create.python().module(),
+                    create.python().class_(),
+                    pSlot->pProbeService_.get()});
+            }
+          break;
+
+        default:
+          break;
+        }
+
+      if(!pSlot->pProbePlugin_)
+        {
+          Toolkit::sendFailureResponse<OpenTestPoint::ProbeResponse>(pServer_,
+                                                                     "malformed create message");
+          return;
+        }
+
+      pSlot->pProbePlugin_->setProbeService(pSlot->pProbeService_.get());
+
+      // create an interval timer with CLOCK_REALTIME
+      if((pSlot->iTimerFd_ = timerfd_create(CLOCK_REALTIME,0)) < 0)
+        {
+          throw Toolkit::Exception{"unable to create timer"};
+        }
+
+      pSlot->pProbeReportPublisher_.reset(new ProbeReportPublisher{pPublisher_,
+            sNodeId_,
+            probeIndex,
+            uuid_,
+            pSlot->pProbeService_.get()});
+
+      std::chrono::microseconds budget{std::chrono::milliseconds{create.budget()}};
+
+      if(!budget.count())
+        {
+          budget = std::chrono::seconds{pSlot->u16ProbeRate_};
+
+          pSlot->bRateBudget_ = true;
+        }
+
+      pSlot->pProbeTiming_.reset(new ProbeTiming{probeIndex,budget});
+
+      pSlot->startWorker(pContext_,probeIndex);
+
+      slots_.insert(std::make_pair(probeIndex,std::move(pSlot)));
+
+      Toolkit::sendSuccessResponse<OpenTestPoint::ProbeResponse>(pServer_);
+    }
+  catch(Toolkit::Exception & exp)
+    {
+      OPENTESTPOINT_PROBESERVICE_LOG_ERROR(pProbeService_,"/manager %s",exp.what());
+
+      Toolkit::sendFailureResponse<OpenTestPoint::ProbeResponse>(pServer_,
+                                                                 "%s",
+                                                                 exp.what());
+    }
+}
+
+void OpenTestPoint::ProbeManager::handleInitialize(Slot & slot,
+                                                   const ProbeRequest & request)
+{
+  if(defer(slot,request))
+    {
+      return;
+    }
+
+  OPENTESTPOINT_PROBESERVICE_LOG_DEBUG(pProbeService_,
+                                       "/manager initialize %hu",
+                                       slot.pProbePlugin_->getIndex());
+
+  if(!request.has_initialize())
+    {
+      Toolkit::sendFailureResponse<OpenTestPoint::ProbeResponse>(pServer_,
+                                                                 "malformed create message");
+      return;
+    }
+
+  auto & initialize = request.initialize();
+
+  ProbeNames names{};
+
+  try
+    {
+      if(initialize.has_configuration())
+        {
+          names = slot.pProbePlugin_->initialize(initialize.configuration());
+        }
+      else
+        {
+          names = slot.pProbePlugin_->initialize();
+        }
+
+      OPENTESTPOINT_PROBESERVICE_LOG_FN_INFO(pProbeService_,
+                                             [names]()
+                                             {
+                                               std::list<std::string> output;
+
+                                               for(const auto & name : names)
+                                                 {
+                                                   output.push_back(name);
+                                                 }
+
+                                               return output;
+                                             },
+                                             "/manager available probes:");
+
+      OpenTestPoint::ProbeResponse response{};
+
+      response.set_type(OpenTestPoint::ProbeResponse::TYPE_INITIALIZE);
+
+      auto pInitialize = response.mutable_initialize();
+
+      for(const auto & name : names)
+        {
+          pInitialize->add_names(slot.pProbeReportPublisher_->topic(name));
+        }
+
+      pInitialize->add_names(slot.pProbeReportPublisher_->topic(slot.pProbeTiming_->getName()));
+
+      pInitialize->add_names(slot.pProbeReportPublisher_->topic(pProbeLogStatistics_->getName()));
+
+      std::string sSerialization;
+
+      if(!response.SerializeToString(&sSerialization))
+        {
+          throw Toolkit::Exception{"unable to serialize message"};
+        }
+
+      if(zmq_send(pServer_,sSerialization.c_str(),sSerialization.size(),0) < 0)
+        {
+          throw Toolkit::Exception{"unable to send message: %s",zmq_strerror(errno)};
+        }
+
+    }
+  catch(Toolkit::Exception & exp)
+    {
+      Toolkit::sendFailureResponse<OpenTestPoint::ProbeResponse>(pServer_,
+                                                                 "%s",
+                                                                 exp.what());
+    }
+}
+
+void OpenTestPoint::ProbeManager::handleStart(Slot & slot,
+                                              const ProbeRequest & request)
+{
+  // a probe cancelled by stop may still be running
+  if(defer(slot,request))
+    {
+      return;
+    }
+
+  OPENTESTPOINT_PROBESERVICE_LOG_DEBUG(pProbeService_,
+                                       "/manager start %hu",
+                                       slot.pProbePlugin_->getIndex());
+
+  try
+    {
+      slot.pProbePlugin_->start();
+
+      Toolkit::sendSuccessResponse<OpenTestPoint::ProbeResponse>(pServer_);
+
+      OPENTESTPOINT_PROBESERVICE_LOG_DEBUG(pProbeService_,"/manager start success");
+
+      slot.bRunning_ = true;
+
+      schedule(slot);
+
+      slot.i64TimingTimestamp_ = slot.i64Timestamp_;
+    }
+  catch(Toolkit::Exception & exp)
+    {
+      Toolkit::sendFailureResponse<OpenTestPoint::ProbeResponse>(pServer_,
+                                                                 "%s",
+                                                                 exp.what());
+    }
+}
+
+void OpenTestPoint::ProbeManager::handleStop(Slot & slot)
+{
+  OPENTESTPOINT_PROBESERVICE_LOG_DEBUG(pProbeService_,
+                                       "/manager stop %hu",
+                                       slot.pProbePlugin_->getIndex());
+
+  slot.bRunning_ = false;
+
+  // disarm the interval timer
+  itimerspec spec{{0,0},{0,0}};
+
+  timerfd_settime(slot.iTimerFd_,0,&spec,nullptr);
+
+  if(slot.bBusy_)
+    {
+      // cancel cooperatively, the running probe completes and its
+      // report is discarded before the plugin is stopped
+      slot.bCancelled_ = true;
+
+      slot.bStopPending_ = true;
+
+      Toolkit::sendSuccessResponse<OpenTestPoint::ProbeResponse>(pServer_);
+
+      return;
+    }
+
+  try
+    {
+      slot.pProbePlugin_->stop();
+
+      Toolkit::sendSuccessResponse<OpenTestPoint::ProbeResponse>(pServer_);
+    }
+  catch(Toolkit::Exception & exp)
+    {
+      Toolkit::sendFailureResponse<OpenTestPoint::ProbeResponse>(pServer_,
+                                                                 "%s",
+                                                                 exp.what());
+    }
+}
+
+void OpenTestPoint::ProbeManager::handleDestroy(Slot & slot)
+{
+  OPENTESTPOINT_PROBESERVICE_LOG_DEBUG(pProbeService_,
+                                       "/manager destroy %hu",
+                                       slot.pProbePlugin_->getIndex());
+
+  slot.bRunning_ = false;
+
+  itimerspec spec{{0,0},{0,0}};
+
+  timerfd_settime(slot.iTimerFd_,0,&spec,nullptr);
+
+  // the plugin is destroyed once its worker is idle
+  slot.bCancelled_ = true;
+
+  slot.bDestroyPending_ = true;
+
+  Toolkit::sendSuccessResponse<OpenTestPoint::ProbeResponse>(pServer_);
+}
+
+void OpenTestPoint::ProbeManager::handleSetRate(Slot & slot,
+                                                const ProbeRequest & request)
+{
+  if(!request.has_setrate() || !request.setrate().rate() ||
+     request.setrate().rate() > std::numeric_limits<std::uint16_t>::max())
+    {
+      Toolkit::sendFailureResponse<OpenTestPoint::ProbeResponse>(pServer_,
+                                                                 "malformed set rate message");
+      return;
+    }
+
+  auto & setRate = request.setrate();
+
+  OPENTESTPOINT_PROBESERVICE_LOG_INFO(pProbeService_,
+                                      "/manager set rate %hu: %hu -> %u",
+                                      slot.pProbePlugin_->getIndex(),
+                                      slot.u16ProbeRate_,
+                                      setRate.rate());
+
+  slot.u16ProbeRate_ = setRate.rate();
+
+  slot.phaseOffset_ = std::chrono::microseconds{setRate.phase()};
+
+  if(slot.bRateBudget_)
+    {
+      slot.pProbeTiming_->setBudget(std::chrono::seconds{slot.u16ProbeRate_});
+    }
+
+  // a running probe moves to the next boundary of the new rate, an
+  // in flight probe completes and reports as scheduled
+  if(slot.bRunning_)
+    {
+      schedule(slot);
+    }
+
+  Toolkit::sendSuccessResponse<OpenTestPoint::ProbeResponse>(pServer_);
+}
+
+void OpenTestPoint::ProbeManager::handleSetInterest(Slot & slot,
+                                                    const ProbeRequest & request)
+{
+  if(!request.has_setinterest())
+    {
+      Toolkit::sendFailureResponse<OpenTestPoint::ProbeResponse>(pServer_,
+                                                                 "malformed set interest message");
+      return;
+    }
+
+  OPENTESTPOINT_PROBESERVICE_LOG_DEBUG(pProbeService_,
+                                       "/manager set interest %hu: %s",
+                                       slot.pProbePlugin_->getIndex(),
+                                       request.setinterest().interest() ? "true" : "false");
+
+  bool bChanged{slot.bInterest_ != request.setinterest().interest()};
+
+  slot.bInterest_ = request.setinterest().interest();
+
+  if(bChanged && slot.bOnDemand_ && slot.bRunning_)
+    {
+      schedule(slot);
+    }
 
-std::int64_t scheduleNextProbe(int iFd,int iDelta)
+  Toolkit::sendSuccessResponse<OpenTestPoint::ProbeResponse>(pServer_);
+}
+
+void OpenTestPoint::ProbeManager::schedule(Slot & slot)
+{
+  if(slot.rate())
+    {
+      slot.i64Timestamp_ = scheduleNextProbe(slot.iTimerFd_,
+                                             slot.rate(),
+                                             slot.phaseOffset_);
+    }
+  else
+    {
+      itimerspec spec{{0,0},{0,0}};
+
+      timerfd_settime(slot.iTimerFd_,0,&spec,nullptr);
+
+      // timing reports resume from the current time
+      slot.i64Timestamp_ = time(nullptr);
+    }
+}
+
+void OpenTestPoint::ProbeManager::handleProbe(Slot & slot)
+{
+  std::uint64_t u64Expired{};
+
+  // wait for an interval timer to expire
+  if(read(slot.iTimerFd_,&u64Expired,sizeof(u64Expired)) > 0)
+    {
+      // an expiration raced a change to rate zero
+      if(!slot.rate())
+        {
+          return;
+        }
+
+      std::int64_t i64Timestamp{slot.i64Timestamp_};
+
+      // the next deadline does not depend on the probe duration
+      slot.i64Timestamp_ = scheduleNextProbe(slot.iTimerFd_,
+                                             slot.rate(),
+                                             slot.phaseOffset_);
+
+      // rate boundaries that passed without a timer expiration
+      std::int64_t i64Missed{(slot.i64Timestamp_ - i64Timestamp) / slot.rate() - 1};
+
+      if(i64Missed > 0)
+        {
+          slot.u64Skipped_ += i64Missed;
+        }
+
+      if(slot.bBusy_)
+        {
+          ++slot.u64Skipped_;
+
+          OPENTESTPOINT_PROBESERVICE_LOG_DEBUG(pProbeService_,
+                                               "/manager probe %hu busy, skipping tick",
+                                               slot.pProbePlugin_->getIndex());
+          return;
+        }
+
+      slot.bBusy_ = true;
+
+      slot.bCancelled_ = false;
+
+      slot.i64DispatchTimestamp_ = i64Timestamp;
+
+      zmq_send(slot.pWorkerSocket_,"p",1,0);
+    }
+}
+
+void OpenTestPoint::ProbeManager::handleComplete(Slot & slot)
+{
+  char completion{};
+
+  if(zmq_recv(slot.pWorkerSocket_,&completion,sizeof(completion),0) < 0)
+    {
+      return;
+    }
+
+  slot.bBusy_ = false;
+
+  if(!slot.sError_.empty())
+    {
+      OPENTESTPOINT_TOOLKIT_LOG_SITE(pProbeService_->logClient(),
+                                     Toolkit::Log::Level::ERROR_LEVEL,
+                                     &slot.errorSites_[Slot::PROBE_ERROR],
+                                     "/manager probe error: %s",
+                                     slot.sError_.c_str());
+    }
+  else if(!slot.bCancelled_)
+    {
+      try
+        {
+          if(slot.bTrace_)
+            {
+              slot.pProbeReportPublisher_->publish(slot.i64DispatchTimestamp_,
+                                                   slot.probeDataBuffer_,
+                                                   slot.u64ProbeStart_,
+                                                   slot.u64ProbeEnd_);
+            }
+          else
+            {
+              slot.pProbeReportPublisher_->publish(slot.i64DispatchTimestamp_,slot.probeDataBuffer_);
+            }
+        }
+      catch(std::exception & exp)
+        {
+          OPENTESTPOINT_TOOLKIT_LOG_SITE(pProbeService_->logClient(),
+                                         Toolkit::Log::Level::ERROR_LEVEL,
+                                         &slot.errorSites_[Slot::PUBLISH_ERROR],
+                                         "/manager probe error: %s",
+                                         exp.what());
+        }
+    }
+
+  if(slot.pProbeTiming_->record(slot.latency_,slot.u64Skipped_))
+    {
+      OPENTESTPOINT_PROBESERVICE_LOG_DEBUG(pProbeService_,
+                                           "/manager probe %hu overrun %lld usec skipped %llu",
+                                           slot.pProbePlugin_->getIndex(),
+                                           static_cast<long long>(std::chrono::duration_cast<std::chrono::microseconds>(slot.latency_).count()),
+                                           static_cast<unsigned long long>(slot.u64Skipped_));
+    }
+
+  slot.u64Skipped_ = 0;
+
+  if(slot.i64DispatchTimestamp_ - slot.i64TimingTimestamp_ >= TimingReportInterval)
+    {
+      slot.i64TimingTimestamp_ = slot.i64DispatchTimestamp_;
+
+      slot.probeDataBuffer_.clear();
+
+      slot.pProbeTiming_->report(slot.probeDataBuffer_);
+
+      if(slot.i64DispatchTimestamp_ - i64LogStatisticsTimestamp_ >= TimingReportInterval)
+        {
+          i64LogStatisticsTimestamp_ = slot.i64DispatchTimestamp_;
+
+          pProbeLogStatistics_->report(slot.probeDataBuffer_);
+        }
+
+      slot.pProbeReportPublisher_->publish(slot.i64DispatchTimestamp_,slot.probeDataBuffer_);
+    }
+
+  finish(slot);
+}
+
+bool OpenTestPoint::ProbeManager::defer(Slot & slot,
+                                        const ProbeRequest & request)
+{
+  if(!slot.bBusy_)
+    {
+      return false;
+    }
+
+  OPENTESTPOINT_PROBESERVICE_LOG_DEBUG(pProbeService_,
+                                       "/manager waiting for probe %hu",
+                                       slot.pProbePlugin_->getIndex());
+
+  slot.pPendingRequest_.reset(new ProbeRequest{request});
+
+  return true;
+}
+
+void OpenTestPoint::ProbeManager::finish(Slot & slot)
+{
+  if(slot.bStopPending_)
+    {
+      slot.bStopPending_ = false;
+
+      try
+        {
+          slot.pProbePlugin_->stop();
+        }
+      catch(Toolkit::Exception & exp)
+        {
+          OPENTESTPOINT_TOOLKIT_LOG_SITE(pProbeService_->logClient(),
+                                         Toolkit::Log::Level::ERROR_LEVEL,
+                                         &slot.errorSites_[Slot::PLUGIN_ERROR],
+                                         "/manager %s",
+                                         exp.what());
+        }
+    }
+
+  if(slot.pPendingRequest_)
+    {
+      std::unique_ptr<ProbeRequest> pRequest{std::move(slot.pPendingRequest_)};
+
+      if(pRequest->type() == OpenTestPoint::ProbeRequest::TYPE_INITIALIZE)
+        {
+          handleInitialize(slot,*pRequest);
+        }
+      else
+        {
+          handleStart(slot,*pRequest);
+        }
+    }
+}
+
+void OpenTestPoint::ProbeManager::destroy(Slot & slot)
+{
+  try
+    {
+      if(slot.pProbePlugin_)
+        {
+          slot.pProbePlugin_->destroy();
+        }
+    }
+  catch(Toolkit::Exception & exp)
+    {
+      OPENTESTPOINT_TOOLKIT_LOG_SITE(pProbeService_->logClient(),
+                                     Toolkit::Log::Level::ERROR_LEVEL,
+                                     &slot.errorSites_[Slot::PLUGIN_ERROR],
+                                     "/manager %s",
+                                     exp.what());
+    }
+
+}
+
+
+// schedules the next probe on the next rate boundary plus the phase
+// offset and returns that boundary, which is the report timestamp
+std::int64_t scheduleNextProbe(int iFd,
+                               int iDelta,
+                               const std::chrono::microseconds & phaseOffset)
 {
   timespec ts;
 
   clock_gettime(CLOCK_REALTIME,&ts);
 
-  ts.tv_sec += iDelta - ts.tv_sec % iDelta;
+  std::int64_t i64Now{ts.tv_sec * 1000000LL + ts.tv_nsec / 1000};
+
+  std::int64_t i64Delta{iDelta * 1000000LL};
+
+  // boundary whose offset firing time is strictly after now
+  std::int64_t i64Aligned{((i64Now - phaseOffset.count()) / i64Delta + 1) * i64Delta};
+
+  std::int64_t i64Fire{i64Aligned + phaseOffset.count()};
+
+  ts.tv_sec = i64Fire / 1000000;
 
-  ts.tv_nsec = 0;
+  ts.tv_nsec = (i64Fire % 1000000) * 1000;
 
   // schedule the interval timer
   itimerspec spec{{0,0},ts};
 
   timerfd_settime(iFd,TFD_TIMER_ABSTIME,&spec,nullptr);
 
-  return ts.tv_sec;
+  return i64Aligned / 1000000;
 }
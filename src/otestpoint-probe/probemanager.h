@@ -36,31 +36,106 @@
 #define OPENTESTPOINT_PROBEMANAGER_HEADER_
 
 #include "otestpoint/probeplugin.h"
+#include "otestpoint/probedatabuffer.h"
 #include "otestpoint/toolkit/log/client.h"
+#include "probelogstatistics.h"
+#include "probetiming.h"
 
 #include <string>
 #include <memory>
+#include <chrono>
+#include <map>
+#include <thread>
 #include <uuid.h>
 
 namespace OpenTestPoint
 {
+  class ProbeReportPublisher;
+  class ProbeRequest;
+
   class ProbeManager
   {
   public:
     ProbeManager(const std::string & sStatusEndpoint,
                  const std::string & sNodeId,
-                 ProbeIndex probeIndex,
-                 const uuid_t & uuid,
-                 std::uint16_t u16ProbeRate);
+                 const std::string & sHostId,
+                 const uuid_t & uuid);
 
     ~ProbeManager();
 
     void run();
+
   private:
+    // a hosted probe and its schedule
+    class Slot
+    {
+    public:
+      Slot();
+
+      ~Slot();
+
+      // a log client per probe, labeled by probe index so label
+      // rules select a probe whether or not its host is shared
+      std::unique_ptr<ProbeService> pProbeService_;
+      std::unique_ptr<ProbePlugin> pProbePlugin_;
+      std::unique_ptr<ProbeReportPublisher> pProbeReportPublisher_;
+      ProbeDataBuffer probeDataBuffer_;
+      int iTimerFd_;
+      std::uint16_t u16ProbeRate_;
+      std::chrono::microseconds phaseOffset_;
+      std::int64_t i64Timestamp_;
+      std::unique_ptr<ProbeTiming> pProbeTiming_;
+      std::int64_t i64TimingTimestamp_;
+      // budget follows rate changes when not configured
+      bool bRateBudget_;
+      // on demand probes without interest run at the idle rate,
+      // zero leaves the timer disarmed
+      bool bOnDemand_;
+      std::uint16_t u16IdleRate_;
+      bool bInterest_;
+      bool bRunning_;
+
+      // probe() runs on the worker, completions are posted back
+      // over a pair socket polled with the control socket
+      std::thread worker_;
+      void * pWorkerSocket_;
+      bool bBusy_;
+      bool bCancelled_;
+      bool bStopPending_;
+      bool bDestroyPending_;
+      // an initialize or start received while probe() is running,
+      // handled and answered once it completes
+      std::unique_ptr<ProbeRequest> pPendingRequest_;
+      std::int64_t i64DispatchTimestamp_;
+      std::uint64_t u64Skipped_;
+      std::chrono::steady_clock::duration latency_;
+      std::string sError_;
+      // probe() start and end, microseconds since the epoch,
+      // stamped only when the probe is traced
+      bool bTrace_;
+      std::uint64_t u64ProbeStart_;
+      std::uint64_t u64ProbeEnd_;
+
+      // error call site identities, the error rate limit applies per
+      // slot so one failing probe does not hide the errors of another
+      enum ErrorSite {PROBE_ERROR, PUBLISH_ERROR, PLUGIN_ERROR, ERROR_SITES};
+      char errorSites_[ERROR_SITES];
+
+      void startWorker(void * pContext,
+                       ProbeIndex probeIndex);
+
+      void stopWorker();
+
+      std::uint16_t rate() const;
+
+    private:
+      void work(void * pSocket);
+    };
+
+    using Slots = std::map<ProbeIndex,std::unique_ptr<Slot>>;
+
     std::string sNodeId_;
-    ProbeIndex probeIndex_;
     uuid_t uuid_;
-    std::uint16_t u16ProbeRate_;
 
     std::unique_ptr<ProbeService> pProbeService_;
 
@@ -68,7 +143,50 @@ namespace OpenTestPoint
     void * pServer_;
     void * pPublisher_;
 
-    std::unique_ptr<ProbePlugin> pProbePlugin_;
+    Slots slots_;
+
+    // the host log table, reported by the first slot due each interval
+    std::unique_ptr<ProbeLogStatistics> pProbeLogStatistics_;
+    std::int64_t i64LogStatisticsTimestamp_;
+
+    // a log client labeled otestpoint-probe/<node>/<id> with the
+    // error rate limit applied, owned by the caller
+    Toolkit::Log::Client * buildLogClient(const std::string & sId);
+
+    void handleCreate(ProbeIndex probeIndex,
+                      const ProbeRequest & request);
+
+    void handleInitialize(Slot & slot,
+                          const ProbeRequest & request);
+
+    void handleStart(Slot & slot,
+                     const ProbeRequest & request);
+
+    void handleStop(Slot & slot);
+
+    void handleDestroy(Slot & slot);
+
+    void handleSetRate(Slot & slot,
+                       const ProbeRequest & request);
+
+    void handleSetInterest(Slot & slot,
+                           const ProbeRequest & request);
+
+    void handleProbe(Slot & slot);
+
+    void handleComplete(Slot & slot);
+
+    // holds a request until the running probe completes, returns
+    // true when deferred
+    bool defer(Slot & slot,
+               const ProbeRequest & request);
+
+    // arms the timer at the current rate, disarms at rate zero
+    void schedule(Slot & slot);
+
+    void finish(Slot & slot);
+
+    void destroy(Slot & slot);
   };
 }
 
@@ -0,0 +1,324 @@
+/*
+ * Copyright (c) 2026 - Adjacent Link LLC, Bridgewater, New Jersey
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  * Neither the name of Adjacent Link LLC nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * See toplevel COPYING for more information.
+ */
+
+// Measures the per interval cost of turning probe data into
+// published probe reports: the legacy list-of-tuples path versus the
+// probe data buffer and report publisher path used by the probe
+// manager, with the serialization copied into the buffer or
+// referenced in place. Reports allocations per tick and nanoseconds
+// per report.
+
+#include "probereportpublisher.h"
+#include "probereport.pb.h"
+#include "benchsupport.h"
+
+#include "otestpoint/probeservice.h"
+#include "otestpoint/probedatabuffer.h"
+#include "otestpoint/types.h"
+
+#include <zmq.h>
+#include <uuid.h>
+#include <atomic>
+#include <cstdlib>
+#include <cstdio>
+#include <string>
+
+extern "C"
+{
+  void * __libc_malloc(size_t);
+  void * __libc_calloc(size_t,size_t);
+  void * __libc_realloc(void *,size_t);
+  void __libc_free(void *);
+}
+
+namespace
+{
+  std::atomic<std::uint64_t> allocations{};
+
+  thread_local bool bCounting{};
+
+  inline void countAllocation()
+  {
+    if(bCounting)
+      {
+        allocations.fetch_add(1,std::memory_order_relaxed);
+      }
+  }
+}
+
+// count every heap allocation made on the measuring thread,
+// including those made by libzmq and protobuf
+extern "C"
+{
+  void * malloc(size_t size)
+  {
+    countAllocation();
+    return __libc_malloc(size);
+  }
+
+  void * calloc(size_t nmemb, size_t size)
+  {
+    countAllocation();
+    return __libc_calloc(nmemb,size);
+  }
+
+  void * realloc(void * ptr, size_t size)
+  {
+    countAllocation();
+    return __libc_realloc(ptr,size);
+  }
+
+  void free(void * ptr)
+  {
+    __libc_free(ptr);
+  }
+}
+
+namespace
+{
+  const std::string sNodeId{"node-1"};
+  const OpenTestPoint::ProbeIndex probeIndex{1};
+
+  // stand in for a plugin probe() producing a list of tuples
+  OpenTestPoint::ProbeData legacyProbe(const std::string & sBlob,
+                                       std::size_t entries)
+  {
+    OpenTestPoint::ProbeData probeData{};
+
+    for(std::size_t i = 0; i < entries; ++i)
+      {
+        probeData.push_back(std::make_tuple("Probes.Bench." + std::to_string(i),
+                                            sBlob,
+                                            "Measurement_bench",
+                                            "otestpoint.bench",
+                                            1));
+      }
+
+    return probeData;
+  }
+
+  // stand in for a plugin probeInto() assigning into reused entries
+  void bufferProbe(OpenTestPoint::ProbeDataBuffer & buffer,
+                   const std::string & sBlob,
+                   const std::string * pTopics,
+                   std::size_t entries)
+  {
+    for(std::size_t i = 0; i < entries; ++i)
+      {
+        auto & entry = buffer.append();
+
+        entry.sTopic.assign(pTopics[i]);
+        entry.sSerialization.assign(sBlob);
+        entry.sName.assign("Measurement_bench");
+        entry.sModule.assign("otestpoint.bench");
+        entry.u32Version = 1;
+      }
+  }
+
+  // stand in for a plugin probeInto() referencing serializations it
+  // holds, as the python probe adapter does
+  void referenceProbe(OpenTestPoint::ProbeDataBuffer & buffer,
+                      const std::string & sBlob,
+                      const std::string * pTopics,
+                      std::size_t entries)
+  {
+    for(std::size_t i = 0; i < entries; ++i)
+      {
+        auto & entry = buffer.append();
+
+        entry.sTopic.assign(pTopics[i]);
+        entry.pSerialization = sBlob.data();
+        entry.serializationSize = sBlob.size();
+        entry.sName.assign("Measurement_bench");
+        entry.sModule.assign("otestpoint.bench");
+        entry.u32Version = 1;
+      }
+  }
+
+  // the probe manager publish loop prior to the report publisher
+  void legacyPublish(void * pPublisher,
+                     const uuid_t & uuid,
+                     std::int64_t i64Timestamp,
+                     const OpenTestPoint::ProbeData & info)
+  {
+    for(const auto & entry  : info)
+      {
+        std::string sTopic{std::get<0>(entry) +"." + sNodeId};
+        const std::string & sData(std::get<1>(entry));
+
+        OpenTestPoint::ProbeReport report{};
+
+        report.set_index(probeIndex);
+        report.set_tag(sNodeId);
+        report.set_uuid(reinterpret_cast<const char *>(uuid),sizeof(uuid_t));
+        report.set_timestamp(i64Timestamp);
+        report.set_type(OpenTestPoint::ProbeReport::TYPE_DATA);
+
+        auto pData = report.mutable_data();
+
+        pData->set_name(std::get<2>(entry));
+        pData->set_module(std::get<3>(entry));
+        pData->set_version(std::get<4>(entry));
+        pData->set_blob(sData.c_str(),sData.length());
+
+        std::string sReport{};
+
+        if(report.SerializeToString(&sReport))
+          {
+            zmq_send(pPublisher,sTopic.c_str(),sTopic.length(),ZMQ_SNDMORE);
+            zmq_send(pPublisher,sReport.c_str(),sReport.length(),0);
+          }
+      }
+  }
+
+  void drain(void * pSubscriber)
+  {
+    zmq_msg_t message;
+
+    zmq_msg_init(&message);
+
+    while(zmq_msg_recv(&message,pSubscriber,ZMQ_DONTWAIT) >= 0);
+
+    zmq_msg_close(&message);
+  }
+
+  template<typename Function>
+  void report(const char * pzPath,
+              std::size_t entries,
+              std::size_t blobSize,
+              std::size_t ticks,
+              void * pSubscriber,
+              Function fn)
+  {
+    double dNsPerTick{OpenTestPoint::Bench::measure(100,ticks,
+                                                    [&](std::size_t i)
+                                                    {
+                                                      fn(i);
+                                                      drain(pSubscriber);
+                                                    },
+                                                    []()
+                                                    {
+                                                      allocations = 0;
+                                                      bCounting = true;
+                                                    },
+                                                    []()
+                                                    {
+                                                      bCounting = false;
+                                                    })};
+
+    std::printf("%-8s entries=%-3zu blob=%-6zu allocs/tick=%-8.2f ns/report=%.1f\n",
+                pzPath,
+                entries,
+                blobSize,
+                allocations / static_cast<double>(ticks),
+                dNsPerTick / entries);
+  }
+}
+
+int main(int argc, char * argv[])
+{
+  std::size_t ticks{argc > 1 ? std::strtoul(argv[1],nullptr,10) : 100000};
+
+  void * pContext{zmq_ctx_new()};
+
+  void * pPublisher{zmq_socket(pContext,ZMQ_PUB)};
+
+  void * pSubscriber{zmq_socket(pContext,ZMQ_SUB)};
+
+  int iHWM{0};
+
+  zmq_setsockopt(pPublisher,ZMQ_SNDHWM,&iHWM,sizeof(iHWM));
+  zmq_setsockopt(pSubscriber,ZMQ_RCVHWM,&iHWM,sizeof(iHWM));
+
+  zmq_bind(pPublisher,"inproc://probereportbench");
+  zmq_connect(pSubscriber,"inproc://probereportbench");
+  zmq_setsockopt(pSubscriber,ZMQ_SUBSCRIBE,"",0);
+
+  uuid_t uuid;
+
+  uuid_generate(uuid);
+
+  OpenTestPoint::Bench::NullProbeService probeService{};
+
+  OpenTestPoint::ProbeReportPublisher publisher{pPublisher,
+      sNodeId,
+      probeIndex,
+      uuid,
+      &probeService};
+
+  OpenTestPoint::ProbeDataBuffer buffer{};
+
+  for(std::size_t entries : {1,8})
+    {
+      std::string topics[8];
+
+      for(std::size_t i = 0; i < entries; ++i)
+        {
+          topics[i] = "Probes.Bench." + std::to_string(i);
+        }
+
+      for(std::size_t blobSize : {64,1024,16384})
+        {
+          std::string sBlob(blobSize,'x');
+
+          report("legacy",entries,blobSize,ticks,pSubscriber,
+                 [&](std::size_t i)
+                 {
+                   legacyPublish(pPublisher,uuid,i,legacyProbe(sBlob,entries));
+                 });
+
+          report("buffer",entries,blobSize,ticks,pSubscriber,
+                 [&](std::size_t i)
+                 {
+                   buffer.clear();
+                   bufferProbe(buffer,sBlob,topics,entries);
+                   publisher.publish(i,buffer);
+                 });
+
+          report("ref",entries,blobSize,ticks,pSubscriber,
+                 [&](std::size_t i)
+                 {
+                   buffer.clear();
+                   referenceProbe(buffer,sBlob,topics,entries);
+                   publisher.publish(i,buffer);
+                 });
+        }
+    }
+
+  zmq_close(pSubscriber);
+  zmq_close(pPublisher);
+  zmq_ctx_destroy(pContext);
+
+  return 0;
+}
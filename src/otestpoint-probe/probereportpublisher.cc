@@ -0,0 +1,210 @@
+/*
+ * Copyright (c) 2026 - Adjacent Link LLC, Bridgewater, New Jersey
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  * Neither the name of Adjacent Link LLC nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * See toplevel COPYING for more information.
+ */
+
+#include "probereportpublisher.h"
+
+#include <google/protobuf/io/coded_stream.h>
+#include <zmq.h>
+#include <cstring>
+#include <chrono>
+
+namespace
+{
+  using google::protobuf::io::CodedOutputStream;
+
+  const std::uint32_t WIRETYPE_LENGTH_DELIMITED{2};
+
+  const std::uint32_t DATA_TAG{(OpenTestPoint::ProbeReport::kDataFieldNumber << 3) |
+                               WIRETYPE_LENGTH_DELIMITED};
+
+  const std::uint32_t BLOB_TAG{(OpenTestPoint::ProbeReport::Data::kBlobFieldNumber << 3) |
+                               WIRETYPE_LENGTH_DELIMITED};
+}
+
+OpenTestPoint::ProbeReportPublisher::ProbeReportPublisher(void * pPublisher,
+                                                          const std::string & sNodeId,
+                                                          ProbeIndex probeIndex,
+                                                          const uuid_t & uuid,
+                                                          ProbeService * pProbeService):
+  pPublisher_{pPublisher},
+  sNodeId_{sNodeId},
+  pProbeService_{pProbeService}
+{
+  report_.set_index(probeIndex);
+  report_.set_tag(sNodeId);
+  report_.set_uuid(reinterpret_cast<const char *>(uuid),sizeof(uuid_t));
+  report_.set_type(OpenTestPoint::ProbeReport::TYPE_DATA);
+}
+
+const std::string &
+OpenTestPoint::ProbeReportPublisher::topic(const std::string & sName)
+{
+  auto iter = topics_.find(sName);
+
+  if(iter == topics_.end())
+    {
+      iter = topics_.insert(std::make_pair(sName,sName + "." + sNodeId_)).first;
+    }
+
+  return iter->second;
+}
+
+void OpenTestPoint::ProbeReportPublisher::publish(std::uint64_t u64Timestamp,
+                                                  const ProbeDataBuffer & buffer)
+{
+  report_.clear_trace();
+
+  send(u64Timestamp,buffer,false);
+}
+
+void OpenTestPoint::ProbeReportPublisher::publish(std::uint64_t u64Timestamp,
+                                                  const ProbeDataBuffer & buffer,
+                                                  std::uint64_t u64ProbeStart,
+                                                  std::uint64_t u64ProbeEnd)
+{
+  auto pTrace = report_.mutable_trace();
+
+  pTrace->set_start(u64ProbeStart);
+
+  pTrace->set_end(u64ProbeEnd);
+
+  send(u64Timestamp,buffer,true);
+}
+
+void OpenTestPoint::ProbeReportPublisher::send(std::uint64_t u64Timestamp,
+                                               const ProbeDataBuffer & buffer,
+                                               bool bTrace)
+{
+  report_.set_timestamp(u64Timestamp);
+
+  // report fields preceding data, identical for every entry unless
+  // traced
+  std::uint32_t u32HeaderSize{static_cast<std::uint32_t>(report_.ByteSizeLong())};
+
+  for(const auto & entry : buffer)
+    {
+      const std::string & sTopic{topic(entry.sTopic)};
+
+      if(bTrace)
+        {
+          report_.mutable_trace()->set_publish(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count());
+
+          u32HeaderSize = report_.ByteSizeLong();
+        }
+
+      data_.set_name(entry.sName);
+      data_.set_module(entry.sModule);
+      data_.set_version(entry.u32Version);
+
+      // blob is the last field of data and report_ never holds data,
+      // so the frame is the report header, the data fields and then
+      // the blob. A traced header carries trace (field 8) ahead of
+      // data (field 6): parsers accept fields in any order, but the
+      // frame is then not byte identical to serializing with
+      // set_blob()
+      std::uint32_t u32BlobSize{static_cast<std::uint32_t>(entry.size())};
+
+      std::uint32_t u32DataSize{static_cast<std::uint32_t>(data_.ByteSizeLong() +
+                                                           CodedOutputStream::VarintSize32(BLOB_TAG) +
+                                                           CodedOutputStream::VarintSize32(u32BlobSize) +
+                                                           u32BlobSize)};
+
+      std::size_t reportSize{u32HeaderSize +
+          CodedOutputStream::VarintSize32(DATA_TAG) +
+          CodedOutputStream::VarintSize32(u32DataSize) +
+          u32DataSize};
+
+      zmq_msg_t topicMessage;
+      zmq_msg_t reportMessage;
+
+      // the topic is copied: the publish socket is shared by every
+      // probe in the process and may still hold a queued frame after
+      // this publisher is destroyed. Topics are short enough to be
+      // stored inline in the message.
+      if(zmq_msg_init_size(&topicMessage,sTopic.size()) < 0)
+        {
+          OPENTESTPOINT_PROBESERVICE_LOG_ERROR(pProbeService_,
+                                               "/manager probe report message error: %s",
+                                               zmq_strerror(errno));
+          continue;
+        }
+
+      std::memcpy(zmq_msg_data(&topicMessage),sTopic.data(),sTopic.size());
+
+      if(zmq_msg_init_size(&reportMessage,reportSize) < 0)
+        {
+          zmq_msg_close(&topicMessage);
+
+          OPENTESTPOINT_PROBESERVICE_LOG_ERROR(pProbeService_,
+                                               "/manager probe report message error: %s",
+                                               zmq_strerror(errno));
+          continue;
+        }
+
+      auto pTarget = static_cast<std::uint8_t *>(zmq_msg_data(&reportMessage));
+
+      pTarget = report_.SerializeWithCachedSizesToArray(pTarget);
+      pTarget = CodedOutputStream::WriteVarint32ToArray(DATA_TAG,pTarget);
+      pTarget = CodedOutputStream::WriteVarint32ToArray(u32DataSize,pTarget);
+      pTarget = data_.SerializeWithCachedSizesToArray(pTarget);
+      pTarget = CodedOutputStream::WriteVarint32ToArray(BLOB_TAG,pTarget);
+      pTarget = CodedOutputStream::WriteVarint32ToArray(u32BlobSize,pTarget);
+
+      std::memcpy(pTarget,entry.data(),u32BlobSize);
+
+      OPENTESTPOINT_PROBESERVICE_LOG_DEBUG(pProbeService_,
+                                           "/manager sending %s",
+                                           sTopic.c_str());
+
+      if(zmq_msg_send(&topicMessage,pPublisher_,ZMQ_SNDMORE) < 0)
+        {
+          zmq_msg_close(&topicMessage);
+          zmq_msg_close(&reportMessage);
+
+          OPENTESTPOINT_PROBESERVICE_LOG_ERROR(pProbeService_,
+                                               "/manager probe report send error: %s",
+                                               zmq_strerror(errno));
+          continue;
+        }
+
+      if(zmq_msg_send(&reportMessage,pPublisher_,0) < 0)
+        {
+          zmq_msg_close(&reportMessage);
+
+          OPENTESTPOINT_PROBESERVICE_LOG_ERROR(pProbeService_,
+                                               "/manager probe report send error: %s",
+                                               zmq_strerror(errno));
+        }
+    }
+}
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2026 - Adjacent Link LLC, Bridgewater, New Jersey
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  * Neither the name of Adjacent Link LLC nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * See toplevel COPYING for more information.
+ */
+
+#ifndef OPENTESTPOINT_PROBEREPORTPUBLISHER_HEADER_
+#define OPENTESTPOINT_PROBEREPORTPUBLISHER_HEADER_
+
+#include "otestpoint/probedatabuffer.h"
+#include "otestpoint/probeservice.h"
+#include "probereport.pb.h"
+
+#include <string>
+#include <map>
+#include <uuid.h>
+
+namespace OpenTestPoint
+{
+  /**
+   * @class ProbeReportPublisher
+   *
+   * @brief Publishes probe data entries as probe reports.
+   *
+   * A single report instance is reused for every entry so that only
+   * the per entry fields are assigned each interval. Topics are
+   * formatted once per probe name and each report is serialized
+   * directly into its message frame.
+   *
+   * The entry serialization is never stored in the report: the
+   * report and data fields are serialized around it and the blob is
+   * copied once, straight from the entry (or the plugin storage it
+   * references) into the frame.
+   */
+  class ProbeReportPublisher
+  {
+  public:
+    ProbeReportPublisher(void * pPublisher,
+                         const std::string & sNodeId,
+                         ProbeIndex probeIndex,
+                         const uuid_t & uuid,
+                         ProbeService * pProbeService);
+
+    /**
+     * Gets the publish topic for a probe name, formatting and
+     * caching it on first use.
+     */
+    const std::string & topic(const std::string & sName);
+
+    void publish(std::uint64_t u64Timestamp,
+                 const ProbeDataBuffer & buffer);
+
+    /**
+     * Publishes entries with trace stamps. The probe start and end
+     * are microseconds since the epoch, the publish stamp is taken
+     * as each entry is sent.
+     */
+    void publish(std::uint64_t u64Timestamp,
+                 const ProbeDataBuffer & buffer,
+                 std::uint64_t u64ProbeStart,
+                 std::uint64_t u64ProbeEnd);
+
+  private:
+    void * pPublisher_;
+    std::string sNodeId_;
+    ProbeService * pProbeService_;
+    ProbeReport report_;
+    ProbeReport::Data data_;
+
+    std::map<std::string,std::string> topics_;
+
+    void send(std::uint64_t u64Timestamp,
+              const ProbeDataBuffer & buffer,
+              bool bTrace);
+  };
+}
+
+#endif // OPENTESTPOINT_PROBEREPORTPUBLISHER_HEADER_
@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2026 - Adjacent Link LLC, Bridgewater, New Jersey
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  * Neither the name of Adjacent Link LLC nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * See toplevel COPYING for more information.
+ */
+
+#include "probetiming.h"
+#include "measurementtable.pb.h"
+
+namespace
+{
+  const char * BucketLabels[] =
+    {
+      "<=100us",
+      "<=1ms",
+      "<=10ms",
+      "<=100ms",
+      "<=1s",
+      ">1s"
+    };
+
+  void addUInteger(OpenTestPoint::MeasurementTable::Row * pRow, std::uint64_t u64Value)
+  {
+    auto pValue = pRow->add_values();
+    pValue->set_type(OpenTestPoint::MeasurementTable::Measurement::TYPE_UINTEGER);
+    pValue->set_uvalue(u64Value);
+  }
+}
+
+constexpr std::size_t OpenTestPoint::ProbeTiming::Buckets;
+
+OpenTestPoint::ProbeTiming::ProbeTiming(ProbeIndex probeIndex,
+                                        const std::chrono::microseconds & budget):
+  sName_{"OpenTestPoint.Timing." + std::to_string(probeIndex)},
+  budget_{budget},
+  u64Ticks_{},
+  u64Overruns_{},
+  u64Skipped_{},
+  u64TotalUsec_{},
+  u64MaxUsec_{},
+  u64LastUsec_{},
+  histogram_{}{}
+
+bool OpenTestPoint::ProbeTiming::record(const std::chrono::nanoseconds & latency,
+                                        std::uint64_t u64Skipped)
+{
+  std::uint64_t u64Usec =
+    std::chrono::duration_cast<std::chrono::microseconds>(latency).count();
+
+  ++u64Ticks_;
+
+  u64Skipped_ += u64Skipped;
+
+  u64TotalUsec_ += u64Usec;
+
+  u64LastUsec_ = u64Usec;
+
+  if(u64Usec > u64MaxUsec_)
+    {
+      u64MaxUsec_ = u64Usec;
+    }
+
+  std::size_t bucket{};
+
+  for(std::uint64_t u64Bound{100};
+      bucket < Buckets - 1 && u64Usec > u64Bound;
+      u64Bound *= 10)
+    {
+      ++bucket;
+    }
+
+  ++histogram_[bucket];
+
+  if(latency > budget_)
+    {
+      ++u64Overruns_;
+
+      return true;
+    }
+
+  return false;
+}
+
+const std::string & OpenTestPoint::ProbeTiming::getName() const
+{
+  return sName_;
+}
+
+void OpenTestPoint::ProbeTiming::setBudget(const std::chrono::microseconds & budget)
+{
+  budget_ = budget;
+}
+
+void OpenTestPoint::ProbeTiming::report(ProbeDataBuffer & buffer) const
+{
+  OpenTestPoint::MeasurementTable table;
+
+  for(const auto & sLabel : {"Ticks","Overruns","Skipped","Budget(us)","Last(us)","Mean(us)","Max(us)"})
+    {
+      table.add_labels(sLabel);
+    }
+
+  for(const auto & sLabel : BucketLabels)
+    {
+      table.add_labels(sLabel);
+    }
+
+  auto pRow = table.add_rows();
+
+  addUInteger(pRow,u64Ticks_);
+  addUInteger(pRow,u64Overruns_);
+  addUInteger(pRow,u64Skipped_);
+  addUInteger(pRow,budget_.count());
+  addUInteger(pRow,u64LastUsec_);
+  addUInteger(pRow,u64Ticks_ ? u64TotalUsec_ / u64Ticks_ : 0);
+  addUInteger(pRow,u64MaxUsec_);
+
+  for(const auto & u64Count : histogram_)
+    {
+      addUInteger(pRow,u64Count);
+    }
+
+  auto & entry = buffer.append();
+
+  entry.sTopic = sName_;
+  entry.sName = "MeasurementTable";
+  entry.sModule = "otestpoint.interface.measurementtable_pb2";
+  entry.u32Version = 1;
+
+  table.SerializeToString(&entry.sSerialization);
+}
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2026 - Adjacent Link LLC, Bridgewater, New Jersey
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  * Neither the name of Adjacent Link LLC nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * See toplevel COPYING for more information.
+ */
+
+#ifndef OPENTESTPOINT_PROBETIMING_HEADER_
+#define OPENTESTPOINT_PROBETIMING_HEADER_
+
+#include "otestpoint/types.h"
+#include "otestpoint/probedatabuffer.h"
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace OpenTestPoint
+{
+  // probe() execution time accounting for a single probe, reported
+  // as a MeasurementTable on OpenTestPoint.Timing.<index>
+  class ProbeTiming
+  {
+  public:
+    ProbeTiming(ProbeIndex probeIndex,
+                const std::chrono::microseconds & budget);
+
+    // records a probe execution and the number of rate boundaries
+    // missed while it ran, returns true on budget overrun
+    bool record(const std::chrono::nanoseconds & latency,
+                std::uint64_t u64Skipped);
+
+    const std::string & getName() const;
+
+    void setBudget(const std::chrono::microseconds & budget);
+
+    void report(ProbeDataBuffer & buffer) const;
+
+  private:
+    // decade histogram upper bounds in microseconds, the last
+    // bucket is unbounded
+    static constexpr std::size_t Buckets{6};
+
+    std::string sName_;
+    std::chrono::microseconds budget_;
+    std::uint64_t u64Ticks_;
+    std::uint64_t u64Overruns_;
+    std::uint64_t u64Skipped_;
+    std::uint64_t u64TotalUsec_;
+    std::uint64_t u64MaxUsec_;
+    std::uint64_t u64LastUsec_;
+    std::array<std::uint64_t,Buckets> histogram_;
+  };
+}
+
+#endif // OPENTESTPOINT_PROBETIMING_HEADER_
@@ -46,6 +46,24 @@ OpenTestPoint::PythonProbeAdapter::PythonProbeAdapter(ProbeIndex probeIndex,
                                                       ProbeService * pProbeService):
   ProbePlugin{probeIndex}
 {
+  try
+    {
+      load(sModule,sClass,pProbeService);
+    }
+  catch(...)
+    {
+      release();
+
+      throw;
+    }
+}
+
+void OpenTestPoint::PythonProbeAdapter::load(const std::string & sModule,
+                                             const std::string & sClass,
+                                             ProbeService * pProbeService)
+{
+  Toolkit::RAIIPyGIL gil{};
+
   // new reference
   pModule_.reset(PyImport_ImportModuleNoBlock(sModule.c_str()));
 
@@ -82,6 +100,14 @@ OpenTestPoint::PythonProbeAdapter::PythonProbeAdapter(ProbeIndex probeIndex,
       throw Toolkit::Exception{"Unable create an instance of %s",sClass.c_str()};
     }
 
+  // new reference
+  pProbeMethod_.reset(PyObject_GetAttrString(pProbe_.get(),"probe"));
+
+  if(!pProbeMethod_)
+    {
+      throw Toolkit::Exception{"Unable to locate probe method of %s",sClass.c_str()};
+    }
+
   // new refernce
   Toolkit::RAIIPyObject pToolkitLoggerModule{PyImport_ImportModuleNoBlock("otestpoint.toolkit.logger")};
 
@@ -140,12 +166,27 @@ OpenTestPoint::PythonProbeAdapter::PythonProbeAdapter(ProbeIndex probeIndex,
 }
 
 OpenTestPoint::PythonProbeAdapter::~PythonProbeAdapter()
-{}
+{
+  release();
+}
+
+void OpenTestPoint::PythonProbeAdapter::release()
+{
+  Toolkit::RAIIPyGIL gil{};
+
+  cache_.clear();
+  pProbeData_.reset(nullptr);
+  pProbeMethod_.reset(nullptr);
+  pProbe_.reset(nullptr);
+  pModule_.reset(nullptr);
+}
 
 
 OpenTestPoint::ProbeNames
 OpenTestPoint::PythonProbeAdapter::initialize(const std::string & sConfigurationFile)
 {
+  Toolkit::RAIIPyGIL gil{};
+
   ProbeNames probeNames{};
 
   Toolkit::RAIIPyObject pReturn{};
@@ -211,6 +252,8 @@ OpenTestPoint::PythonProbeAdapter::initialize(const std::string & sConfiguration
 
 void OpenTestPoint::PythonProbeAdapter::start()
 {
+  Toolkit::RAIIPyGIL gil{};
+
   // new object
   Toolkit::RAIIPyObject pReturn{PyObject_CallMethod(pProbe_.get(),const_cast<char *>("start"),nullptr)};
 
@@ -222,6 +265,8 @@ void OpenTestPoint::PythonProbeAdapter::start()
 
 void OpenTestPoint:: PythonProbeAdapter::stop()
 {
+  Toolkit::RAIIPyGIL gil{};
+
   // new object
   Toolkit::RAIIPyObject pReturn{PyObject_CallMethod(pProbe_.get(),const_cast<char *>("stop"),nullptr)};
 
@@ -233,6 +278,8 @@ void OpenTestPoint:: PythonProbeAdapter::stop()
 
 void OpenTestPoint::PythonProbeAdapter::destroy()
 {
+  Toolkit::RAIIPyGIL gil{};
+
   // new object
   Toolkit::RAIIPyObject pReturn{PyObject_CallMethod(pProbe_.get(),const_cast<char *>("destroy"),nullptr)};
 
@@ -245,10 +292,38 @@ void OpenTestPoint::PythonProbeAdapter::destroy()
 OpenTestPoint::ProbeData
 OpenTestPoint::PythonProbeAdapter::probe()
 {
+  ProbeDataBuffer buffer{};
+
+  probeInto(buffer);
+
   ProbeData probeData{};
 
+  for(const auto & entry : buffer)
+    {
+      probeData.push_back(std::make_tuple(entry.sTopic,
+                                          std::string(entry.data(),entry.size()),
+                                          entry.sName,
+                                          entry.sModule,
+                                          entry.u32Version));
+    }
+
+  return probeData;
+}
+
+void OpenTestPoint::PythonProbeAdapter::probeInto(ProbeDataBuffer & buffer)
+{
+  // probes run on a worker thread
+  Toolkit::RAIIPyGIL gil{};
+
+  // the previous interval has been published
+  pProbeData_.reset(nullptr);
+
   // new object
-  Toolkit::RAIIPyObject pReturn{PyObject_CallMethod(pProbe_.get(),const_cast<char *>("probe"),nullptr)};
+#if PY_VERSION_HEX >= 0x03090000
+  Toolkit::RAIIPyObject pReturn{PyObject_CallNoArgs(pProbeMethod_.get())};
+#else
+  Toolkit::RAIIPyObject pReturn{PyObject_CallObject(pProbeMethod_.get(),nullptr)};
+#endif
 
   if(!pReturn)
     {
@@ -272,48 +347,89 @@ OpenTestPoint::PythonProbeAdapter::probe()
 
   Py_ssize_t items{PyTuple_Size(pProbeDataTuple.get())};
 
+  // message serializations are referenced in place, the tuple holds
+  // the item tuples which hold the serialization objects
+  pProbeData_.swap(pProbeDataTuple);
+
   for(Py_ssize_t i = 0; i < items; ++i)
     {
       // borrowed reference
-      PyObject * pItem{PyTuple_GetItem(pProbeDataTuple.get(), i)};
+      PyObject * pItem{PyTuple_GetItem(pProbeData_.get(), i)};
 
       if(!PyTuple_Check(pItem))
         {
           throw Toolkit::Exception("invalid probe return entry must be a tuple");
         }
 
-      char * pzProbeName{};
+      if(PyTuple_GET_SIZE(pItem) != 5)
+        {
+          throw Toolkit::Exception("invalid probe return entry must be a tuple of 4 strings and int");
+        }
+
+      if(static_cast<std::size_t>(i) == cache_.size())
+        {
+          cache_.emplace_back();
+        }
+
+      auto & cached = cache_[i];
+
+      // borrowed references
+      PyObject * pProbeData{PyTuple_GET_ITEM(pItem,1)};
+      PyObject * pVersion{PyTuple_GET_ITEM(pItem,4)};
+
       char * pzProbeData{};
-      char * pzMessageName{};
-      char * pzMessageModule{};
-      Py_ssize_t probeNameSize{};
       Py_ssize_t probeDataSize{};
-      Py_ssize_t messageNameSize{};
-      Py_ssize_t messageModuleSize{};
-      std::uint32_t u32Version{};
-
-      if(!PyArg_ParseTuple(pItem,
-                           "s#s#s#s#I",
-                           &pzProbeName,
-                           &probeNameSize,
-                           &pzProbeData,
-                           &probeDataSize,
-                           &pzMessageName,
-                           &messageNameSize,
-                           &pzMessageModule,
-                           &messageModuleSize,
-                           &u32Version))
+
+      if(PyBytes_Check(pProbeData))
+        {
+          pzProbeData = PyBytes_AS_STRING(pProbeData);
+          probeDataSize = PyBytes_GET_SIZE(pProbeData);
+        }
+      else if(!PyArg_Parse(pProbeData,"s#",&pzProbeData,&probeDataSize))
         {
           throw Toolkit::Exception("invalid probe return entry must be a tuple of 4 strings and int");
         }
 
-      probeData.push_back(std::make_tuple(std::string(pzProbeName,probeNameSize),
-                                          std::string(pzProbeData,probeDataSize),
-                                          std::string(pzMessageName,messageNameSize),
-                                          std::string(pzMessageModule,messageModuleSize),
-                                          u32Version));
+      if(pVersion != cached.pVersion_.get())
+        {
+          if(!PyArg_Parse(pVersion,"I",&cached.u32Version_))
+            {
+              throw Toolkit::Exception("invalid probe return entry must be a tuple of 4 strings and int");
+            }
+
+          Py_INCREF(pVersion);
+          cached.pVersion_.reset(pVersion);
+        }
+
+      auto & entry = buffer.append();
+
+      entry.sTopic.assign(cached.topic_.convert(PyTuple_GET_ITEM(pItem,0)));
+      entry.pSerialization = pzProbeData;
+      entry.serializationSize = probeDataSize;
+      entry.sName.assign(cached.name_.convert(PyTuple_GET_ITEM(pItem,2)));
+      entry.sModule.assign(cached.module_.convert(PyTuple_GET_ITEM(pItem,3)));
+      entry.u32Version = cached.u32Version_;
     }
+}
+
+const std::string &
+OpenTestPoint::PythonProbeAdapter::Field::convert(PyObject * pObject)
+{
+  if(pObject != pObject_.get())
+    {
+      char * pzValue{};
+      Py_ssize_t valueSize{};
+
+      if(!PyArg_Parse(pObject,"s#",&pzValue,&valueSize))
+        {
+          throw Toolkit::Exception("invalid probe return entry must be a tuple of 4 strings and int");
+        }
 
+      sValue_.assign(pzValue,valueSize);
 
-  return probeData;
+      Py_INCREF(pObject);
+      pObject_.reset(pObject);
+    }
+
+  return sValue_;
 }
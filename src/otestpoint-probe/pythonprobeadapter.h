@@ -38,6 +38,8 @@
 #include "otestpoint/toolkit/raiipython.h"
 #include "otestpoint/probeplugin.h"
 
+#include <vector>
+
 namespace OpenTestPoint
 {
   class Logger;
@@ -62,9 +64,48 @@ namespace OpenTestPoint
 
     ProbeData probe() override;
 
+    void probeInto(ProbeDataBuffer & buffer) override;
+
   public:
     Toolkit::RAIIPyObject  pModule_;
     Toolkit::RAIIPyObject  pProbe_;
+
+  private:
+    // bound probe method, resolved once at load
+    Toolkit::RAIIPyObject pProbeMethod_;
+
+    // last probe() result, keeps the data referenced by probe data
+    // buffer entries alive until the next probe interval
+    Toolkit::RAIIPyObject pProbeData_;
+
+    // conversion of a probe() result field, reused while the probe
+    // keeps returning the same object
+    class Field
+    {
+    public:
+      const std::string & convert(PyObject * pObject);
+
+      Toolkit::RAIIPyObject pObject_;
+      std::string sValue_;
+    };
+
+    struct CachedEntry
+    {
+      Field topic_;
+      Field name_;
+      Field module_;
+      Toolkit::RAIIPyObject pVersion_;
+      std::uint32_t u32Version_;
+    };
+
+    // per probe() result index
+    std::vector<CachedEntry> cache_;
+
+    void load(const std::string & sModule,
+              const std::string & sClass,
+              ProbeService * pProbeService);
+
+    void release();
   };
 }
 
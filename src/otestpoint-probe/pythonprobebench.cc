@@ -0,0 +1,198 @@
+/*
+ * Copyright (c) 2026 - Adjacent Link LLC, Bridgewater, New Jersey
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  * Neither the name of Adjacent Link LLC nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * See toplevel COPYING for more information.
+ */
+
+// Measures the per tick cost of calling a python probe and
+// converting its result into probe data buffer entries: the
+// PythonProbeAdapter path versus the previous per tick method lookup
+// by name and full tuple parse. Reports nanoseconds per tick.
+
+#define PY_SSIZE_T_CLEAN 1
+#include "pythonprobeadapter.h"
+#include "benchsupport.h"
+
+#include "otestpoint/toolkit/raiipython.h"
+#include "otestpoint/probeservice.h"
+#include "otestpoint/probedatabuffer.h"
+
+#include <cstdlib>
+#include <cstdio>
+#include <string>
+
+namespace
+{
+  // the adapter attaches a toolkit logger to every probe, stand in
+  // for the extension module so the bench runs from the build tree
+  const char * pzSetup =
+    "import sys, types\n"
+    "logger = types.ModuleType('otestpoint.toolkit.logger')\n"
+    "class Logger(object):\n"
+    "    def __init__(self, client):\n"
+    "        pass\n"
+    "logger.Logger = Logger\n"
+    "sys.modules['otestpoint.toolkit.logger'] = logger\n"
+    "bench = types.ModuleType('otestpointbench')\n"
+    "exec('''\n"
+    "NAMES = []\n"
+    "BLOB = b''\n"
+    "class BenchProbe(object):\n"
+    "    def probe(self):\n"
+    "        return [(name, BLOB, 'Measurement_bench', 'otestpoint.bench', 1) for name in NAMES]\n"
+    "''', bench.__dict__)\n"
+    "sys.modules['otestpointbench'] = bench\n";
+
+  // the adapter probe path prior to cached lookups
+  void legacyProbe(PyObject * pProbe,
+                   OpenTestPoint::ProbeDataBuffer & buffer)
+  {
+    OpenTestPoint::Toolkit::RAIIPyGIL gil{};
+
+    OpenTestPoint::Toolkit::RAIIPyObject pReturn{PyObject_CallMethod(pProbe,const_cast<char *>("probe"),nullptr)};
+
+    OpenTestPoint::Toolkit::RAIIPyObject pProbeDataTuple{PyList_AsTuple(pReturn.get())};
+
+    Py_ssize_t items{PyTuple_Size(pProbeDataTuple.get())};
+
+    for(Py_ssize_t i = 0; i < items; ++i)
+      {
+        PyObject * pItem{PyTuple_GetItem(pProbeDataTuple.get(), i)};
+
+        char * pzProbeName{};
+        char * pzProbeData{};
+        char * pzMessageName{};
+        char * pzMessageModule{};
+        Py_ssize_t probeNameSize{};
+        Py_ssize_t probeDataSize{};
+        Py_ssize_t messageNameSize{};
+        Py_ssize_t messageModuleSize{};
+        std::uint32_t u32Version{};
+
+        if(!PyArg_ParseTuple(pItem,
+                             "s#s#s#s#I",
+                             &pzProbeName,
+                             &probeNameSize,
+                             &pzProbeData,
+                             &probeDataSize,
+                             &pzMessageName,
+                             &messageNameSize,
+                             &pzMessageModule,
+                             &messageModuleSize,
+                             &u32Version))
+          {
+            std::abort();
+          }
+
+        auto & entry = buffer.append();
+
+        entry.sTopic.assign(pzProbeName,probeNameSize);
+        entry.sSerialization.assign(pzProbeData,probeDataSize);
+        entry.sName.assign(pzMessageName,messageNameSize);
+        entry.sModule.assign(pzMessageModule,messageModuleSize);
+        entry.u32Version = u32Version;
+      }
+  }
+
+  template<typename Function>
+  void report(const char * pzPath,
+              std::size_t entries,
+              std::size_t blobSize,
+              std::size_t ticks,
+              Function fn)
+  {
+    OpenTestPoint::ProbeDataBuffer buffer{};
+
+    double dNsPerTick{OpenTestPoint::Bench::measure(100,ticks,
+                                                    [&](std::size_t)
+                                                    {
+                                                      buffer.clear();
+                                                      fn(buffer);
+                                                    })};
+
+    std::printf("%-8s entries=%-3zu blob=%-6zu ns/tick=%.1f\n",
+                pzPath,
+                entries,
+                blobSize,
+                dNsPerTick);
+  }
+}
+
+int main(int argc, char * argv[])
+{
+  std::size_t ticks{argc > 1 ? std::strtoul(argv[1],nullptr,10) : 1000};
+
+  Py_InitializeEx(0);
+
+  if(PyRun_SimpleString(pzSetup))
+    {
+      return EXIT_FAILURE;
+    }
+
+  OpenTestPoint::Bench::NullProbeService probeService{};
+
+  {
+    OpenTestPoint::PythonProbeAdapter adapter{1,
+        "otestpointbench",
+        "BenchProbe",
+        &probeService};
+
+    for(std::size_t entries : {1,8})
+      {
+        for(std::size_t blobSize : {64,16384})
+          {
+            std::string sConfigure{"bench.NAMES = ['Probes.Bench.%d' % i for i in range(" +
+                std::to_string(entries) +
+                ")]\nbench.BLOB = b'x' * " +
+                std::to_string(blobSize) +
+                "\n"};
+
+            PyRun_SimpleString(sConfigure.c_str());
+
+            report("legacy",entries,blobSize,ticks,
+                   [&adapter](OpenTestPoint::ProbeDataBuffer & buffer)
+                   {
+                     legacyProbe(adapter.pProbe_.get(),buffer);
+                   });
+
+            report("adapter",entries,blobSize,ticks,
+                   [&adapter](OpenTestPoint::ProbeDataBuffer & buffer)
+                   {
+                     adapter.probeInto(buffer);
+                   });
+          }
+      }
+  }
+
+  Py_Finalize();
+
+  return EXIT_SUCCESS;
+}
@@ -89,7 +89,10 @@ public:
       "          Format.)\n"
       " size -   The size of the serialized probe message.\n\n"
       "The SQLite database file will have the same name as the log file with\n"
-      "an additional .db extension appended.";
+      "an additional .db extension appended.\n\n"
+      "The recorder also records its own OpenTestPoint.Self.recorder\n"
+      "measurement table every 10 seconds, containing the number of probe\n"
+      "messages recorded and dropped.";
   }
 };
 
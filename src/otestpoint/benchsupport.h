@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2026 - Adjacent Link LLC, Bridgewater, New Jersey
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  * Neither the name of Adjacent Link LLC nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * See toplevel COPYING for more information.
+ */
+#ifndef OPENTESTPOINT_BENCHSUPPORT_HEADER_
+#define OPENTESTPOINT_BENCHSUPPORT_HEADER_
+
+#include "otestpoint/probeservice.h"
+#include "otestpoint/toolkit/log/client.h"
+#include "benchmeasure.h"
+
+#include <chrono>
+#include <list>
+#include <string>
+
+// Support shared by the otestpoint and otestpoint-probe benches. Not
+// installed.
+
+namespace OpenTestPoint
+{
+  namespace Bench
+  {
+    /**
+     * @class NullLogClient
+     *
+     * @brief Log client that discards everything, so benches measure
+     * the path under test and not logging.
+     */
+    class NullLogClient : public Toolkit::Log::Client
+    {
+    public:
+      NullLogClient():
+        Client{"bench"}{}
+
+      void log(Toolkit::Log::Level, const char *,...) override {}
+
+      void setRateLimit(Toolkit::Log::Level, double, double) override {}
+
+      std::string getControlEndpoint() const override {return {};}
+
+      std::string getPublishEndpoint() const override {return {};}
+
+      Toolkit::Log::ClientStatistics getStatistics() const override {return {};}
+
+    private:
+      bool allowLog_i(Toolkit::Log::Level) override {return false;}
+
+      bool allowSite_i(Toolkit::Log::Level, const void *) override {return false;}
+
+      void log_i(Toolkit::Log::Level,
+                 const std::chrono::high_resolution_clock::time_point &,
+                 const std::list<std::string> &) override {}
+    };
+
+    /**
+     * @class NullProbeService
+     *
+     * @brief Probe service handing out a NullLogClient.
+     */
+    class NullProbeService : public ProbeService
+    {
+    public:
+      Toolkit::Log::Client * logClient() override
+      {
+        return &client_;
+      }
+
+    private:
+      NullLogClient client_;
+    };
+  }
+}
+
+#endif // OPENTESTPOINT_BENCHSUPPORT_HEADER_
@@ -66,7 +66,8 @@ void OpenTestPoint::BrokerBuilder::buildBroker(Toolkit::Log::Service & logServic
       pImpl_->pBrokerImpl_.reset(new BrokerImpl{logService,
             logClient,
             sServiceEndpoint,
-            sPublishEndpoint});
+            sPublishEndpoint,
+            pImpl_->uuid_});
     }
   else
     {
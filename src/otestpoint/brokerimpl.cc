@@ -54,10 +54,13 @@ discoverRemote(const std::string & sDiscoveryEndpoint,
 OpenTestPoint::BrokerImpl::BrokerImpl(Toolkit::Log::Service & logService,
                                       Toolkit::Log::Client & logClient,
                                       const std::string & sServiceEndpoint,
-                                      const std::string & sPublishEndpoint):
+                                      const std::string & sPublishEndpoint,
+                                      const uuid_t & uuid):
   logService_(logService),
   logClient_(logClient)
 {
+  uuid_copy(uuid_,uuid);
+
   pContext_.reset(zmq_ctx_new());
 
   if(!pContext_)
@@ -244,6 +247,10 @@ void OpenTestPoint::BrokerImpl::process(const std::string & sServiceEndpoint,
               zmq_strerror(errno)};
         }
 
+      SelfMonitor selfMonitor{"broker",uuid_};
+
+      TraceHop traceHop{"broker@" + sPublishEndpoint};
+
       bool bRun{true};
 
       while(bRun)
@@ -256,7 +263,9 @@ void OpenTestPoint::BrokerImpl::process(const std::string & sServiceEndpoint,
               {pXSubSocket.get(),0,ZMQ_POLLIN,0},
             };
 
-          int rc = zmq_poll(&items[0],items.size(),-1);
+          int rc = zmq_poll(&items[0],items.size(),selfMonitor.timeout());
+
+          selfMonitor.iteration();
 
           if(rc == -1)
             {
@@ -348,6 +357,8 @@ void OpenTestPoint::BrokerImpl::process(const std::string & sServiceEndpoint,
                     }
                   else if(item.socket == pDiscoverySocket.get())
                     {
+                      auto start = SelfMonitor::Clock::now();
+
                       // external interface handling probe discovery
                       zmq_msg_t message;
 
@@ -397,6 +408,12 @@ void OpenTestPoint::BrokerImpl::process(const std::string & sServiceEndpoint,
                                       }
                                   }
 
+                                uniqueTopics.insert(selfMonitor.getName());
+
+                                uniqueTopics.insert(selfMonitor.getLogName());
+
+                                uniqueTopics.insert(selfMonitor.getLogServiceName());
+
                                 for(const auto & sTopic : uniqueTopics)
                                   {
                                     pDiscovery->add_names(sTopic);
@@ -426,9 +443,14 @@ void OpenTestPoint::BrokerImpl::process(const std::string & sServiceEndpoint,
 
                       zmq_msg_close(&message);
 
+                      selfMonitor.discovery(SelfMonitor::Clock::now() - start);
                     }
                   else if(item.socket == pXPubSocket.get())
                     {
+                      bool bDropped{};
+
+                      std::size_t bytes{};
+
                       while(1)
                         {
                           zmq_msg_t message;
@@ -443,7 +465,12 @@ void OpenTestPoint::BrokerImpl::process(const std::string & sServiceEndpoint,
 
                           zmq_getsockopt(pXPubSocket.get(),ZMQ_RCVMORE,&iMore,&sizeMore);
 
-                          zmq_msg_send(&message,pXSubSocket.get(),iMore ? ZMQ_SNDMORE : 0);
+                          bytes += zmq_msg_size(&message);
+
+                          if(zmq_msg_send(&message,pXSubSocket.get(),iMore ? ZMQ_SNDMORE : 0) < 0)
+                            {
+                              bDropped = true;
+                            }
 
                           zmq_msg_close(&message);
 
@@ -452,9 +479,24 @@ void OpenTestPoint::BrokerImpl::process(const std::string & sServiceEndpoint,
                               break;
                             }
                         }
+
+                      if(bDropped)
+                        {
+                          selfMonitor.dropped(SelfMonitor::Direction::SUBSCRIBE);
+                        }
+                      else
+                        {
+                          selfMonitor.forwarded(SelfMonitor::Direction::SUBSCRIBE,bytes);
+                        }
                     }
                   else if(item.socket ==  pXSubSocket.get())
                     {
+                      bool bDropped{};
+
+                      std::size_t bytes{};
+
+                      std::size_t parts{};
+
                       while(1)
                         {
                           zmq_msg_t message;
@@ -469,7 +511,18 @@ void OpenTestPoint::BrokerImpl::process(const std::string & sServiceEndpoint,
 
                           zmq_getsockopt(item.socket,ZMQ_RCVMORE,&iMore,&sizeMore);
 
-                          zmq_msg_send(&message,pXPubSocket.get(),iMore ? ZMQ_SNDMORE : 0);
+                          // topic followed by the probe report
+                          if(parts++ && !iMore)
+                            {
+                              traceHop.stamp(message);
+                            }
+
+                          bytes += zmq_msg_size(&message);
+
+                          if(zmq_msg_send(&message,pXPubSocket.get(),iMore ? ZMQ_SNDMORE : 0) < 0)
+                            {
+                              bDropped = true;
+                            }
 
                           zmq_msg_close(&message);
 
@@ -478,9 +531,23 @@ void OpenTestPoint::BrokerImpl::process(const std::string & sServiceEndpoint,
                               break;
                             }
                         }
+
+                      if(bDropped)
+                        {
+                          selfMonitor.dropped(SelfMonitor::Direction::PUBLISH);
+                        }
+                      else
+                        {
+                          selfMonitor.forwarded(SelfMonitor::Direction::PUBLISH,bytes);
+                        }
                     }
                 }
             }
+
+          if(selfMonitor.due())
+            {
+              publishSelf(pXPubSocket.get(),selfMonitor);
+            }
         }
     }
   catch(std::exception & exp)
@@ -489,6 +556,26 @@ void OpenTestPoint::BrokerImpl::process(const std::string & sServiceEndpoint,
     }
 }
 
+void OpenTestPoint::BrokerImpl::publishSelf(void * pXPubSocket,
+                                            SelfMonitor & selfMonitor)
+{
+  auto send = [pXPubSocket,&selfMonitor](const std::string & sTopic,
+                                         const std::string & sSerialization)
+    {
+      if(zmq_send(pXPubSocket,sTopic.c_str(),sTopic.size(),ZMQ_SNDMORE | ZMQ_DONTWAIT) < 0 ||
+         zmq_send(pXPubSocket,sSerialization.c_str(),sSerialization.size(),ZMQ_DONTWAIT) < 0)
+        {
+          selfMonitor.dropped(SelfMonitor::Direction::PUBLISH);
+        }
+    };
+
+  send(selfMonitor.getName(),selfMonitor.report({}));
+
+  send(selfMonitor.getLogName(),selfMonitor.logReport({}));
+
+  send(selfMonitor.getLogServiceName(),selfMonitor.logServiceReport({},logService_));
+}
+
 std::tuple<std::set<std::string>,bool>
 discoverRemote(const std::string & sDiscoveryEndpoint,
                void * pContext,
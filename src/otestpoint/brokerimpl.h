@@ -39,9 +39,12 @@
 #include "otestpoint/toolkit/log/service.h"
 #include "otestpoint/toolkit/log/client.h"
 #include "otestpoint/toolkit/raiizmq.h"
+#include "selfmonitor.h"
+#include "tracehop.h"
 
 #include <string>
 #include <thread>
+#include <uuid.h>
 
 namespace OpenTestPoint
 {
@@ -51,7 +54,8 @@ namespace OpenTestPoint
     BrokerImpl(Toolkit::Log::Service & logService,
                Toolkit::Log::Client & logClient,
                const std::string & sServiceEndpoint,
-               const std::string & sPublishEndpoint);
+               const std::string & sPublishEndpoint,
+               const uuid_t & uuid);
 
     ~BrokerImpl();
 
@@ -71,10 +75,13 @@ namespace OpenTestPoint
     Toolkit::RAIIZMQSocket pInternalSocket_;
     Toolkit::Log::Service & logService_;
     Toolkit::Log::Client & logClient_;
+    uuid_t uuid_;
     std::thread thread_;
 
     void process(const std::string & sServiceEndpoint,
                  const std::string & sPublishEndpoint);
+
+    void publishSelf(void * pXPubSocket, SelfMonitor & selfMonitor);
   };
 }
 
@@ -42,19 +42,30 @@
 #include "discovery.pb.h"
 
 #include <zmq.h>
+#include <algorithm>
 #include <cstring>
+#include <limits>
 #include <vector>
 #include <map>
 #include <set>
+#include <future>
 #include <iostream>
 
-OpenTestPoint::ControllerImpl::ControllerImpl(Toolkit::Log::Service & logService,
+OpenTestPoint::ControllerImpl::ControllerImpl(const std::string & sNodeId,
+                                              Toolkit::Log::Service & logService,
                                               Toolkit::Log::Client & logClient,
                                               const std::string & sServiceEndpoint,
-                                              const std::string & sPublishEndpoint):
+                                              const std::string & sPublishEndpoint,
+                                              const uuid_t & uuid):
+  sNodeId_{sNodeId},
   logService_(logService),
-  logClient_(logClient)
+  logClient_(logClient),
+  bRunning_{},
+  bWorkerRun_{true},
+  bInterestPending_{}
 {
+  uuid_copy(uuid_,uuid);
+
   pContext_.reset(zmq_ctx_new());
 
   if(!pContext_)
@@ -77,6 +88,36 @@ OpenTestPoint::ControllerImpl::ControllerImpl(Toolkit::Log::Service & logService
           zmq_strerror(errno)};
     }
 
+  pWorkerSocket_.reset(zmq_socket(pContext_.get(),ZMQ_PAIR));
+
+  if(!pWorkerSocket_)
+    {
+      throw Toolkit::Exception{"unable to create new worker socket: %s ",
+          zmq_strerror(errno)};
+    }
+
+  if(zmq_bind(pWorkerSocket_.get(),"inproc://controller-worker") < 0)
+    {
+      throw Toolkit::Exception{"unable to bind worker endpoint:  %s ",
+          zmq_strerror(errno)};
+    }
+
+  pSupervisor_.reset(new ProbeSupervisor{pContext_.get(),
+        sNodeId_,
+        uuid,
+        logService_,
+        [this](const std::string & sPreviousControlEndpoint,
+               const std::string & sPreviousPublishEndpoint,
+               const std::string & sControlEndpoint,
+               const std::string & sPublishEndpoint)
+        {
+          removeLogEndpoints(sPreviousControlEndpoint,sPreviousPublishEndpoint);
+
+          addLogEndpoints(sControlEndpoint,sPublishEndpoint);
+        }});
+
+  workerThread_ = std::move(std::thread(&ControllerImpl::work,this));
+
   thread_ = std::move(std::thread(&ControllerImpl::process,
                                   this,
                                   sServiceEndpoint,
@@ -96,6 +137,17 @@ OpenTestPoint::ControllerImpl::ControllerImpl(Toolkit::Log::Service & logService
       }))
     {
       thread_.join();
+
+      {
+        std::lock_guard<std::mutex> lock(workerMutex_);
+
+        bWorkerRun_ = false;
+      }
+
+      workerCondition_.notify_one();
+
+      workerThread_.join();
+
       throw Toolkit::Exception{"unable to verify processing thread creation"};
     }
 
@@ -106,6 +158,18 @@ OpenTestPoint::ControllerImpl::ControllerImpl(Toolkit::Log::Service & logService
 
 OpenTestPoint::ControllerImpl::~ControllerImpl()
 {
+  pSupervisor_->stop();
+
+  {
+    std::lock_guard<std::mutex> lock(workerMutex_);
+
+    bWorkerRun_ = false;
+  }
+
+  workerCondition_.notify_one();
+
+  workerThread_.join();
+
   if(Toolkit::transaction<OpenTestPoint::ControllerCommand,
      OpenTestPoint::ControllerResponse>
      (pInternalSocket_.get(),
@@ -118,70 +182,550 @@ OpenTestPoint::ControllerImpl::~ControllerImpl()
 
 void OpenTestPoint::ControllerImpl::initialize(const std::string &)
 {
-  for(const auto & entry : probeInfo_)
+  std::lock_guard<std::mutex> lock(probeMutex_);
+
+  std::vector<ProbeEntry *> entries{};
+
+  for(auto & entry : probeInfo_)
     {
-      auto topics = std::get<0>(entry)->initialize(std::get<1>(entry));
+      entries.push_back(&entry);
+    }
 
-      OpenTestPoint::ControllerCommand command;
+  initialize(entries);
+
+  pSupervisor_->start();
+}
+
+void OpenTestPoint::ControllerImpl::start()
+{
+  parallel([](Probe * pProbe){pProbe->start();});
+
+  bRunning_ = true;
+}
+
+void OpenTestPoint::ControllerImpl::stop()
+{
+  bRunning_ = false;
+
+  parallel([](Probe * pProbe){pProbe->stop();});
+}
+
+void OpenTestPoint::ControllerImpl::destroy()
+{
+  // host processes exit once their probes are destroyed
+  pSupervisor_->stop();
+
+  parallel([](Probe * pProbe){pProbe->destroy();});
+
+  std::lock_guard<std::mutex> lock(probeMutex_);
+
+  ProbeInfo probeInfo{};
+
+  probeInfo.swap(probeInfo_);
+
+  updateStatusProbes();
+
+  for(const auto & entry : probeInfo)
+    {
+      delete entry.pProbe_;
+    }
+}
+
+void OpenTestPoint::ControllerImpl::add(ProbeContainer * pProbe,
+                                        const std::string & sConfiguration,
+                                        const std::string & sKey)
+{
+  std::lock_guard<std::mutex> lock(probeMutex_);
+
+  probeInfo_.push_back(ProbeEntry{pProbe,sConfiguration,sKey,{},false});
 
-      command.set_type(OpenTestPoint::ControllerCommand::TYPE_ADD);
+  updateStatusProbes();
+}
+
+std::vector<std::size_t>
+OpenTestPoint::ControllerImpl::retain(const std::vector<std::string> & keys,
+                                      const std::vector<std::chrono::seconds> & rates)
+{
+  std::lock_guard<std::mutex> lock(probeMutex_);
 
-      auto pAdd = command.mutable_add();
+  std::vector<std::size_t> missing{};
 
-      pAdd->set_publish(std::get<0>(entry)->getProbePublishEndpoint());
+  std::set<ProbeEntry *> kept{};
 
-      for(const auto & topic : topics)
+  for(std::size_t i = 0; i < keys.size(); ++i)
+    {
+      auto iter = std::find_if(probeInfo_.begin(),
+                               probeInfo_.end(),
+                               [&keys,&kept,i](ProbeEntry & entry)
+                               {
+                                 return entry.sKey_ == keys[i] && !kept.count(&entry);
+                               });
+
+      if(iter != probeInfo_.end())
         {
-          pAdd->add_topics(topic);
+          kept.insert(&*iter);
+
+          // rate changes are applied in place
+          if(i < rates.size() && iter->pProbe_->getRate() != rates[i])
+            {
+              try
+                {
+                  iter->pProbe_->setRate(rates[i]);
+                }
+              catch(std::exception & exp)
+                {
+                  logClient_.log(Toolkit::Log::Level::ERROR_LEVEL,
+                                 "reconfigure: unable to set rate: %s",
+                                 exp.what());
+                }
+            }
+        }
+      else
+        {
+          missing.push_back(i);
         }
+    }
 
-      std::string sSerialization;
+  std::vector<ProbeEntry> removed{};
 
-      if(!command.SerializeToString(&sSerialization))
+  for(auto iter = probeInfo_.begin(); iter != probeInfo_.end();)
+    {
+      if(!kept.count(&*iter))
         {
-          throw Toolkit::Exception{"unable to serialize probe message"};
+          // a host exiting with its last probe is not restarted
+          pSupervisor_->remove(iter->pProbe_);
+
+          removed.push_back(*iter);
+
+          iter = probeInfo_.erase(iter);
         }
+      else
+        {
+          ++iter;
+        }
+    }
 
-      zmq_send(pInternalSocket_.get(),sSerialization.c_str(),sSerialization.length(),0);
+  updateStatusProbes();
+
+  std::vector<ProbeContainer *> probes{};
+
+  for(const auto & entry : removed)
+    {
+      probes.push_back(entry.pProbe_);
     }
+
+  parallel(probes,[](Probe * pProbe)
+                  {
+                    pProbe->stop();
+                    pProbe->destroy();
+                  });
+
+  withdraw(removed);
+
+  for(auto pProbe : probes)
+    {
+      delete pProbe;
+    }
+
+  logClient_.log(Toolkit::Log::Level::INFO_LEVEL,
+                 "reconfigure: %zu probes kept, %zu removed, %zu added",
+                 kept.size(),
+                 removed.size(),
+                 missing.size());
+
+  return missing;
 }
 
-void OpenTestPoint::ControllerImpl::start()
+void OpenTestPoint::ControllerImpl::commit()
+{
+  std::lock_guard<std::mutex> lock(probeMutex_);
+
+  std::vector<ProbeEntry *> entries{};
+
+  std::vector<ProbeContainer *> probes{};
+
+  for(auto & entry : probeInfo_)
+    {
+      if(!entry.bInitialized_)
+        {
+          entries.push_back(&entry);
+
+          probes.push_back(entry.pProbe_);
+        }
+    }
+
+  initialize(entries);
+
+  if(bRunning_)
+    {
+      parallel(probes,[](Probe * pProbe){pProbe->start();});
+    }
+}
+
+OpenTestPoint::ProbeNames
+OpenTestPoint::ControllerImpl::setRate(const std::string & sName,
+                                       const std::chrono::seconds & probeRate)
 {
+  std::lock_guard<std::mutex> lock(probeMutex_);
+
+  auto iter = std::find_if(probeInfo_.begin(),
+                           probeInfo_.end(),
+                           [&sName](const ProbeEntry & entry)
+                           {
+                             return std::find(entry.topics_.begin(),
+                                              entry.topics_.end(),
+                                              sName) != entry.topics_.end();
+                           });
+
+  if(iter == probeInfo_.end())
+    {
+      throw Toolkit::Exception{"unknown probe: %s",sName.c_str()};
+    }
+
+  logClient_.log(Toolkit::Log::Level::INFO_LEVEL,
+                 "set rate %s: %zd",
+                 sName.c_str(),
+                 probeRate.count());
+
+  iter->pProbe_->setRate(probeRate);
+
+  return iter->topics_;
+}
+
+void OpenTestPoint::ControllerImpl::initialize(const std::vector<ProbeEntry *> & entries)
+{
+  // initialize all probes concurrently, startup is bound by the
+  // slowest probe rather than the sum of all probes
+  std::vector<std::future<ProbeNames>> futures{};
+
+  for(auto pEntry : entries)
+    {
+      futures.push_back(std::async(std::launch::async,
+                                   [pEntry]()
+                                   {
+                                     return pEntry->pProbe_->initialize(pEntry->sConfiguration_);
+                                   }));
+    }
+
+  auto iter = futures.begin();
+
+  for(auto pEntry : entries)
+    {
+      pEntry->topics_ = (iter++)->get();
+
+      pEntry->bInitialized_ = true;
+
+      // endpoints are unknown if the probe process never reported
+      // ready, the supervisor adds the probe if it is recovered
+      if(!pEntry->pProbe_->getProbePublishEndpoint().empty())
+        {
+          advertise(*pEntry);
+        }
+
+      pSupervisor_->add(pEntry->pProbe_);
+    }
+}
+
+void OpenTestPoint::ControllerImpl::advertise(const ProbeEntry & entry)
+{
+  Probe * pProbe{entry.pProbe_};
+
+  addLogEndpoints(pProbe->getLogControlEndpoint(),
+                  pProbe->getLogPublishEndpoint());
+
+  OpenTestPoint::ControllerCommand command;
+
+  command.set_type(OpenTestPoint::ControllerCommand::TYPE_ADD);
+
+  auto pAdd = command.mutable_add();
+
+  pAdd->set_publish(pProbe->getProbePublishEndpoint());
+
+  for(const auto & topic : entry.topics_)
+    {
+      pAdd->add_topics(topic);
+    }
+
+  send(command);
+}
+
+void OpenTestPoint::ControllerImpl::withdraw(const std::vector<ProbeEntry> & entries)
+{
+  // topics and endpoints may be shared with remaining probes
+  std::set<std::string> topics{};
+
+  std::set<std::string> endpoints{};
+
   for(const auto & entry : probeInfo_)
     {
-      std::get<0>(entry)->start();
+      topics.insert(entry.topics_.begin(),entry.topics_.end());
+
+      endpoints.insert(entry.pProbe_->getProcess()->getProbePublishEndpoint());
+    }
+
+  std::set<std::string> withdrawn{};
+
+  for(const auto & entry : entries)
+    {
+      OpenTestPoint::ControllerCommand command;
+
+      command.set_type(OpenTestPoint::ControllerCommand::TYPE_REMOVE);
+
+      auto pRemove = command.mutable_remove();
+
+      const auto & pProcess = entry.pProbe_->getProcess();
+
+      const auto & sPublishEndpoint = pProcess->getProbePublishEndpoint();
+
+      // the host exits with its last probe
+      if(!sPublishEndpoint.empty() &&
+         !endpoints.count(sPublishEndpoint) &&
+         withdrawn.insert(sPublishEndpoint).second)
+        {
+          pRemove->set_publish(sPublishEndpoint);
+
+          removeLogEndpoints(pProcess->getLogControlEndpoint(),
+                             pProcess->getLogPublishEndpoint());
+        }
+
+      for(const auto & topic : entry.topics_)
+        {
+          if(!topics.count(topic))
+            {
+              pRemove->add_topics(topic);
+            }
+        }
+
+      send(command);
     }
 }
 
-void OpenTestPoint::ControllerImpl::stop()
+void OpenTestPoint::ControllerImpl::interest(const std::map<std::string,std::size_t> & subscriptions)
 {
+  std::lock_guard<std::mutex> lock(probeMutex_);
+
   for(const auto & entry : probeInfo_)
     {
-      std::get<0>(entry)->stop();
+      bool bInterest{};
+
+      for(const auto & topic : entry.topics_)
+        {
+          for(const auto & subscription : subscriptions)
+            {
+              if(!topic.compare(0,subscription.first.size(),subscription.first))
+                {
+                  bInterest = true;
+                  break;
+                }
+            }
+
+          if(bInterest)
+            {
+              break;
+            }
+        }
+
+      // a rejected request does not stop the others
+      try
+        {
+          entry.pProbe_->setInterest(bInterest);
+        }
+      catch(std::exception & exp)
+        {
+          logClient_.log(Toolkit::Log::Level::ERROR_LEVEL,
+                         "interest: unable to set interest: %s",
+                         exp.what());
+        }
     }
 }
 
-void OpenTestPoint::ControllerImpl::destroy()
+void OpenTestPoint::ControllerImpl::updateInterest(const std::map<std::string,std::size_t> & subscriptions)
+{
+  bool bPost{};
+
+  {
+    std::lock_guard<std::mutex> lock(workerMutex_);
+
+    interestSubscriptions_ = subscriptions;
+
+    bPost = !bInterestPending_;
+
+    bInterestPending_ = true;
+  }
+
+  // a queued update applies the latest subscriptions when it runs
+  if(bPost)
+    {
+      post([this]()
+           {
+             std::map<std::string,std::size_t> subscriptions{};
+
+             {
+               std::lock_guard<std::mutex> lock(workerMutex_);
+
+               subscriptions.swap(interestSubscriptions_);
+
+               bInterestPending_ = false;
+             }
+
+             interest(subscriptions);
+           });
+    }
+}
+
+void OpenTestPoint::ControllerImpl::send(const ControllerCommand & command)
+{
+  std::string sSerialization;
+
+  if(!command.SerializeToString(&sSerialization))
+    {
+      throw Toolkit::Exception{"unable to serialize probe message"};
+    }
+
+  zmq_send(pInternalSocket_.get(),sSerialization.c_str(),sSerialization.length(),0);
+}
+
+void OpenTestPoint::ControllerImpl::post(std::function<void ()> task)
 {
+  {
+    std::lock_guard<std::mutex> lock(workerMutex_);
+
+    tasks_.push_back(std::move(task));
+  }
+
+  workerCondition_.notify_one();
+}
+
+void OpenTestPoint::ControllerImpl::work()
+{
+  std::unique_lock<std::mutex> lock(workerMutex_);
+
+  while(true)
+    {
+      workerCondition_.wait(lock,
+                            [this]()
+                            {
+                              return !tasks_.empty() || !bWorkerRun_;
+                            });
+
+      // queued tasks are dropped on shutdown
+      if(!bWorkerRun_)
+        {
+          break;
+        }
+
+      auto task = std::move(tasks_.front());
+
+      tasks_.pop_front();
+
+      lock.unlock();
+
+      try
+        {
+          task();
+        }
+      catch(std::exception & exp)
+        {
+          logClient_.log(Toolkit::Log::Level::ERROR_LEVEL,
+                         "controller worker: %s",
+                         exp.what());
+        }
+
+      lock.lock();
+    }
+}
+
+void OpenTestPoint::ControllerImpl::addLogEndpoints(const std::string & sControlEndpoint,
+                                                    const std::string & sPublishEndpoint)
+{
+  std::lock_guard<std::mutex> lock(logMutex_);
+
+  // probes sharing a host process share its log client
+  if(logEndpoints_.insert(sControlEndpoint).second)
+    {
+      logService_.add(sControlEndpoint,sPublishEndpoint);
+    }
+}
+
+void OpenTestPoint::ControllerImpl::removeLogEndpoints(const std::string & sControlEndpoint,
+                                                       const std::string & sPublishEndpoint)
+{
+  std::lock_guard<std::mutex> lock(logMutex_);
+
+  if(logEndpoints_.erase(sControlEndpoint))
+    {
+      logService_.remove(sControlEndpoint,sPublishEndpoint);
+    }
+}
+
+void OpenTestPoint::ControllerImpl::parallel(std::function<void (Probe *)> fn)
+{
+  std::lock_guard<std::mutex> lock(probeMutex_);
+
+  std::vector<ProbeContainer *> probes{};
+
   for(const auto & entry : probeInfo_)
     {
-      std::get<0>(entry)->destroy();
+      probes.push_back(entry.pProbe_);
     }
 
+  parallel(probes,fn);
+}
+
+void OpenTestPoint::ControllerImpl::parallel(const std::vector<ProbeContainer *> & probes,
+                                             std::function<void (Probe *)> fn)
+{
+  std::vector<std::future<void>> futures{};
+
+  for(auto pProbe : probes)
+    {
+      futures.push_back(std::async(std::launch::async,fn,pProbe));
+    }
+
+  for(auto & future : futures)
+    {
+      future.get();
+    }
+}
+
+void OpenTestPoint::ControllerImpl::updateStatusProbes()
+{
+  std::vector<ProbeContainer *> probes{};
+
   for(const auto & entry : probeInfo_)
     {
-      delete std::get<0>(entry);
+      probes.push_back(entry.pProbe_);
     }
+
+  std::lock_guard<std::mutex> lock(statusMutex_);
+
+  statusProbes_.swap(probes);
 }
 
-void OpenTestPoint::ControllerImpl::add(Probe * pProbe,
-                                        const std::string & sConfiguration)
+void OpenTestPoint::ControllerImpl::publishSelf(void * pXPubSocket,
+                                                SelfMonitor & selfMonitor)
 {
-  probeInfo_.push_back(std::make_tuple(pProbe,sConfiguration));
+  SelfMonitor::Status status{};
 
-  logService_.add(pProbe->getLogControlEndpoint(),
-                  pProbe->getLogPublishEndpoint());
+  std::unique_lock<std::mutex> lock(statusMutex_);
+
+  for(auto pProbe : statusProbes_)
+    {
+      status.emplace_back("Probe " + std::to_string(pProbe->getProbeIndex()),
+                          pProbe->getStatus());
+    }
+
+  lock.unlock();
+
+  const std::string & sSerialization{selfMonitor.report(sNodeId_,status)};
+
+  const std::string & sTopic{selfMonitor.getName()};
+
+  if(zmq_send(pXPubSocket,sTopic.c_str(),sTopic.size(),ZMQ_SNDMORE | ZMQ_DONTWAIT) < 0 ||
+     zmq_send(pXPubSocket,sSerialization.c_str(),sSerialization.size(),ZMQ_DONTWAIT) < 0)
+    {
+      selfMonitor.dropped(SelfMonitor::Direction::PUBLISH);
+    }
 }
 
 void OpenTestPoint::ControllerImpl::process(const std::string & sServiceEndpoint,
@@ -190,6 +734,12 @@ void OpenTestPoint::ControllerImpl::process(const std::string & sServiceEndpoint
   using ProbeSet = std::set<std::string>;
   ProbeSet probeSet;
 
+  // probe publish endpoints, shared by probes in the same host process
+  std::set<std::string> publishEndpoints;
+
+  // subscription prefixes seen on the xpub socket
+  std::map<std::string,std::size_t> subscriptions;
+
   Toolkit::Log::ClientBuilder logClientBuilder{};
 
   std::unique_ptr<Toolkit::Log::Client> pLogClient{logClientBuilder.buildClient("testpoint-broker/controller/processor")};
@@ -261,6 +811,58 @@ void OpenTestPoint::ControllerImpl::process(const std::string & sServiceEndpoint
               zmq_strerror(errno)};
         }
 
+      // built-in probe host health published by the supervisor
+      if(zmq_connect(pXSubSocket.get(),ProbeSupervisor::HealthEndpoint) < 0)
+        {
+          throw Toolkit::Exception{"unable to connect xsub health endpoint: %s ",
+              zmq_strerror(errno)};
+        }
+
+      for(const auto & sTopic : pSupervisor_->getTopics())
+        {
+          probeSet.insert(sTopic);
+        }
+
+      SelfMonitor selfMonitor{"controller." + sNodeId_,uuid_};
+
+      TraceHop traceHop{"controller@" + sPublishEndpoint};
+
+      probeSet.insert(selfMonitor.getName());
+
+      Toolkit::RAIIZMQSocket pRewireSocket{zmq_socket(pContext_.get(),ZMQ_PULL)};
+
+      if(!pRewireSocket)
+        {
+          throw Toolkit::Exception{"unable to create new rewire socket: %s ",
+              zmq_strerror(errno)};
+        }
+
+      if(zmq_bind(pRewireSocket.get(),ProbeSupervisor::RewireEndpoint) < 0)
+        {
+          throw Toolkit::Exception{"unable to bind rewire endpoint:  %s ",
+              zmq_strerror(errno)};
+        }
+
+      Toolkit::RAIIZMQSocket pWorkerSocket{zmq_socket(pContext_.get(),ZMQ_PAIR)};
+
+      if(!pWorkerSocket)
+        {
+          throw Toolkit::Exception{"unable to create new worker socket: %s ",
+              zmq_strerror(errno)};
+        }
+
+      if(zmq_connect(pWorkerSocket.get(),"inproc://controller-worker") < 0)
+        {
+          throw Toolkit::Exception{"unable to connect to worker endpoint:  %s ",
+              zmq_strerror(errno)};
+        }
+
+      // a discovery request handed to the worker, the discovery
+      // socket cannot receive until its response is sent
+      bool bDiscoveryPending{};
+
+      auto discoveryStart = SelfMonitor::Clock::now();
+
       bool bRun{true};
 
       while(bRun)
@@ -268,12 +870,16 @@ void OpenTestPoint::ControllerImpl::process(const std::string & sServiceEndpoint
           std::vector<zmq_pollitem_t> items =
             {
               {pInternalSocket.get(),0,ZMQ_POLLIN,0},
-              {pDiscoverySocket.get(),0,ZMQ_POLLIN,0},
+              {pDiscoverySocket.get(),0,static_cast<short>(bDiscoveryPending ? 0 : ZMQ_POLLIN),0},
               {pXPubSocket.get(),0,ZMQ_POLLIN,0},
               {pXSubSocket.get(),0,ZMQ_POLLIN,0},
+              {pRewireSocket.get(),0,ZMQ_POLLIN,0},
+              {pWorkerSocket.get(),0,ZMQ_POLLIN,0},
             };
 
-          int rc = zmq_poll(&items[0], items.size(), -1);
+          int rc = zmq_poll(&items[0], items.size(), selfMonitor.timeout());
+
+          selfMonitor.iteration();
 
           if(rc == -1)
             {
@@ -341,7 +947,8 @@ void OpenTestPoint::ControllerImpl::process(const std::string & sServiceEndpoint
 
                                 std::string sPublishEndpoint{add.publish()};
 
-                                if(zmq_connect(pXSubSocket.get(),sPublishEndpoint.c_str()) < 0)
+                                if(publishEndpoints.insert(sPublishEndpoint).second &&
+                                   zmq_connect(pXSubSocket.get(),sPublishEndpoint.c_str()) < 0)
                                   {
                                     throw Toolkit::Exception{"unable to connect xsub endpoint %s: %s ",
                                         sPublishEndpoint.c_str(),
@@ -352,16 +959,113 @@ void OpenTestPoint::ControllerImpl::process(const std::string & sServiceEndpoint
                                   {
                                     probeSet.insert(add.topics(i));
                                   }
+
+                                updateInterest(subscriptions);
+                              }
+                            else
+                              {
+                                throw Toolkit::Exception{"malformed controller command"};
+                              }
+                          }
+                          break;
+
+                        case OpenTestPoint::ControllerCommand::TYPE_REMOVE:
+                          {
+                            // remove reconfigured probes from discovery
+                            if(command.has_remove())
+                              {
+                                const auto & remove = command.remove();
+
+                                if(remove.has_publish() &&
+                                   publishEndpoints.erase(remove.publish()))
+                                  {
+                                    zmq_disconnect(pXSubSocket.get(),remove.publish().c_str());
+                                  }
+
+                                for(int i = 0; i < remove.topics_size(); ++i)
+                                  {
+                                    probeSet.erase(remove.topics(i));
+                                  }
                               }
                             else
                               {
                                 throw Toolkit::Exception{"malformed controller command"};
                               }
                           }
+                          break;
+
+                        default:
+                          // rewire commands arrive on the rewire socket
+                          throw Toolkit::Exception{"unexpected controller command"};
                         }
                     }
+                  else if(item.socket == pRewireSocket.get())
+                    {
+                      // a restarted probe host has a new publish endpoint
+                      zmq_msg_t message;
+
+                      zmq_msg_init(&message);
+
+                      zmq_msg_recv(&message,pRewireSocket.get(), 0);
+
+                      OpenTestPoint::ControllerCommand command;
+
+                      if(!command.ParseFromArray(zmq_msg_data(&message),
+                                                 zmq_msg_size(&message)) ||
+                         !command.has_rewire())
+                        {
+                          zmq_msg_close(&message);
+
+                          throw Toolkit::Exception{"unable to deserialize rewire command"};
+                        }
+
+                      zmq_msg_close(&message);
+
+                      const auto & rewire = command.rewire();
+
+                      if(!rewire.previous().empty() &&
+                         publishEndpoints.erase(rewire.previous()))
+                        {
+                          zmq_disconnect(pXSubSocket.get(),rewire.previous().c_str());
+                        }
+
+                      // subscriptions are replayed to the new connection
+                      if(publishEndpoints.insert(rewire.publish()).second &&
+                         zmq_connect(pXSubSocket.get(),rewire.publish().c_str()) < 0)
+                        {
+                          pLogClient->log(OpenTestPoint::Toolkit::Log::Level::ERROR_LEVEL,
+                                          "unable to connect xsub endpoint %s: %s",
+                                          rewire.publish().c_str(),
+                                          zmq_strerror(errno));
+                        }
+
+                      for(int i = 0; i < rewire.topics_size(); ++i)
+                        {
+                          probeSet.insert(rewire.topics(i));
+                        }
+                    }
+                  else if(item.socket == pWorkerSocket.get())
+                    {
+                      // a discovery response from the worker
+                      zmq_msg_t message;
+
+                      zmq_msg_init(&message);
+
+                      if(zmq_msg_recv(&message,pWorkerSocket.get(),0) >= 0)
+                        {
+                          zmq_msg_send(&message,pDiscoverySocket.get(),0);
+                        }
+
+                      zmq_msg_close(&message);
+
+                      bDiscoveryPending = false;
+
+                      selfMonitor.discovery(SelfMonitor::Clock::now() - discoveryStart);
+                    }
                   else if(item.socket == pDiscoverySocket.get())
                     {
+                      discoveryStart = SelfMonitor::Clock::now();
+
                       // external interface handling probe discovery
                       zmq_msg_t message;
 
@@ -414,6 +1118,63 @@ void OpenTestPoint::ControllerImpl::process(const std::string & sServiceEndpoint
                               }
                               break;
 
+                            case OpenTestPoint::DiscoveryRequest::TYPE_SET_RATE:
+                              {
+                                if(!request.has_setrate() ||
+                                   !request.setrate().rate() ||
+                                   request.setrate().rate() > std::numeric_limits<std::uint16_t>::max())
+                                  {
+                                    Toolkit::sendFailureResponse<OpenTestPoint::DiscoveryResponse>(pDiscoverySocket.get(),
+                                                                                                   "malformed set rate request");
+                                    break;
+                                  }
+
+                                // the rate change is a probe transaction,
+                                // the worker runs it and posts the response
+                                std::string sName{request.setrate().name()};
+
+                                std::chrono::seconds rate{request.setrate().rate()};
+
+                                post([this,sName,rate]()
+                                     {
+                                       void * pSocket{pWorkerSocket_.get()};
+
+                                       try
+                                         {
+                                           auto names = setRate(sName,rate);
+
+                                           OpenTestPoint::DiscoveryResponse response;
+
+                                           response.set_type(OpenTestPoint::DiscoveryResponse::TYPE_SET_RATE);
+
+                                           auto pSetRate = response.mutable_setrate();
+
+                                           for(const auto & sTopic : names)
+                                             {
+                                               pSetRate->add_names(sTopic);
+                                             }
+
+                                           std::string sSerialization;
+
+                                           if(!response.SerializeToString(&sSerialization))
+                                             {
+                                               throw Toolkit::Exception{"unable to serialize probe message"};
+                                             }
+
+                                           zmq_send(pSocket,sSerialization.c_str(),sSerialization.length(),0);
+                                         }
+                                       catch(Toolkit::Exception & exp)
+                                         {
+                                           Toolkit::sendFailureResponse<OpenTestPoint::DiscoveryResponse>(pSocket,
+                                                                                                          "%s",
+                                                                                                          exp.what());
+                                         }
+                                     });
+
+                                bDiscoveryPending = true;
+                              }
+                              break;
+
                             default:
                               pLogClient->log(OpenTestPoint::Toolkit::Log::Level::ERROR_LEVEL,"unknown discovery request");
 
@@ -425,9 +1186,21 @@ void OpenTestPoint::ControllerImpl::process(const std::string & sServiceEndpoint
 
                       zmq_msg_close(&message);
 
+                      if(!bDiscoveryPending)
+                        {
+                          selfMonitor.discovery(SelfMonitor::Clock::now() - discoveryStart);
+                        }
                     }
                   else if(item.socket == pXPubSocket.get())
                     {
+                      bool bFirst{true};
+
+                      bool bChanged{};
+
+                      bool bDropped{};
+
+                      std::size_t bytes{};
+
                       while(1)
                         {
                           zmq_msg_t message;
@@ -442,7 +1215,41 @@ void OpenTestPoint::ControllerImpl::process(const std::string & sServiceEndpoint
 
                           zmq_getsockopt(pXPubSocket.get(),ZMQ_RCVMORE,&iMore,&sizeMore);
 
-                          zmq_msg_send(&message,pXSubSocket.get(),iMore ? ZMQ_SNDMORE : 0);
+                          // subscription frames are a 1 (subscribe) or
+                          // 0 (unsubscribe) byte followed by the prefix
+                          if(bFirst && zmq_msg_size(&message) >= 1)
+                            {
+                              const char * pData{static_cast<const char *>(zmq_msg_data(&message))};
+
+                              std::string sPrefix{pData + 1,zmq_msg_size(&message) - 1};
+
+                              if(pData[0] == 1)
+                                {
+                                  ++subscriptions[sPrefix];
+
+                                  bChanged = true;
+                                }
+                              else if(pData[0] == 0)
+                                {
+                                  auto iter = subscriptions.find(sPrefix);
+
+                                  if(iter != subscriptions.end() && !--iter->second)
+                                    {
+                                      subscriptions.erase(iter);
+                                    }
+
+                                  bChanged = true;
+                                }
+                            }
+
+                          bFirst = false;
+
+                          bytes += zmq_msg_size(&message);
+
+                          if(zmq_msg_send(&message,pXSubSocket.get(),iMore ? ZMQ_SNDMORE : 0) < 0)
+                            {
+                              bDropped = true;
+                            }
 
                           zmq_msg_close(&message);
 
@@ -451,11 +1258,31 @@ void OpenTestPoint::ControllerImpl::process(const std::string & sServiceEndpoint
                               break;
                             }
                         }
+
+                      if(bDropped)
+                        {
+                          selfMonitor.dropped(SelfMonitor::Direction::SUBSCRIBE);
+                        }
+                      else
+                        {
+                          selfMonitor.forwarded(SelfMonitor::Direction::SUBSCRIBE,bytes);
+                        }
+
+                      if(bChanged)
+                        {
+                          updateInterest(subscriptions);
+                        }
                     }
                   else if(item.socket == pXSubSocket.get())
                     {
                       // send multiple part message to XPUB socket for forwarding to any
                       // subscribers
+                      bool bDropped{};
+
+                      std::size_t bytes{};
+
+                      std::size_t parts{};
+
                       while(1)
                         {
                           zmq_msg_t message;
@@ -470,7 +1297,18 @@ void OpenTestPoint::ControllerImpl::process(const std::string & sServiceEndpoint
 
                           zmq_getsockopt(pXSubSocket.get(),ZMQ_RCVMORE,&iMore,&sizeMore);
 
-                          zmq_msg_send(&message,pXPubSocket.get(),iMore ? ZMQ_SNDMORE : 0);
+                          // topic followed by the probe report
+                          if(parts++ && !iMore)
+                            {
+                              traceHop.stamp(message);
+                            }
+
+                          bytes += zmq_msg_size(&message);
+
+                          if(zmq_msg_send(&message,pXPubSocket.get(),iMore ? ZMQ_SNDMORE : 0) < 0)
+                            {
+                              bDropped = true;
+                            }
 
                           zmq_msg_close(&message);
 
@@ -479,9 +1317,23 @@ void OpenTestPoint::ControllerImpl::process(const std::string & sServiceEndpoint
                               break;
                             }
                         }
+
+                      if(bDropped)
+                        {
+                          selfMonitor.dropped(SelfMonitor::Direction::PUBLISH);
+                        }
+                      else
+                        {
+                          selfMonitor.forwarded(SelfMonitor::Direction::PUBLISH,bytes);
+                        }
                     }
                 }
             }
+
+          if(selfMonitor.due())
+            {
+              publishSelf(pXPubSocket.get(),selfMonitor);
+            }
         }
     }
   catch(std::exception & exp)
@@ -39,22 +39,36 @@
 #include "otestpoint/toolkit/log/service.h"
 #include "otestpoint/toolkit/log/client.h"
 #include "otestpoint/toolkit/raiizmq.h"
+#include "probesupervisor.h"
+#include "selfmonitor.h"
+#include "tracehop.h"
 
 #include <string>
 #include <list>
+#include <set>
+#include <map>
+#include <vector>
 #include <thread>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <uuid.h>
 
 namespace OpenTestPoint
 {
-  class Probe;
+  class ControllerCommand;
 
   class ControllerImpl : public Controller
   {
   public:
-    ControllerImpl(Toolkit::Log::Service & logService,
+    ControllerImpl(const std::string & sNodeId,
+                   Toolkit::Log::Service & logService,
                    Toolkit::Log::Client & logClient,
                    const std::string & sServiceEndpoint,
-                   const std::string & sPublishEndpoint);
+                   const std::string & sPublishEndpoint,
+                   const uuid_t & uuid);
 
     ~ControllerImpl();
 
@@ -66,19 +80,118 @@ namespace OpenTestPoint
 
     void destroy() override;
 
-    void add(Probe * pProbe, const std::string & sConfiguration);
+    void add(ProbeContainer * pProbe,
+             const std::string & sConfiguration,
+             const std::string & sKey = {});
+
+    // keeps one running probe per key, applying its rate, and
+    // destroys the others, returns the indices of keys without a
+    // running probe
+    std::vector<std::size_t> retain(const std::vector<std::string> & keys,
+                                    const std::vector<std::chrono::seconds> & rates);
+
+    // initializes, and starts if running, probes added since the
+    // last retain()
+    void commit();
+
+    // changes the rate of the probe publishing sName, returns the
+    // names published by that probe
+    ProbeNames setRate(const std::string & sName,
+                       const std::chrono::seconds & probeRate);
 
   private:
-    using ProbeInfo = std::list<std::tuple<Probe *,std::string>>;
+    struct ProbeEntry
+    {
+      ProbeContainer * pProbe_;
+      std::string sConfiguration_;
+      // identifies an unchanged probe across reconfiguration
+      std::string sKey_;
+      ProbeNames topics_;
+      bool bInitialized_;
+    };
+
+    using ProbeInfo = std::list<ProbeEntry>;
+    std::string sNodeId_;
     Toolkit::RAIIZMQContext pContext_;
     Toolkit::RAIIZMQSocket pInternalSocket_;
     Toolkit::Log::Service & logService_;
     Toolkit::Log::Client & logClient_;
     ProbeInfo probeInfo_;
+    // probes are changed by reconfiguration and rate requests
+    std::mutex probeMutex_;
+    // containers reported in the self table, kept apart from the
+    // probe mutex which lifecycle requests hold while waiting on
+    // the forwarding thread
+    std::mutex statusMutex_;
+    std::vector<ProbeContainer *> statusProbes_;
+    std::mutex logMutex_;
+    std::set<std::string> logEndpoints_;
+    std::unique_ptr<ProbeSupervisor> pSupervisor_;
     std::thread thread_;
+    bool bRunning_;
+    uuid_t uuid_;
+
+    // requests that wait on probe transactions run on the worker
+    // thread, never on the forwarding thread. Discovery responses
+    // are posted back over the worker socket.
+    Toolkit::RAIIZMQSocket pWorkerSocket_;
+    std::thread workerThread_;
+    std::mutex workerMutex_;
+    std::condition_variable workerCondition_;
+    std::deque<std::function<void ()>> tasks_;
+    bool bWorkerRun_;
+    // latest subscriptions, only one interest update is queued
+    std::map<std::string,std::size_t> interestSubscriptions_;
+    bool bInterestPending_;
+
+    // registers a probe host log client once, may be called from
+    // the supervisor thread
+    void addLogEndpoints(const std::string & sControlEndpoint,
+                         const std::string & sPublishEndpoint);
+
+    // unregisters the log client of an exited or replaced host
+    void removeLogEndpoints(const std::string & sControlEndpoint,
+                            const std::string & sPublishEndpoint);
 
     void process(const std::string & sServiceEndpoint,
                  const std::string & sPublishEndpoint);
+
+    // queues a task for the worker thread
+    void post(std::function<void ()> task);
+
+    void work();
+
+    // publishes the self monitor report with probe container status
+    void publishSelf(void * pXPubSocket, SelfMonitor & selfMonitor);
+
+    // initializes probes concurrently
+    void initialize(const std::vector<ProbeEntry *> & entries);
+
+    // adds an initialized probe to discovery and the proxy
+    void advertise(const ProbeEntry & entry);
+
+    // removes destroyed probes from discovery and the proxy
+    void withdraw(const std::vector<ProbeEntry> & entries);
+
+    // copies the containers of probeInfo_ to the self table status,
+    // called with the probe mutex held before a container is deleted
+    void updateStatusProbes();
+
+    void send(const ControllerCommand & command);
+
+    // tells on demand probes whether one of their names matches a
+    // subscription prefix, runs on the worker thread
+    void interest(const std::map<std::string,std::size_t> & subscriptions);
+
+    // queues an interest update without waiting, called from the
+    // forwarding thread
+    void updateInterest(const std::map<std::string,std::size_t> & subscriptions);
+
+    // runs fn for every probe concurrently and waits for completion
+    void parallel(std::function<void (Probe *)> fn);
+
+    void parallel(const std::vector<ProbeContainer *> & probes,
+                  std::function<void (Probe *)> fn);
   };
 }
 
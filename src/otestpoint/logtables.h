@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2026 - Adjacent Link LLC, Bridgewater, New Jersey
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  * Neither the name of Adjacent Link LLC nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * See toplevel COPYING for more information.
+ */
+#ifndef OPENTESTPOINT_LOGTABLES_HEADER_
+#define OPENTESTPOINT_LOGTABLES_HEADER_
+
+#include "otestpoint/toolkit/log/statistics.h"
+#include "measurementtable.pb.h"
+
+#include <cstdint>
+
+// Log counter tables built by libotestpoint and by the probe host,
+// which does not link libotestpoint. Not installed.
+
+namespace OpenTestPoint
+{
+  namespace LogTables
+  {
+    inline void addUInteger(MeasurementTable::Row * pRow, std::uint64_t u64Value)
+    {
+      auto pValue = pRow->add_values();
+      pValue->set_type(MeasurementTable::Measurement::TYPE_UINTEGER);
+      pValue->set_uvalue(u64Value);
+    }
+
+    /**
+     * Fills a table with one row of counters per log client of the
+     * calling process.
+     *
+     * @param table Empty table to fill.
+     */
+    inline void clients(MeasurementTable & table)
+    {
+      for(const auto & sLabel : {"Label","Emitted","Filtered","Dropped","Bytes"})
+        {
+          table.add_labels(sLabel);
+        }
+
+      for(const auto & statistics : Toolkit::Log::getClientStatistics())
+        {
+          auto pRow = table.add_rows();
+
+          auto pValue = pRow->add_values();
+          pValue->set_type(MeasurementTable::Measurement::TYPE_STRING);
+          pValue->set_svalue(statistics.sLabel);
+
+          addUInteger(pRow,statistics.u64Emitted);
+          addUInteger(pRow,statistics.u64Filtered);
+          addUInteger(pRow,statistics.u64Dropped);
+          addUInteger(pRow,statistics.u64Bytes);
+        }
+    }
+
+    /**
+     * Fills a table with a single row of log service counters.
+     *
+     * @param table Empty table to fill.
+     * @param statistics Log service counters.
+     */
+    inline void service(MeasurementTable & table,
+                        const Toolkit::Log::ServiceStatistics & statistics)
+    {
+      for(const auto & sLabel : {"Received","Written","Lost","Writes","Write Mean(us)","Write Max(us)"})
+        {
+          table.add_labels(sLabel);
+        }
+
+      auto pRow = table.add_rows();
+
+      addUInteger(pRow,statistics.u64Received);
+      addUInteger(pRow,statistics.u64Written);
+      addUInteger(pRow,statistics.u64Lost);
+      addUInteger(pRow,statistics.u64Writes);
+      addUInteger(pRow,statistics.u64Writes ? statistics.u64WriteTotalUsec / statistics.u64Writes : 0);
+      addUInteger(pRow,statistics.u64WriteMaxUsec);
+    }
+  }
+}
+
+#endif // OPENTESTPOINT_LOGTABLES_HEADER_
@@ -0,0 +1,706 @@
+/*
+ * Copyright (c) 2026 - Adjacent Link LLC, Bridgewater, New Jersey
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  * Neither the name of Adjacent Link LLC nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * See toplevel COPYING for more information.
+ */
+
+// Measures the probe to subscriber pipeline: a synthetic plugin probe
+// hosted by otestpoint-probe publishes through an in-process
+// controller and broker to subscriber threads. Reports subscriber
+// throughput, per hop latency percentiles taken from probe report
+// trace stamps, cpu use per component and drops as JSON on
+// stdout. Run with otestpoint-probe on the PATH.
+
+#include "otestpoint/probebuilder.h"
+#include "otestpoint/brokerbuilder.h"
+#include "otestpoint/toolkit/servicesingleton.h"
+#include "otestpoint/toolkit/log/servicebuilder.h"
+#include "otestpoint/toolkit/log/clientbuilder.h"
+#include "probereport.pb.h"
+
+#include <zmq.h>
+#include <uuid.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <dirent.h>
+#include <getopt.h>
+#include <unistd.h>
+
+namespace
+{
+  struct Settings
+  {
+    std::size_t payload{256};
+    std::size_t topics{10};
+    std::size_t count{100};
+    std::uint16_t rate{1};
+    std::uint32_t duration{10};
+    std::uint32_t warmup{5};
+    std::size_t subscribers{2};
+    std::uint16_t port{18900};
+    std::string sLibrary{};
+  };
+
+  enum class Phase
+  {
+    WARMUP,
+    MEASURE,
+    STOP,
+  };
+
+  std::uint64_t epochMicroseconds()
+  {
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+  }
+
+  // latency samples in microseconds by stage
+  using Latencies = std::map<std::string,std::vector<std::int64_t>>;
+
+  struct Subscriber
+  {
+    std::thread thread;
+    std::uint64_t u64Messages{};
+    std::uint64_t u64Bytes{};
+    std::uint64_t u64Drops{};
+    Latencies latencies{};
+  };
+
+  void subscribe(void * pContext,
+                 const std::string & sEndpoint,
+                 const std::atomic<Phase> & phase,
+                 Subscriber & subscriber)
+  {
+    void * pSocket{zmq_socket(pContext,ZMQ_SUB)};
+
+    zmq_connect(pSocket,sEndpoint.c_str());
+
+    zmq_setsockopt(pSocket,ZMQ_SUBSCRIBE,"Bench.Pipeline.",15);
+
+    // last sequence number seen by topic
+    std::map<std::string,std::uint64_t> sequences{};
+
+    OpenTestPoint::ProbeReport report{};
+
+    zmq_msg_t topic;
+    zmq_msg_t message;
+
+    zmq_msg_init(&topic);
+    zmq_msg_init(&message);
+
+    while(phase != Phase::STOP)
+      {
+        zmq_pollitem_t item{pSocket,0,ZMQ_POLLIN,0};
+
+        if(zmq_poll(&item,1,100) <= 0)
+          {
+            continue;
+          }
+
+        if(zmq_msg_recv(&topic,pSocket,0) < 0 ||
+           zmq_msg_recv(&message,pSocket,0) < 0)
+          {
+            continue;
+          }
+
+        std::int64_t i64Received = epochMicroseconds();
+
+        if(!report.ParseFromArray(zmq_msg_data(&message),zmq_msg_size(&message)) ||
+           report.data().blob().size() < sizeof(std::uint64_t))
+          {
+            continue;
+          }
+
+        std::uint64_t u64Sequence{};
+
+        std::memcpy(&u64Sequence,report.data().blob().data(),sizeof(u64Sequence));
+
+        std::string sTopic{static_cast<const char *>(zmq_msg_data(&topic)),zmq_msg_size(&topic)};
+
+        auto iter = sequences.find(sTopic);
+
+        bool bMeasure{phase == Phase::MEASURE};
+
+        if(iter == sequences.end())
+          {
+            sequences.insert(std::make_pair(sTopic,u64Sequence));
+          }
+        else
+          {
+            if(bMeasure && u64Sequence > iter->second + 1)
+              {
+                subscriber.u64Drops += u64Sequence - iter->second - 1;
+              }
+
+            iter->second = u64Sequence;
+          }
+
+        if(!bMeasure)
+          {
+            continue;
+          }
+
+        ++subscriber.u64Messages;
+
+        subscriber.u64Bytes += zmq_msg_size(&topic) + zmq_msg_size(&message);
+
+        const auto & trace = report.trace();
+
+        std::int64_t i64Previous = trace.publish();
+
+        for(const auto & hop : trace.hops())
+          {
+            // hop names are <component>@<publish endpoint>
+            subscriber.latencies[hop.name().substr(0,hop.name().find('@'))].push_back(hop.timestamp() - i64Previous);
+
+            i64Previous = hop.timestamp();
+          }
+
+        subscriber.latencies["subscriber"].push_back(i64Received - i64Previous);
+
+        subscriber.latencies["total"].push_back(i64Received - trace.publish());
+      }
+
+    zmq_msg_close(&topic);
+    zmq_msg_close(&message);
+
+    zmq_close(pSocket);
+  }
+
+  std::set<std::string> tasks()
+  {
+    std::set<std::string> ids{};
+
+    if(DIR * pDir = opendir("/proc/self/task"))
+      {
+        while(dirent * pEntry = readdir(pDir))
+          {
+            if(pEntry->d_name[0] != '.')
+              {
+                ids.insert(pEntry->d_name);
+              }
+          }
+
+        closedir(pDir);
+      }
+
+    return ids;
+  }
+
+  // user and system time of a /proc stat file in seconds, fields 14
+  // and 15 counting from the pid
+  double cpuSeconds(const std::string & sStatPath)
+  {
+    std::ifstream stream{sStatPath};
+
+    std::string sStat{};
+
+    std::getline(stream,sStat);
+
+    auto pos = sStat.rfind(')');
+
+    if(pos == std::string::npos)
+      {
+        return 0;
+      }
+
+    std::istringstream fields{sStat.substr(pos + 2)};
+
+    std::string sField{};
+
+    unsigned long long ullUser{};
+    unsigned long long ullSystem{};
+
+    // state is field 3
+    for(int i = 3; i < 14 && fields>>sField; ++i);
+
+    fields>>ullUser>>ullSystem;
+
+    return static_cast<double>(ullUser + ullSystem) / sysconf(_SC_CLK_TCK);
+  }
+
+  double cpuSeconds(const std::set<std::string> & ids)
+  {
+    double dSeconds{};
+
+    for(const auto & sId : ids)
+      {
+        dSeconds += cpuSeconds("/proc/self/task/" + sId + "/stat");
+      }
+
+    return dSeconds;
+  }
+
+  // probe host processes are the children of this process
+  std::set<std::string> children()
+  {
+    std::set<std::string> ids{};
+
+    std::string sParent{std::to_string(getpid())};
+
+    if(DIR * pDir = opendir("/proc"))
+      {
+        while(dirent * pEntry = readdir(pDir))
+          {
+            if(pEntry->d_name[0] < '0' || pEntry->d_name[0] > '9')
+              {
+                continue;
+              }
+
+            std::ifstream stream{std::string{"/proc/"} + pEntry->d_name + "/stat"};
+
+            std::string sStat{};
+
+            std::getline(stream,sStat);
+
+            auto pos = sStat.rfind(')');
+
+            if(pos == std::string::npos)
+              {
+                continue;
+              }
+
+            std::istringstream fields{sStat.substr(pos + 2)};
+
+            std::string sState{};
+            std::string sPPid{};
+
+            fields>>sState>>sPPid;
+
+            if(sPPid == sParent)
+              {
+                ids.insert(pEntry->d_name);
+              }
+          }
+
+        closedir(pDir);
+      }
+
+    return ids;
+  }
+
+  double processCPUSeconds(const std::set<std::string> & ids)
+  {
+    double dSeconds{};
+
+    for(const auto & sId : ids)
+      {
+        dSeconds += cpuSeconds("/proc/" + sId + "/stat");
+      }
+
+    return dSeconds;
+  }
+
+  std::set<std::string> difference(const std::set<std::string> & after,
+                                   const std::set<std::string> & before)
+  {
+    std::set<std::string> ids{};
+
+    std::set_difference(after.begin(),after.end(),
+                        before.begin(),before.end(),
+                        std::inserter(ids,ids.end()));
+    return ids;
+  }
+
+  std::int64_t percentile(const std::vector<std::int64_t> & samples, double dFraction)
+  {
+    std::size_t rank = static_cast<std::size_t>(dFraction * samples.size() + 0.999999);
+
+    return samples[rank ? rank - 1 : 0];
+  }
+
+  void usage(const char * pzName)
+  {
+    std::fprintf(stderr,
+                 "usage: %s --library PATH [--payload BYTES] [--topics N] [--count N]\n"
+                 "        [--rate SECONDS] [--duration SECONDS] [--warmup SECONDS]\n"
+                 "        [--subscribers N] [--port BASE]\n",
+                 pzName);
+  }
+}
+
+int main(int argc, char * argv[])
+{
+  Settings settings{};
+
+  option options[] =
+    {
+      {"library",1,nullptr,'l'},
+      {"payload",1,nullptr,'p'},
+      {"topics",1,nullptr,'t'},
+      {"count",1,nullptr,'c'},
+      {"rate",1,nullptr,'r'},
+      {"duration",1,nullptr,'d'},
+      {"warmup",1,nullptr,'w'},
+      {"subscribers",1,nullptr,'s'},
+      {"port",1,nullptr,'o'},
+      {0,0,nullptr,0},
+    };
+
+  int iOption{};
+  int iOptionIndex{};
+
+  while((iOption = getopt_long(argc,argv,"l:p:t:c:r:d:w:s:o:",options,&iOptionIndex)) != -1)
+    {
+      switch(iOption)
+        {
+        case 'l':
+          settings.sLibrary = optarg;
+          break;
+        case 'p':
+          settings.payload = std::strtoul(optarg,nullptr,10);
+          break;
+        case 't':
+          settings.topics = std::strtoul(optarg,nullptr,10);
+          break;
+        case 'c':
+          settings.count = std::strtoul(optarg,nullptr,10);
+          break;
+        case 'r':
+          settings.rate = std::strtoul(optarg,nullptr,10);
+          break;
+        case 'd':
+          settings.duration = std::strtoul(optarg,nullptr,10);
+          break;
+        case 'w':
+          settings.warmup = std::strtoul(optarg,nullptr,10);
+          break;
+        case 's':
+          settings.subscribers = std::strtoul(optarg,nullptr,10);
+          break;
+        case 'o':
+          settings.port = std::strtoul(optarg,nullptr,10);
+          break;
+        default:
+          usage(argv[0]);
+          return EXIT_FAILURE;
+        }
+    }
+
+  if(settings.sLibrary.empty() ||
+     settings.payload < sizeof(std::uint64_t) ||
+     !settings.topics ||
+     !settings.count ||
+     !settings.rate ||
+     !settings.duration ||
+     !settings.subscribers)
+    {
+      usage(argv[0]);
+      return EXIT_FAILURE;
+    }
+
+  char szConfiguration[] = "/tmp/pipelinebench.XXXXXX";
+
+  int iFd{mkstemp(szConfiguration)};
+
+  if(iFd < 0)
+    {
+      std::perror("mkstemp");
+      return EXIT_FAILURE;
+    }
+
+  std::string sConfiguration{"payload=" + std::to_string(settings.payload) + "\n" +
+      "topics=" + std::to_string(settings.topics) + "\n" +
+      "count=" + std::to_string(settings.count) + "\n"};
+
+  if(write(iFd,sConfiguration.data(),sConfiguration.size()) != static_cast<ssize_t>(sConfiguration.size()))
+    {
+      std::perror("write");
+      return EXIT_FAILURE;
+    }
+
+  close(iFd);
+
+  std::string sBase{"127.0.0.1:"};
+  std::string sControllerDiscovery{sBase + std::to_string(settings.port)};
+  std::string sControllerPublish{sBase + std::to_string(settings.port + 1)};
+  std::string sBrokerDiscovery{sBase + std::to_string(settings.port + 2)};
+  std::string sBrokerPublish{sBase + std::to_string(settings.port + 3)};
+
+  std::unique_ptr<OpenTestPoint::Toolkit::Log::Service> pLogService{};
+
+  std::unique_ptr<OpenTestPoint::Controller> pController{};
+
+  std::unique_ptr<OpenTestPoint::Broker> pBroker{};
+
+  std::atomic<Phase> phase{Phase::WARMUP};
+
+  std::vector<Subscriber> subscribers(settings.subscribers);
+
+  void * pContext{};
+
+  try
+    {
+      pLogService.reset(OpenTestPoint::Toolkit::Log::ServiceBuilder{}.buildService(OpenTestPoint::Toolkit::Log::Level::NOLOG_LEVEL));
+
+      auto pLogClient = OpenTestPoint::Toolkit::Log::ClientBuilder{}.buildClient("pipelinebench");
+
+      // ownership transfer
+      OpenTestPoint::Toolkit::ServiceSingleton::instance()->initialize(pLogClient);
+
+      pLogService->add(pLogClient->getControlEndpoint(),
+                       pLogClient->getPublishEndpoint());
+
+      uuid_t uuid;
+
+      uuid_generate(uuid);
+
+      auto before = tasks();
+
+      OpenTestPoint::ProbeBuilder probeBuilder{uuid};
+
+      probeBuilder.buildController("bench",
+                                   *pLogService,
+                                   *pLogClient,
+                                   "tcp://" + sControllerDiscovery,
+                                   "tcp://" + sControllerPublish);
+
+      OpenTestPoint::ProbeOptions probeOptions{};
+
+      probeOptions.trace = true;
+
+      probeBuilder.buildPluginProbe("bench",
+                                    settings.sLibrary,
+                                    std::chrono::seconds{settings.rate},
+                                    std::chrono::seconds{5},
+                                    szConfiguration,
+                                    probeOptions);
+
+      pController.reset(probeBuilder.getController());
+
+      pController->initialize();
+
+      pController->start();
+
+      pController->postStart();
+
+      auto controllerTasks = difference(tasks(),before);
+
+      before = tasks();
+
+      OpenTestPoint::BrokerBuilder brokerBuilder{uuid};
+
+      brokerBuilder.buildBroker(*pLogService,
+                                *pLogClient,
+                                "tcp://" + sBrokerDiscovery,
+                                "tcp://" + sBrokerPublish);
+
+      brokerBuilder.addTestPoint(sControllerDiscovery,sControllerPublish);
+
+      pBroker.reset(brokerBuilder.getBroker());
+
+      pBroker->initialize();
+
+      pBroker->start();
+
+      auto brokerTasks = difference(tasks(),before);
+
+      before = tasks();
+
+      pContext = zmq_ctx_new();
+
+      for(auto & subscriber : subscribers)
+        {
+          subscriber.thread = std::thread{subscribe,
+                                          pContext,
+                                          "tcp://" + sBrokerPublish,
+                                          std::cref(phase),
+                                          std::ref(subscriber)};
+        }
+
+      // subscriptions propagate and the broker discovers the probe
+      std::this_thread::sleep_for(std::chrono::seconds{settings.warmup});
+
+      // includes the subscriber context I/O thread, started with the
+      // first socket
+      auto subscriberTasks = difference(tasks(),before);
+
+      auto probeProcesses = children();
+
+      double dProbeCPU{processCPUSeconds(probeProcesses)};
+      double dControllerCPU{cpuSeconds(controllerTasks)};
+      double dBrokerCPU{cpuSeconds(brokerTasks)};
+      double dSubscriberCPU{cpuSeconds(subscriberTasks)};
+
+      auto begin = std::chrono::steady_clock::now();
+
+      phase = Phase::MEASURE;
+
+      std::this_thread::sleep_for(std::chrono::seconds{settings.duration});
+
+      phase = Phase::WARMUP;
+
+      double dElapsed{std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count()};
+
+      dProbeCPU = processCPUSeconds(probeProcesses) - dProbeCPU;
+      dControllerCPU = cpuSeconds(controllerTasks) - dControllerCPU;
+      dBrokerCPU = cpuSeconds(brokerTasks) - dBrokerCPU;
+      dSubscriberCPU = cpuSeconds(subscriberTasks) - dSubscriberCPU;
+
+      phase = Phase::STOP;
+
+      for(auto & subscriber : subscribers)
+        {
+          subscriber.thread.join();
+        }
+
+      Latencies latencies{};
+
+      std::printf("{\n"
+                  "  \"settings\": {\"payload\": %zu, \"topics\": %zu, \"count\": %zu, "
+                  "\"rate\": %hu, \"duration\": %u, \"subscribers\": %zu},\n"
+                  "  \"published_per_second\": %.1f,\n"
+                  "  \"subscribers\": [",
+                  settings.payload,
+                  settings.topics,
+                  settings.count,
+                  settings.rate,
+                  settings.duration,
+                  settings.subscribers,
+                  static_cast<double>(settings.topics * settings.count) / settings.rate);
+
+      for(std::size_t i = 0; i < subscribers.size(); ++i)
+        {
+          const auto & subscriber = subscribers[i];
+
+          std::printf("%s\n    {\"messages\": %llu, \"bytes\": %llu, \"drops\": %llu, "
+                      "\"messages_per_second\": %.1f, \"megabits_per_second\": %.3f}",
+                      i ? "," : "",
+                      static_cast<unsigned long long>(subscriber.u64Messages),
+                      static_cast<unsigned long long>(subscriber.u64Bytes),
+                      static_cast<unsigned long long>(subscriber.u64Drops),
+                      subscriber.u64Messages / dElapsed,
+                      subscriber.u64Bytes * 8 / dElapsed / 1e6);
+
+          for(const auto & entry : subscriber.latencies)
+            {
+              auto & samples = latencies[entry.first];
+
+              samples.insert(samples.end(),entry.second.begin(),entry.second.end());
+            }
+        }
+
+      std::printf("\n  ],\n  \"latency_usec\": {");
+
+      const char * pzSeparator{""};
+
+      // pipeline order
+      for(const auto & sStage : {"controller","broker","subscriber","total"})
+        {
+          auto iter = latencies.find(sStage);
+
+          if(iter == latencies.end() || iter->second.empty())
+            {
+              continue;
+            }
+
+          auto & samples = iter->second;
+
+          std::sort(samples.begin(),samples.end());
+
+          std::printf("%s\n    \"%s\": {\"count\": %zu, \"p50\": %lld, \"p90\": %lld, "
+                      "\"p99\": %lld, \"p999\": %lld, \"max\": %lld}",
+                      pzSeparator,
+                      sStage,
+                      samples.size(),
+                      static_cast<long long>(percentile(samples,0.5)),
+                      static_cast<long long>(percentile(samples,0.9)),
+                      static_cast<long long>(percentile(samples,0.99)),
+                      static_cast<long long>(percentile(samples,0.999)),
+                      static_cast<long long>(samples.back()));
+
+          pzSeparator = ",";
+        }
+
+      // percent of one cpu over the measurement
+      std::printf("\n  },\n"
+                  "  \"cpu_percent\": {\"probe\": %.1f, \"controller\": %.1f, "
+                  "\"broker\": %.1f, \"subscribers\": %.1f}\n"
+                  "}\n",
+                  dProbeCPU / dElapsed * 100,
+                  dControllerCPU / dElapsed * 100,
+                  dBrokerCPU / dElapsed * 100,
+                  dSubscriberCPU / dElapsed * 100);
+
+      pBroker->stop();
+
+      pBroker->destroy();
+
+      pController->stop();
+
+      pController->destroy();
+    }
+  catch(const std::exception & exp)
+    {
+      std::fprintf(stderr,"%s\n",exp.what());
+
+      phase = Phase::STOP;
+
+      for(auto & subscriber : subscribers)
+        {
+          if(subscriber.thread.joinable())
+            {
+              subscriber.thread.join();
+            }
+        }
+
+      unlink(szConfiguration);
+
+      return EXIT_FAILURE;
+    }
+
+  pBroker.reset();
+
+  pController.reset();
+
+  if(pContext)
+    {
+      zmq_ctx_term(pContext);
+    }
+
+  unlink(szConfiguration);
+
+  OpenTestPoint::Toolkit::ServiceSingleton::instance()->destroy();
+
+  return 0;
+}
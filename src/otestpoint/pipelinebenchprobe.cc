@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) 2026 - Adjacent Link LLC, Bridgewater, New Jersey
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  * Neither the name of Adjacent Link LLC nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * See toplevel COPYING for more information.
+ */
+
+// Synthetic probe plugin for pipelinebench. Publishes count reports
+// of payload bytes on each of topics probe names every probe
+// interval. The first 8 bytes of a payload are a per topic sequence
+// number used by subscribers to count drops. The configuration file
+// holds key=value lines:
+//
+//   payload=256
+//   topics=10
+//   count=100
+
+#include "otestpoint/probeplugin.h"
+#include "otestpoint/toolkit/exception.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace OpenTestPoint
+{
+  class PipelineBenchProbe : public ProbePlugin
+  {
+  public:
+    PipelineBenchProbe(ProbeIndex probeIndex):
+      ProbePlugin{probeIndex},
+      payload_{256},
+      topics_{1},
+      count_{1}{}
+
+    ProbeNames initialize(const std::string & sConfigurationFile) override
+    {
+      std::ifstream stream{sConfigurationFile};
+
+      if(!stream)
+        {
+          throw Toolkit::Exception{"unable to open configuration: %s",
+              sConfigurationFile.c_str()};
+        }
+
+      std::string sLine{};
+
+      while(std::getline(stream,sLine))
+        {
+          auto pos = sLine.find('=');
+
+          if(pos == std::string::npos)
+            {
+              continue;
+            }
+
+          std::string sKey{sLine.substr(0,pos)};
+
+          std::size_t value{std::strtoul(sLine.c_str() + pos + 1,nullptr,10)};
+
+          if(sKey == "payload")
+            {
+              payload_ = value;
+            }
+          else if(sKey == "topics")
+            {
+              topics_ = value;
+            }
+          else if(sKey == "count")
+            {
+              count_ = value;
+            }
+        }
+
+      if(payload_ < sizeof(std::uint64_t) || !topics_ || !count_)
+        {
+          throw Toolkit::Exception{"invalid configuration: %s",
+              sConfigurationFile.c_str()};
+        }
+
+      ProbeNames names{};
+
+      for(std::size_t i = 0; i < topics_; ++i)
+        {
+          names.push_back("Bench.Pipeline." + std::to_string(i));
+        }
+
+      sequences_.assign(topics_,0);
+
+      // entries reference the payloads until the reports are sent
+      payloads_.assign(topics_ * count_,std::string(payload_,'\0'));
+
+      topicNames_.assign(names.begin(),names.end());
+
+      return names;
+    }
+
+    void start() override {}
+
+    void stop() override {}
+
+    void destroy() override {}
+
+    ProbeData probe() override
+    {
+      ProbeDataBuffer buffer{};
+
+      probeInto(buffer);
+
+      ProbeData data{};
+
+      for(const auto & entry : buffer)
+        {
+          data.push_back(std::make_tuple(entry.sTopic,
+                                         std::string{entry.data(),entry.size()},
+                                         entry.sName,
+                                         entry.sModule,
+                                         entry.u32Version));
+        }
+
+      return data;
+    }
+
+    void probeInto(ProbeDataBuffer & buffer) override
+    {
+      for(std::size_t i = 0; i < count_; ++i)
+        {
+          for(std::size_t topic = 0; topic < topics_; ++topic)
+            {
+              auto & sPayload = payloads_[i * topics_ + topic];
+
+              std::uint64_t u64Sequence{sequences_[topic]++};
+
+              std::memcpy(&sPayload[0],&u64Sequence,sizeof(u64Sequence));
+
+              auto & entry = buffer.append();
+
+              entry.sTopic = topicNames_[topic];
+              entry.sName = "PipelineBench";
+              entry.sModule = "pipelinebench";
+              entry.u32Version = 1;
+              entry.pSerialization = sPayload.data();
+              entry.serializationSize = sPayload.size();
+            }
+        }
+    }
+
+  private:
+    std::size_t payload_;
+    std::size_t topics_;
+    std::size_t count_;
+    std::vector<std::uint64_t> sequences_;
+    std::vector<std::string> payloads_;
+    std::vector<std::string> topicNames_;
+  };
+}
+
+DECLARE_PROBEPLUGIN(OpenTestPoint::PipelineBenchProbe)
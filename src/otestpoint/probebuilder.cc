@@ -39,25 +39,171 @@
 #include "controllerimpl.h"
 
 #include <memory>
+#include <map>
+#include <vector>
+#include <sstream>
 #include <uuid.h>
 
 class OpenTestPoint::ProbeBuilder::Impl
 {
 public:
   Impl(const uuid_t & uuid):
-    probeIndex_{}
+    probeIndex_{},
+    pReconfigure_{}
   {
     uuid_copy(uuid_,uuid);
   }
 
+  struct ProbeSpec
+  {
+    std::string sNodeId_;
+    std::string sLibrary_;
+    std::string sModule_;
+    std::string sClass_;
+    std::chrono::seconds probeRate_;
+    std::chrono::seconds commTimeout_;
+    std::string sConfigurationFile_;
+    ProbeOptions options_;
+    std::string sKey_;
+  };
+
   uuid_t uuid_;
   ProbeIndex probeIndex_;
   std::unique_ptr<ControllerImpl> pControllerImpl_;
+  std::map<std::string,std::weak_ptr<ProbeProcess>> groups_;
+  ControllerImpl * pReconfigure_;
+  std::vector<ProbeSpec> specs_;
+
+  // every setting of a probe except its rate, which can be changed
+  // on a running probe
+  static std::string key(const ProbeSpec & spec)
+  {
+    const auto & options = spec.options_;
+
+    std::stringstream ss{};
+
+    ss<<spec.sNodeId_<<'\0'
+      <<spec.sLibrary_<<'\0'
+      <<spec.sModule_<<'\0'
+      <<spec.sClass_<<'\0'
+      <<spec.commTimeout_.count()<<'\0'
+      <<spec.sConfigurationFile_<<'\0'
+      <<static_cast<int>(options.phase)<<'\0'
+      <<options.phaseWindow.count()<<'\0'
+      <<options.group<<'\0'
+      <<options.budget.count()<<'\0';
+
+    for(const auto & cpu : options.affinity)
+      {
+        ss<<cpu<<',';
+      }
+
+    ss<<'\0'
+      <<static_cast<int>(options.scheduler)<<'\0'
+      <<options.nice<<'\0'
+      <<options.priority<<'\0'
+      <<options.cgroup<<'\0'
+      <<options.zygote<<'\0'
+      <<options.onDemand<<'\0'
+      <<options.idleRate.count()<<'\0'
+      <<options.trace;
+
+    return ss.str();
+  }
+
+  ControllerImpl * controller()
+  {
+    if(pReconfigure_)
+      {
+        return pReconfigure_;
+      }
+
+    if(pControllerImpl_)
+      {
+        return pControllerImpl_.get();
+      }
+
+    throw Toolkit::Exception{"Controller not created"};
+  }
+
+  void build(ProbeSpec && spec)
+  {
+    spec.sKey_ = key(spec);
+
+    if(pReconfigure_)
+      {
+        // probes are created once the unchanged probes are known
+        specs_.push_back(std::move(spec));
+      }
+    else
+      {
+        create(spec);
+      }
+  }
+
+  void create(const ProbeSpec & spec)
+  {
+    auto pController = controller();
+
+    if(spec.sLibrary_.empty())
+      {
+        pController->add(new ProbeContainer{process(spec.sNodeId_,spec.options_),
+              spec.sNodeId_,
+              probeIndex_++,
+              spec.sModule_,
+              spec.sClass_,
+              spec.probeRate_,
+              spec.commTimeout_,
+              spec.options_},
+          spec.sConfigurationFile_,
+          spec.sKey_);
+      }
+    else
+      {
+        pController->add(new ProbeContainer{process(spec.sNodeId_,spec.options_),
+              spec.sNodeId_,
+              probeIndex_++,
+              spec.sLibrary_,
+              spec.probeRate_,
+              spec.commTimeout_,
+              spec.options_},
+          spec.sConfigurationFile_,
+          spec.sKey_);
+      }
+  }
+
+  std::shared_ptr<ProbeProcess> process(const std::string & sNodeId,
+                                        const ProbeOptions & options)
+  {
+    if(options.group.empty())
+      {
+        return std::make_shared<ProbeProcess>(uuid_,
+                                              sNodeId,
+                                              std::to_string(probeIndex_),
+                                              options);
+      }
+
+    auto pProcess = groups_[options.group].lock();
+
+    if(!pProcess)
+      {
+        // the first probe in a group configures the process
+        pProcess = std::make_shared<ProbeProcess>(uuid_,
+                                                  sNodeId,
+                                                  options.group,
+                                                  options);
+
+        groups_[options.group] = pProcess;
+      }
+
+    return pProcess;
+  }
 };
 
 OpenTestPoint::ProbeBuilder::ProbeBuilder(const uuid_t & uuid):pImpl_{new Impl{uuid}}{}
 
-void OpenTestPoint::ProbeBuilder::buildController(Toolkit::Log::Service & logService,
+void OpenTestPoint::ProbeBuilder::buildController(const std::string & sNodeId,
+                                                  Toolkit::Log::Service & logService,
                                                   Toolkit::Log::Client & logClient,
                                                   const std::string & sServiceEndpoint,
                                                   const std::string & sPublishEndpoint)
@@ -65,10 +211,12 @@ void OpenTestPoint::ProbeBuilder::buildController(Toolkit::Log::Service & logSer
 {
   if(!pImpl_->pControllerImpl_)
     {
-      pImpl_->pControllerImpl_.reset(new ControllerImpl{logService,
+      pImpl_->pControllerImpl_.reset(new ControllerImpl{sNodeId,
+            logService,
             logClient,
             sServiceEndpoint,
-            sPublishEndpoint});
+            sPublishEndpoint,
+            pImpl_->uuid_});
     }
   else
     {
@@ -82,22 +230,20 @@ OpenTestPoint::ProbeBuilder::buildPluginProbe(const std::string & sNodeId,
                                               const std::string & sLibrary,
                                               const std::chrono::seconds & probeRate,
                                               const std::chrono::seconds & commTimeout,
-                                              const std::string & sConfigurationFile)
+                                              const std::string & sConfigurationFile,
+                                              const ProbeOptions & options)
 {
-  if(pImpl_->pControllerImpl_)
-    {
-      pImpl_->pControllerImpl_->add(new ProbeContainer{pImpl_->uuid_,
-            sNodeId,
-            pImpl_->probeIndex_++,
-            sLibrary,
-            probeRate,
-            commTimeout},
-        sConfigurationFile);
-    }
-  else
-    {
-      throw Toolkit::Exception{"Controller not created"};
-    }
+  pImpl_->controller();
+
+  pImpl_->build(Impl::ProbeSpec{sNodeId,
+        sLibrary,
+        {},
+        {},
+        probeRate,
+        commTimeout,
+        sConfigurationFile,
+        options,
+        {}});
 }
 
 void
@@ -106,18 +252,27 @@ OpenTestPoint::ProbeBuilder::buildPythonProbe(const std::string & sNodeId,
                                               const std::string & sClass,
                                               const std::chrono::seconds & probeRate,
                                               const std::chrono::seconds & commTimeout,
-                                              const std::string & sConfigurationFile)
+                                              const std::string & sConfigurationFile,
+                                              const ProbeOptions & options)
+{
+  pImpl_->controller();
+
+  pImpl_->build(Impl::ProbeSpec{sNodeId,
+        {},
+        sModule,
+        sClass,
+        probeRate,
+        commTimeout,
+        sConfigurationFile,
+        options,
+        {}});
+}
+
+OpenTestPoint::Controller * OpenTestPoint::ProbeBuilder::getController()
 {
   if(pImpl_->pControllerImpl_)
     {
-      pImpl_->pControllerImpl_->add(new ProbeContainer{pImpl_->uuid_,
-            sNodeId,
-            pImpl_->probeIndex_++,
-            sModule,
-            sClass,
-            probeRate,
-            commTimeout},
-        sConfigurationFile);
+      return pImpl_->pControllerImpl_.release();
     }
   else
     {
@@ -125,14 +280,58 @@ OpenTestPoint::ProbeBuilder::buildPythonProbe(const std::string & sNodeId,
     }
 }
 
-OpenTestPoint::Controller * OpenTestPoint::ProbeBuilder::getController()
+void OpenTestPoint::ProbeBuilder::beginReconfiguration(Controller * pController)
 {
-  if(pImpl_->pControllerImpl_)
+  auto pControllerImpl = dynamic_cast<ControllerImpl *>(pController);
+
+  if(!pControllerImpl)
     {
-      return pImpl_->pControllerImpl_.release();
+      throw Toolkit::Exception{"Controller not created by builder"};
     }
-  else
+
+  pImpl_->pReconfigure_ = pControllerImpl;
+
+  pImpl_->specs_.clear();
+}
+
+void OpenTestPoint::ProbeBuilder::endReconfiguration()
+{
+  if(!pImpl_->pReconfigure_)
     {
-      throw Toolkit::Exception{"Controller not created"};
+      throw Toolkit::Exception{"Reconfiguration not started"};
     }
+
+  std::vector<Impl::ProbeSpec> specs{};
+
+  specs.swap(pImpl_->specs_);
+
+  std::vector<std::string> keys{};
+
+  std::vector<std::chrono::seconds> rates{};
+
+  for(const auto & spec : specs)
+    {
+      keys.push_back(spec.sKey_);
+
+      rates.push_back(spec.probeRate_);
+    }
+
+  try
+    {
+      // removed probes release their group host before new probes
+      // are assigned one
+      for(auto index : pImpl_->pReconfigure_->retain(keys,rates))
+        {
+          pImpl_->create(specs[index]);
+        }
+
+      pImpl_->pReconfigure_->commit();
+    }
+  catch(...)
+    {
+      pImpl_->pReconfigure_ = nullptr;
+      throw;
+    }
+
+  pImpl_->pReconfigure_ = nullptr;
 }
@@ -34,47 +34,88 @@
 
 #include "probecontainer.h"
 #include "otestpoint/toolkit/exception.h"
-#include "otestpoint/toolkit/transaction.h"
 #include "otestpoint/toolkit/servicesingleton.h"
 
-#include <memory>
-#include <zmq.h>
-#include <unistd.h>
-#include <cstring>
-#include <sys/wait.h>
-#include <iostream>
-#include <sys/types.h>
-#include <sys/stat.h>
 #include <sstream>
+#include <random>
 
-#include "libotestpoint.pb.h"
+namespace
+{
+  std::chrono::microseconds phaseOffset(const std::string & sNodeId,
+                                        OpenTestPoint::ProbeIndex probeIndex,
+                                        const std::chrono::seconds & probeRate,
+                                        const OpenTestPoint::ProbeOptions & options)
+  {
+    std::chrono::microseconds window{options.phaseWindow};
+
+    if(window.count() == 0 || window > probeRate)
+      {
+        window = probeRate;
+      }
+
+    if(window.count() <= 0)
+      {
+        return {};
+      }
+
+    switch(options.phase)
+      {
+      case OpenTestPoint::ProbeOptions::Phase::DETERMINISTIC:
+        {
+          // FNV-1a over node id and probe index, stable across
+          // runs and platforms so offsets are reproducible
+          std::uint64_t u64Hash{14695981039346656037ULL};
+
+          auto hash = [&u64Hash](std::uint8_t u8Byte)
+            {
+              u64Hash ^= u8Byte;
+              u64Hash *= 1099511628211ULL;
+            };
+
+          for(auto c : sNodeId)
+            {
+              hash(c);
+            }
+
+          hash(probeIndex & 0xFF);
+          hash(probeIndex >> 8);
+
+          return std::chrono::microseconds(u64Hash % window.count());
+        }
 
+      case OpenTestPoint::ProbeOptions::Phase::RANDOM:
+        {
+          std::random_device device{};
+
+          std::uniform_int_distribution<std::int64_t> distribution{0,window.count() - 1};
 
-#ifndef HAVE_SECURE_GETENV
-#  ifdef HAVE___SECURE_GETENV
-#    define secure_getenv __secure_getenv
-#  else
-#    error neither secure_getenv nor __secure_getenv is available
-#  endif
-#endif
+          return std::chrono::microseconds(distribution(device));
+        }
 
+      default:
+        return {};
+      }
+  }
+}
 
-OpenTestPoint::ProbeContainer::ProbeContainer(const uuid_t & uuid,
+
+OpenTestPoint::ProbeContainer::ProbeContainer(std::shared_ptr<ProbeProcess> pProcess,
                                               const std::string & sNodeId,
                                               ProbeIndex probeIndex,
                                               const std::string & sPlugin,
                                               const std::chrono::seconds & probeRate,
-                                              const std::chrono::seconds & commTimeout):
+                                              const std::chrono::seconds & commTimeout,
+                                              const ProbeOptions & options):
   Probe{sNodeId,
     probeIndex},
-  pid_{},
+  pProcess_{pProcess},
+  options_(options),
   commTimeout_{commTimeout},
-  bFailure_{}
+  bFailure_{},
+  bInterest_{true},
+  state_{State::CREATED}
 {
-  init(uuid,
-       sNodeId,
-       probeIndex,
-       probeRate);
+  init(probeRate);
 
   OPENTESTPOINT_TOOLKIT_LOG_FN_DEBUG(logIdentifierCallable_,
                                      "creating probe plugin %s rate: %zd threshold: %zd",
@@ -82,59 +123,31 @@ OpenTestPoint::ProbeContainer::ProbeContainer(const uuid_t & uuid,
                                      probeRate.count(),
                                      commTimeout_.count());
 
-  try
-    {
-      if(!Toolkit::transaction<OpenTestPoint::ProbeRequest,
-         OpenTestPoint::ProbeResponse>
-         (pClient_.get(),
-          OpenTestPoint::ProbeRequest::TYPE_CREATE,
-          commTimeout_,
-          [sPlugin,probeIndex](OpenTestPoint::ProbeRequest & request)
-          {
-            auto pCreate = request.mutable_create();
-
-            pCreate->set_type(OpenTestPoint::ProbeRequest::Create::TYPE_PLUGIN);
+  create_.set_type(OpenTestPoint::ProbeRequest::Create::TYPE_PLUGIN);
 
-            auto pPlugin = pCreate->mutable_plugin();
-
-            pPlugin->set_name(sPlugin.c_str());
-          }))
-        {
-          OPENTESTPOINT_TOOLKIT_LOG_FN_ERROR(logIdentifierCallable_,
-                                             "communication timeout while creating"
-                                             " probe plugin %s",
-                                             sPlugin.c_str());
-
-          bFailure_ = true;
-        }
-    }
-  catch(Toolkit::Exception & exp)
-    {
-      OPENTESTPOINT_TOOLKIT_LOG_FN_ERROR(logIdentifierCallable_,
-                                         "%s",
-                                         exp.what());
+  auto pPlugin = create_.mutable_plugin();
 
-      bFailure_ = true;
-    }
+  pPlugin->set_name(sPlugin.c_str());
 }
 
-OpenTestPoint::ProbeContainer::ProbeContainer(const uuid_t & uuid,
+OpenTestPoint::ProbeContainer::ProbeContainer(std::shared_ptr<ProbeProcess> pProcess,
                                               const std::string & sNodeId,
                                               ProbeIndex probeIndex,
                                               const std::string & sPythonModule,
                                               const std::string & sPythonClass,
                                               const std::chrono::seconds & probeRate,
-                                              const std::chrono::seconds & commTimeout):
+                                              const std::chrono::seconds & commTimeout,
+                                              const ProbeOptions & options):
   Probe{sNodeId,
     probeIndex},
-  pid_{},
+  pProcess_{pProcess},
+  options_(options),
   commTimeout_{commTimeout},
-  bFailure_{}
+  bFailure_{},
+  bInterest_{true},
+  state_{State::CREATED}
 {
-  init(uuid,
-       sNodeId,
-       probeIndex,
-       probeRate);
+  init(probeRate);
 
   OPENTESTPOINT_TOOLKIT_LOG_FN_DEBUG(logIdentifierCallable_,
                                      "creating python probe %s.%s rate: %zd threshold: %zd",
@@ -142,53 +155,20 @@ OpenTestPoint::ProbeContainer::ProbeContainer(const uuid_t & uuid,
                                      sPythonClass.c_str(),
                                      probeRate.count(),
                                      commTimeout_.count());
-  try
-    {
-      if(!Toolkit::transaction<OpenTestPoint::ProbeRequest,
-         OpenTestPoint::ProbeResponse>
-         (pClient_.get(),
-          OpenTestPoint::ProbeRequest::TYPE_CREATE,
-          commTimeout_,
-          [sPythonModule,sPythonClass,probeIndex](OpenTestPoint::ProbeRequest & request)
-          {
-            auto pCreate = request.mutable_create();
-
-            pCreate->set_type(OpenTestPoint::ProbeRequest::Create::TYPE_PYTHON);
 
-            auto pPython = pCreate->mutable_python();
+  create_.set_type(OpenTestPoint::ProbeRequest::Create::TYPE_PYTHON);
 
-            pPython->set_module(sPythonModule);
+  auto pPython = create_.mutable_python();
 
-            pPython->set_class_(sPythonClass);
-          }))
-        {
-          OPENTESTPOINT_TOOLKIT_LOG_FN_ERROR(logIdentifierCallable_,
-                                             "communication timeout while creating"
-                                             " python probe %s.%s",
-                                             sPythonModule.c_str(),
-                                             sPythonClass.c_str());
-
-          bFailure_ = true;
-        }
-    }
-  catch(Toolkit::Exception & exp)
-    {
-      OPENTESTPOINT_TOOLKIT_LOG_FN_ERROR(logIdentifierCallable_,
-                                         "%s",
-                                         exp.what());
+  pPython->set_module(sPythonModule);
 
-      bFailure_ = true;
-    }
+  pPython->set_class_(sPythonClass);
 }
 
-
-void OpenTestPoint::ProbeContainer::init(const uuid_t & uuid,
-                                         const std::string & sNodeId,
-                                         ProbeIndex probeIndex,
-                                         const std::chrono::seconds & probeRate)
-
+void OpenTestPoint::ProbeContainer::init(const std::chrono::seconds & probeRate)
 {
-  uuid_copy(uuid_,uuid);
+  const std::string & sNodeId{sNodeId_};
+  ProbeIndex probeIndex{probeIndex_};
 
   logIdentifierCallable_ =
     [sNodeId,probeIndex]()->std::list<std::string>
@@ -198,209 +178,203 @@ void OpenTestPoint::ProbeContainer::init(const uuid_t & uuid,
       return {ssLabel.str()};
     };
 
-  pContext_.reset(zmq_ctx_new());
+  std::chrono::microseconds offset{phaseOffset(sNodeId_,
+                                               probeIndex_,
+                                               probeRate,
+                                               options_)};
 
-  if(!pContext_)
-    {
-      throw Toolkit::Exception{"Error creating new messaging context: %s",
-          zmq_strerror(errno)};
-    }
-
-  Toolkit::RAIIZMQSocket pStatusSocket{zmq_socket(pContext_.get(),ZMQ_REP)};
+  OPENTESTPOINT_TOOLKIT_LOG_FN_DEBUG(logIdentifierCallable_,
+                                     "phase offset: %lld usec",
+                                     static_cast<long long>(offset.count()));
 
-  if(!pStatusSocket)
-    {
-      throw Toolkit::Exception{"unable to create status socket: %s ",
-          zmq_strerror(errno)};
-    }
+  create_.set_rate(probeRate.count());
 
-  if(zmq_bind(pStatusSocket.get(),"tcp://127.0.0.1:*") < 0)
-    {
-      throw Toolkit::Exception{"unable to bind status socket: %s ",
-          zmq_strerror(errno)};
-    }
+  create_.set_phase(offset.count());
 
-  char buf[1024];
-  size_t len{sizeof(buf)};
+  create_.set_budget(options_.budget.count());
 
-  if(zmq_getsockopt(pStatusSocket.get(),ZMQ_LAST_ENDPOINT,buf,&len))
-    {
-      throw Toolkit::Exception{"unable to determine status socket endpoint : %s",
-          zmq_strerror(errno)};
-    }
+  create_.set_ondemand(options_.onDemand);
 
-  std::string sPublishEndpoint{buf};
+  create_.set_idlerate(options_.idleRate.count());
 
-  pid_ = fork();
+  create_.set_trace(options_.trace);
+}
 
-  switch(pid_)
+void OpenTestPoint::ProbeContainer::create()
+{
+  try
     {
-    case 0:
-      // child
-      {
-        std::string sPythonPathEnv{"PYTHONPATH="};
-
-        const char * pzPYTHON_PATH=secure_getenv("PYTHONPATH");
-
-        std::string sLDLibraryPathEnv{"LD_LIBRARY_PATH="};
-
-        const char * pzLD_LIBRARY_PATH=secure_getenv("LD_LIBRARY_PATH");
-
-        std::string sNodeIdEnv{"nodeid="};
-        sNodeIdEnv.append(sNodeId);
+      if(!pProcess_->ready(commTimeout_))
+        {
+          OPENTESTPOINT_TOOLKIT_LOG_FN_ERROR(logIdentifierCallable_,
+                                             "probe process not ready");
 
-        std::string sProbeIndexEnv{"probeindex="};
-        sProbeIndexEnv.append(std::to_string(probeIndex));
+          bFailure_ = true;
 
-        std::string sProbeRateEnv{"proberate="};
-        sProbeRateEnv.append(std::to_string(probeRate.count()));
+          return;
+        }
 
-        std::string sStatusEnv{"status="};
-        sStatusEnv.append(buf);
+      sLogControlEndpoint_ = pProcess_->getLogControlEndpoint();
+      sLogPublishEndpoint_ = pProcess_->getLogPublishEndpoint();
+      sProbeControlEndpoint_ = pProcess_->getProbeControlEndpoint();
+      sProbePublishEndpoint_ = pProcess_->getProbePublishEndpoint();
 
-        char buf[37]; // 36-byte string (plus tailing '\0')
-        uuid_unparse(uuid,buf);
-        std::string sUUIDEnv{"uuid="};
-        sUUIDEnv.append(buf);
+      pProcess_->attach();
 
-        if(pzPYTHON_PATH)
-          {
-            sPythonPathEnv.append(pzPYTHON_PATH);
-          }
+      OPENTESTPOINT_TOOLKIT_LOG_FN_DEBUG(logIdentifierCallable_,"sending create");
 
-        if(pzLD_LIBRARY_PATH)
-          {
-            sLDLibraryPathEnv.append(pzLD_LIBRARY_PATH);
-          }
+      if(!pProcess_->transaction(probeIndex_,
+                                 OpenTestPoint::ProbeRequest::TYPE_CREATE,
+                                 commTimeout_,
+                                 [this](OpenTestPoint::ProbeRequest & request)
+                                 {
+                                   *request.mutable_create() = create_;
+                                 }))
+        {
+          OPENTESTPOINT_TOOLKIT_LOG_FN_ERROR(logIdentifierCallable_,
+                                             "communication timeout while creating probe");
 
-        const char * const argv[] = {"otestpoint-probe",0};
+          bFailure_ = true;
+        }
+    }
+  catch(Toolkit::Exception & exp)
+    {
+      OPENTESTPOINT_TOOLKIT_LOG_FN_ERROR(logIdentifierCallable_,
+                                         "%s",
+                                         exp.what());
 
-        const char * const envp[] =
-          {
-            sNodeIdEnv.c_str(),
-            sPythonPathEnv.c_str(),
-            sLDLibraryPathEnv.c_str(),
-            sProbeIndexEnv.c_str(),
-            sProbeRateEnv.c_str(),
-            sUUIDEnv.c_str(),
-            sStatusEnv.c_str(),
-            0};
+      bFailure_ = true;
+    }
+}
 
-        if(execvpe("otestpoint-probe",
-                   const_cast<char **>(argv),
-                   const_cast<char **>(&envp[0])) < 0)
-          {
-            std::cerr<<"unable to start probe: "<<strerror(errno)<<std::endl;
-          }
+OpenTestPoint::ProbeContainer::~ProbeContainer(){}
 
-        exit(1);
+OpenTestPoint::ProbeNames
+OpenTestPoint::ProbeContainer::initialize(const std::string & sConfigurationFile)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
 
-      }
-      break;
+  ProbeNames probeNames;
 
-    case -1:
-      // error
-      throw Toolkit::Exception{"unable to start probe: %s ",strerror(errno)};
-      break;
+  // requested state is kept so a restarted probe can be recovered
+  state_ = State::INITIALIZED;
 
-    default:
-      //parent
-      zmq_msg_t message;
+  sConfigurationFile_ = sConfigurationFile;
 
-      zmq_msg_init(&message);
+  if(!bFailure_)
+    {
+      create();
+    }
 
-      zmq_msg_recv(&message,pStatusSocket.get(),0);
+  if(!bFailure_)
+    {
+      probeNames = initialize_i();
+    }
 
-      OpenTestPoint::ProbeStatusReport report{};
+  return probeNames;
+}
 
-      if(!report.ParseFromArray(zmq_msg_data(&message),zmq_msg_size(&message)))
-        {
-          zmq_msg_close(&message);
-          throw Toolkit::Exception{"unable to deserialize transaction"};
-        }
+OpenTestPoint::ProbeNames OpenTestPoint::ProbeContainer::initialize_i()
+{
+  ProbeNames probeNames;
 
-      zmq_msg_close(&message);
+  OPENTESTPOINT_TOOLKIT_LOG_FN_DEBUG(logIdentifierCallable_,"sending initialize");
 
-      if(report.type() == OpenTestPoint::ProbeStatusReport::TYPE_READY)
+  try
+    {
+      if(!pProcess_->transaction(probeIndex_,
+                                 OpenTestPoint::ProbeRequest::TYPE_INITIALIZE,
+                                 commTimeout_,
+                                 [this](OpenTestPoint::ProbeRequest & request)
+                                 {
+                                   auto pInitialize = request.mutable_initialize();
+
+                                   pInitialize->set_configuration(sConfigurationFile_);
+                                 },
+                                 [&probeNames](OpenTestPoint::ProbeResponse & response)
+                                 {
+                                   const auto & initialize = response.initialize();
+
+                                   for(int i = 0; i < initialize.names_size(); ++i)
+                                     {
+                                       probeNames.push_back(initialize.names(i));
+                                     }
+                                 }))
         {
-          sLogControlEndpoint_ = report.ready().logcontrol();
-          sLogPublishEndpoint_ = report.ready().logpublish();
-
-          sProbeControlEndpoint_ = report.ready().probecontrol();
-          sProbePublishEndpoint_ = report.ready().probepublish();
-
-          if(!(pClient_ = zmq_socket(pContext_.get(),ZMQ_REQ)))
-            {
-              throw Toolkit::Exception{"unable to create probe endpoint: %s ",
-                  zmq_strerror(errno)};
-            }
+          OPENTESTPOINT_TOOLKIT_LOG_FN_ERROR(logIdentifierCallable_,
+                                             "initialize communication timeout");
 
-          if(zmq_connect(pClient_.get(),sProbeControlEndpoint_.c_str()) < 0)
-            {
-              throw Toolkit::Exception{"unable to connect to probe endpoint: %s ",
-                  zmq_strerror(errno)};
-            }
+          bFailure_ = true;
         }
+    }
+  catch(Toolkit::Exception & exp)
+    {
+      OPENTESTPOINT_TOOLKIT_LOG_FN_ERROR(logIdentifierCallable_,
+                                         "%s",
+                                         exp.what());
 
-      OpenTestPoint::ProbeStatusResponse response{};
-
-      response.set_type(OpenTestPoint::ProbeStatusResponse::TYPE_SUCCESS);
+      bFailure_ = true;
+    }
 
-      std::string sSerialization{};
+  return probeNames;
+}
 
-      response.SerializeToString(&sSerialization);
+void OpenTestPoint::ProbeContainer::start()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
 
-      zmq_send(pStatusSocket.get(),sSerialization.c_str(),sSerialization.size(),0);
+  state_ = State::RUNNING;
 
-      break;
+  if(!bFailure_)
+    {
+      start_i();
     }
 }
 
-OpenTestPoint::ProbeContainer::~ProbeContainer()
+void OpenTestPoint::ProbeContainer::start_i()
 {
-  if(pid_)
+  OPENTESTPOINT_TOOLKIT_LOG_FN_DEBUG(logIdentifierCallable_,"sending start");
+
+  try
+    {
+      if(!pProcess_->transaction(probeIndex_,
+                                 OpenTestPoint::ProbeRequest::TYPE_START,
+                                 commTimeout_))
+        {
+          OPENTESTPOINT_TOOLKIT_LOG_FN_ERROR(logIdentifierCallable_,
+                                             "start communication timeout");
+
+          bFailure_ = true;
+        }
+    }
+  catch(Toolkit::Exception & exp)
     {
       OPENTESTPOINT_TOOLKIT_LOG_FN_ERROR(logIdentifierCallable_,
-                                         "sending kill to %d",pid_);
+                                         "%s",
+                                         exp.what());
 
-      kill(pid_,SIGTERM);
+      bFailure_ = true;
     }
 }
 
-OpenTestPoint::ProbeNames
-OpenTestPoint::ProbeContainer::initialize(const std::string & sConfigurationFile)
+void OpenTestPoint::ProbeContainer::stop()
 {
-  ProbeNames probeNames;
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  state_ = State::STOPPED;
 
   if(!bFailure_)
     {
-      OPENTESTPOINT_TOOLKIT_LOG_FN_DEBUG(logIdentifierCallable_,"sending initialize");
+      OPENTESTPOINT_TOOLKIT_LOG_FN_DEBUG(logIdentifierCallable_,"sending stop");
 
       try
         {
-          if(!Toolkit::transaction<OpenTestPoint::ProbeRequest,
-             OpenTestPoint::ProbeResponse>
-             (pClient_.get(),
-              OpenTestPoint::ProbeRequest::TYPE_INITIALIZE,
-              commTimeout_,
-              [sConfigurationFile](OpenTestPoint::ProbeRequest & request)
-              {
-                auto pInitialize = request.mutable_initialize();
-
-                pInitialize->set_configuration(sConfigurationFile);
-              },
-              [&probeNames](OpenTestPoint::ProbeResponse & response)
-              {
-                const auto & initialize = response.initialize();
-
-                for(int i = 0; i < initialize.names_size(); ++i)
-                  {
-                    probeNames.push_back(initialize.names(i));
-                  }
-              }))
+          if(!pProcess_->transaction(probeIndex_,
+                                     OpenTestPoint::ProbeRequest::TYPE_STOP,
+                                     commTimeout_))
             {
               OPENTESTPOINT_TOOLKIT_LOG_FN_ERROR(logIdentifierCallable_,
-                                                 "initialize communication timeout");
+                                                 "stop communication timeout");
 
               bFailure_ = true;
             }
@@ -414,94 +388,151 @@ OpenTestPoint::ProbeContainer::initialize(const std::string & sConfigurationFile
           bFailure_ = true;
         }
     }
-
-  return probeNames;
 }
 
-
-void OpenTestPoint::ProbeContainer::start()
+void OpenTestPoint::ProbeContainer::destroy()
 {
-  if(!bFailure_)
-    {
-      OPENTESTPOINT_TOOLKIT_LOG_FN_DEBUG(logIdentifierCallable_,"sending start");
+  std::lock_guard<std::mutex> lock(mutex_);
 
-      try
-        {
-          if(!Toolkit::transaction<OpenTestPoint::ProbeRequest,
-             OpenTestPoint::ProbeResponse>
-             (pClient_.get(),
-              OpenTestPoint::ProbeRequest::TYPE_START,
-              commTimeout_))
-            {
-              OPENTESTPOINT_TOOLKIT_LOG_FN_ERROR(logIdentifierCallable_,
-                                                 "start communication timeout");
+  state_ = State::DESTROYED;
 
-              bFailure_ = true;
-            }
-        }
-      catch(Toolkit::Exception & exp)
+  OPENTESTPOINT_TOOLKIT_LOG_FN_DEBUG(logIdentifierCallable_,"sending destroy");
+
+  try
+    {
+      if(!pProcess_->transaction(probeIndex_,
+                                 OpenTestPoint::ProbeRequest::TYPE_DESTROY,
+                                 commTimeout_))
         {
           OPENTESTPOINT_TOOLKIT_LOG_FN_ERROR(logIdentifierCallable_,
-                                             "%s",
-                                             exp.what());
+                                             "destroy communication timeout");
 
           bFailure_ = true;
         }
+      else
+        {
+          pProcess_->detach();
+        }
+    }
+  catch(Toolkit::Exception & exp)
+    {
+      OPENTESTPOINT_TOOLKIT_LOG_FN_ERROR(logIdentifierCallable_,
+                                         "%s",
+                                         exp.what());
+
+      bFailure_ = true;
     }
 }
 
-void OpenTestPoint::ProbeContainer::stop()
+void OpenTestPoint::ProbeContainer::setRate(const std::chrono::seconds & probeRate)
 {
-  if(!bFailure_)
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  // the phase offset is chosen again for the new rate
+  std::chrono::microseconds offset{phaseOffset(sNodeId_,
+                                               probeIndex_,
+                                               probeRate,
+                                               options_)};
+
+  OPENTESTPOINT_TOOLKIT_LOG_FN_INFO(logIdentifierCallable_,
+                                    "rate: %u -> %zd phase offset: %lld usec",
+                                    create_.rate(),
+                                    probeRate.count(),
+                                    static_cast<long long>(offset.count()));
+
+  // not yet created, the create request carries the rate
+  if(bFailure_ || state_ == State::CREATED || state_ == State::DESTROYED)
     {
-      OPENTESTPOINT_TOOLKIT_LOG_FN_DEBUG(logIdentifierCallable_,"sending stop");
+      create_.set_rate(probeRate.count());
 
-      try
-        {
-          if(!Toolkit::transaction<OpenTestPoint::ProbeRequest,
-             OpenTestPoint::ProbeResponse>
-             (pClient_.get(),
-              OpenTestPoint::ProbeRequest::TYPE_STOP,
-              commTimeout_))
-            {
-              OPENTESTPOINT_TOOLKIT_LOG_FN_ERROR(logIdentifierCallable_,
-                                                 "stop communication timeout");
+      create_.set_phase(offset.count());
 
-              bFailure_ = true;
-            }
-        }
-      catch(Toolkit::Exception & exp)
+      return;
+    }
+
+  OPENTESTPOINT_TOOLKIT_LOG_FN_DEBUG(logIdentifierCallable_,"sending set rate");
+
+  try
+    {
+      if(!pProcess_->transaction(probeIndex_,
+                                 OpenTestPoint::ProbeRequest::TYPE_SET_RATE,
+                                 commTimeout_,
+                                 [&probeRate,&offset](OpenTestPoint::ProbeRequest & request)
+                                 {
+                                   auto pSetRate = request.mutable_setrate();
+
+                                   pSetRate->set_rate(probeRate.count());
+
+                                   pSetRate->set_phase(offset.count());
+                                 }))
         {
           OPENTESTPOINT_TOOLKIT_LOG_FN_ERROR(logIdentifierCallable_,
-                                             "%s",
-                                             exp.what());
+                                             "set rate communication timeout");
 
           bFailure_ = true;
+
+          return;
         }
+
+      // only an applied rate is reported and replayed on recovery
+      create_.set_rate(probeRate.count());
+
+      create_.set_phase(offset.count());
+    }
+  catch(Toolkit::Exception & exp)
+    {
+      OPENTESTPOINT_TOOLKIT_LOG_FN_ERROR(logIdentifierCallable_,
+                                         "%s",
+                                         exp.what());
+
+      throw;
     }
 }
 
-void OpenTestPoint::ProbeContainer::destroy()
+void OpenTestPoint::ProbeContainer::setInterest(bool bInterest)
 {
-  OPENTESTPOINT_TOOLKIT_LOG_FN_DEBUG(logIdentifierCallable_,"sending destroy");
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  if(!options_.onDemand || bInterest_ == bInterest)
+    {
+      return;
+    }
+
+  // a created or recovered probe starts with the current interest
+  if(bFailure_ || state_ == State::CREATED || state_ == State::DESTROYED)
+    {
+      bInterest_ = bInterest;
+
+      create_.set_interest(bInterest_);
+
+      return;
+    }
+
+  OPENTESTPOINT_TOOLKIT_LOG_FN_DEBUG(logIdentifierCallable_,
+                                     "sending set interest: %s",
+                                     bInterest ? "true" : "false");
 
   try
     {
-      if(!Toolkit::transaction<OpenTestPoint::ProbeRequest,
-         OpenTestPoint::ProbeResponse>
-         (pClient_.get(),
-          OpenTestPoint::ProbeRequest::TYPE_DESTROY,
-          commTimeout_))
+      if(!pProcess_->transaction(probeIndex_,
+                                 OpenTestPoint::ProbeRequest::TYPE_SET_INTEREST,
+                                 commTimeout_,
+                                 [bInterest](OpenTestPoint::ProbeRequest & request)
+                                 {
+                                   request.mutable_setinterest()->set_interest(bInterest);
+                                 }))
         {
           OPENTESTPOINT_TOOLKIT_LOG_FN_ERROR(logIdentifierCallable_,
-                                             "destroy communication timeout");
+                                             "set interest communication timeout");
 
           bFailure_ = true;
+
+          return;
         }
-      else
-        {
-          pid_ = 0;
-        }
+
+      bInterest_ = bInterest;
+
+      create_.set_interest(bInterest_);
     }
   catch(Toolkit::Exception & exp)
     {
@@ -509,6 +540,72 @@ void OpenTestPoint::ProbeContainer::destroy()
                                          "%s",
                                          exp.what());
 
-      bFailure_ = true;
+      throw;
+    }
+}
+
+std::chrono::seconds OpenTestPoint::ProbeContainer::getRate()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  return std::chrono::seconds{create_.rate()};
+}
+
+bool OpenTestPoint::ProbeContainer::recover(ProbeNames & probeNames)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  // nothing to recover
+  if(state_ == State::CREATED || state_ == State::DESTROYED)
+    {
+      return true;
+    }
+
+  OPENTESTPOINT_TOOLKIT_LOG_FN_INFO(logIdentifierCallable_,"recovering probe");
+
+  bFailure_ = false;
+
+  create();
+
+  if(!bFailure_)
+    {
+      probeNames = initialize_i();
     }
+
+  if(!bFailure_ && state_ == State::RUNNING)
+    {
+      start_i();
+    }
+
+  return !bFailure_;
+}
+
+std::string OpenTestPoint::ProbeContainer::getStatus() const
+{
+  if(bFailure_)
+    {
+      return "failed";
+    }
+
+  switch(state_.load())
+    {
+    case State::CREATED:
+      return "created";
+    case State::INITIALIZED:
+      return "initialized";
+    case State::RUNNING:
+      return "running";
+    case State::STOPPED:
+      return "stopped";
+    case State::DESTROYED:
+      return "destroyed";
+    }
+
+  return "unknown";
+}
+
+std::shared_ptr<OpenTestPoint::ProbeProcess>
+OpenTestPoint::ProbeContainer::getProcess() const
+{
+  return pProcess_;
 }
@@ -36,36 +36,36 @@
 #define OPENTESTPOINT_PROBECONTAINER_HEADER_
 
 #include "otestpoint/probe.h"
-#include "otestpoint/toolkit/raiizmq.h"
+#include "otestpoint/probeoptions.h"
+#include "probeprocess.h"
 
+#include <atomic>
 #include <functional>
 #include <chrono>
-#include <uuid.h>
-
-namespace OpenTestPoint
-{
-  class ProbeRequest;
-}
+#include <memory>
+#include <mutex>
 
 namespace OpenTestPoint
 {
   class ProbeContainer : public Probe
   {
   public:
-    ProbeContainer(const uuid_t & uuid,
+    ProbeContainer(std::shared_ptr<ProbeProcess> pProcess,
                    const std::string & sNodeId,
                    ProbeIndex probeIndex,
                    const std::string & sPluginLibrary,
                    const std::chrono::seconds & probeRate,
-                   const std::chrono::seconds & commTimeout);
+                   const std::chrono::seconds & commTimeout,
+                   const ProbeOptions & options);
 
-    ProbeContainer(const uuid_t & uuid,
+    ProbeContainer(std::shared_ptr<ProbeProcess> pProcess,
                    const std::string & sNodeId,
                    ProbeIndex probeIndex,
                    const std::string & sPythonModule,
                    const std::string & sPythonClass,
                    const std::chrono::seconds & probeRate,
-                   const std::chrono::seconds & commTimeout);
+                   const std::chrono::seconds & commTimeout,
+                   const ProbeOptions & options);
 
     ~ProbeContainer();
 
@@ -77,23 +77,55 @@ namespace OpenTestPoint
 
     void destroy() override;
 
-    std::list<std::string> logIdentifier(const std::string & sLabel);
+    // changes the probe rate, kept across host process restarts.
+    // Throws when the host rejects the request, the previous rate is
+    // kept.
+    void setRate(const std::chrono::seconds & probeRate);
+
+    std::chrono::seconds getRate();
+
+    // on demand probes run at their idle rate without interest.
+    // Throws when the host rejects the request, the previous
+    // interest is kept.
+    void setInterest(bool bInterest);
+
+    // creates the probe again in a restarted host process and
+    // replays initialize and start as previously requested
+    bool recover(ProbeNames & probeNames);
+
+    std::shared_ptr<ProbeProcess> getProcess() const;
+
+    // lifecycle state, or failed when the last request failed. Does
+    // not wait for a request in progress.
+    std::string getStatus() const;
 
   private:
-    uuid_t uuid_;
-    pid_t pid_;
-    Toolkit::RAIIZMQContext pContext_;
-    Toolkit::RAIIZMQSocket pClient_;
+    enum class State {CREATED,INITIALIZED,RUNNING,STOPPED,DESTROYED};
 
+    std::shared_ptr<ProbeProcess> pProcess_;
+    ProbeRequest::Create create_;
+    std::string sConfigurationFile_;
+
+    const ProbeOptions options_;
     const std::chrono::seconds commTimeout_;
-    bool bFailure_;
+    // read without the mutex by getStatus()
+    std::atomic<bool> bFailure_;
+    bool bInterest_;
+    std::atomic<State> state_;
+
+    // serializes lifecycle requests with recovery
+    std::mutex mutex_;
 
     std::function<std::list<std::string>()> logIdentifierCallable_;
 
-    void init(const uuid_t & uuid,
-              const std::string & sNodeId,
-              ProbeIndex probeIndex,
-              const std::chrono::seconds & probeRate);
+    void init(const std::chrono::seconds & probeRate);
+
+    // waits for the host process and creates the probe
+    void create();
+
+    ProbeNames initialize_i();
+
+    void start_i();
   };
 }
 
@@ -0,0 +1,446 @@
+/*
+ * Copyright (c) 2026 - Adjacent Link LLC, Bridgewater, New Jersey
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  * Neither the name of Adjacent Link LLC nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * See toplevel COPYING for more information.
+ */
+
+#include "probeprocess.h"
+#include "probezygote.h"
+#include "otestpoint/toolkit/exception.h"
+#include "otestpoint/toolkit/transaction.h"
+#include "otestpoint/toolkit/servicesingleton.h"
+
+#include <zmq.h>
+#include <unistd.h>
+#include <cstring>
+#include <signal.h>
+#include <sstream>
+#include <vector>
+
+#ifndef HAVE_SECURE_GETENV
+#  ifdef HAVE___SECURE_GETENV
+#    define secure_getenv __secure_getenv
+#  else
+#    error neither secure_getenv nor __secure_getenv is available
+#  endif
+#endif
+
+namespace
+{
+  // host process placement and scheduling environment entries,
+  // applied by otestpoint-probe at startup before it starts any
+  // threads
+  void addPlacement(std::vector<std::string> & environment,
+                    const OpenTestPoint::ProbeOptions & options)
+  {
+    if(!options.cgroup.empty())
+      {
+        environment.push_back("cgroup=" + options.cgroup);
+      }
+
+    if(!options.affinity.empty())
+      {
+        std::string sAffinity{"affinity="};
+
+        for(const auto & u16CPU : options.affinity)
+          {
+            if(sAffinity.back() != '=')
+              {
+                sAffinity.push_back(',');
+              }
+
+            sAffinity.append(std::to_string(u16CPU));
+          }
+
+        environment.push_back(sAffinity);
+      }
+
+    switch(options.scheduler)
+      {
+      case OpenTestPoint::ProbeOptions::Scheduler::OTHER:
+        environment.push_back("scheduler=other");
+        environment.push_back("nice=" + std::to_string(options.nice));
+        break;
+
+      case OpenTestPoint::ProbeOptions::Scheduler::FIFO:
+        environment.push_back("scheduler=fifo");
+        environment.push_back("priority=" + std::to_string(options.priority));
+        break;
+
+      default:
+        break;
+      }
+  }
+}
+
+OpenTestPoint::ProbeProcess::ProbeProcess(const uuid_t & uuid,
+                                          const std::string & sNodeId,
+                                          const std::string & sHostId,
+                                          const ProbeOptions & options):
+  sNodeId_{sNodeId},
+  sHostId_{sHostId},
+  options_(options),
+  state_{State::STARTING},
+  pid_{},
+  attached_{}
+{
+  uuid_copy(uuid_,uuid);
+
+  logIdentifierCallable_ =
+    [sNodeId,sHostId]()->std::list<std::string>
+    {
+      std::stringstream ssLabel{};
+      ssLabel<<'/'<<sNodeId<<'/'<<sHostId<<"/process";
+      return {ssLabel.str()};
+    };
+
+  pContext_.reset(zmq_ctx_new());
+
+  if(!pContext_)
+    {
+      throw Toolkit::Exception{"Error creating new messaging context: %s",
+          zmq_strerror(errno)};
+    }
+
+  spawn();
+}
+
+void OpenTestPoint::ProbeProcess::spawn()
+{
+  // a fresh status socket per child, a dead child may leave a
+  // stale report queued on the previous one
+  pStatusSocket_.reset(zmq_socket(pContext_.get(),ZMQ_REP));
+
+  if(!pStatusSocket_)
+    {
+      throw Toolkit::Exception{"unable to create status socket: %s ",
+          zmq_strerror(errno)};
+    }
+
+  // a response queued for a child that was killed must not block
+  // context termination
+  int iLinger{0};
+
+  zmq_setsockopt(pStatusSocket_.get(),ZMQ_LINGER,&iLinger,sizeof(iLinger));
+
+  if(zmq_bind(pStatusSocket_.get(),"tcp://127.0.0.1:*") < 0)
+    {
+      throw Toolkit::Exception{"unable to bind status socket: %s ",
+          zmq_strerror(errno)};
+    }
+
+  char buf[1024];
+  size_t len{sizeof(buf)};
+
+  if(zmq_getsockopt(pStatusSocket_.get(),ZMQ_LAST_ENDPOINT,buf,&len))
+    {
+      throw Toolkit::Exception{"unable to determine status socket endpoint : %s",
+          zmq_strerror(errno)};
+    }
+
+  std::vector<std::string> environment{};
+
+  environment.push_back("nodeid=" + sNodeId_);
+
+  const char * pzPYTHON_PATH=secure_getenv("PYTHONPATH");
+
+  environment.push_back(std::string{"PYTHONPATH="} + (pzPYTHON_PATH ? pzPYTHON_PATH : ""));
+
+  const char * pzLD_LIBRARY_PATH=secure_getenv("LD_LIBRARY_PATH");
+
+  environment.push_back(std::string{"LD_LIBRARY_PATH="} + (pzLD_LIBRARY_PATH ? pzLD_LIBRARY_PATH : ""));
+
+  environment.push_back("hostid=" + sHostId_);
+
+  char bufUUID[37]; // 36-byte string (plus tailing '\0')
+  uuid_unparse(uuid_,bufUUID);
+  environment.push_back(std::string{"uuid="} + bufUUID);
+
+  environment.push_back(std::string{"status="} + buf);
+
+  addPlacement(environment,options_);
+
+  if(options_.zygote)
+    {
+      pid_ = ProbeZygote::instance()->spawn(environment);
+
+      if(pid_)
+        {
+          return;
+        }
+    }
+
+  const char * const argv[] = {"otestpoint-probe",0};
+
+  std::vector<const char *> envp{};
+
+  for(const auto & sEntry : environment)
+    {
+      envp.push_back(sEntry.c_str());
+    }
+
+  envp.push_back(nullptr);
+
+  pid_ = fork();
+
+  switch(pid_)
+    {
+    case 0:
+      // child, only async-signal-safe calls until exec: otestpointd
+      // is multithreaded and another thread may hold a lock
+      {
+        execvpe("otestpoint-probe",
+                const_cast<char **>(argv),
+                const_cast<char **>(envp.data()));
+
+        const char sError[] = "unable to start probe: unable to execute otestpoint-probe\n";
+
+        ssize_t rc{write(STDERR_FILENO,sError,sizeof(sError) - 1)};
+
+        (void) rc;
+
+        _exit(1);
+      }
+      break;
+
+    case -1:
+      // error
+      pid_ = 0;
+      throw Toolkit::Exception{"unable to start probe: %s ",strerror(errno)};
+      break;
+
+    default:
+      //parent
+      break;
+    }
+}
+
+bool OpenTestPoint::ProbeProcess::ready(const std::chrono::seconds & timeout)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  if(state_ != State::STARTING)
+    {
+      return state_ == State::READY;
+    }
+
+  // a failure to report ready is only recoverable by a restart
+  state_ = State::FAILED;
+
+  zmq_pollitem_t items[] =
+    {
+      {pStatusSocket_.get(),0,ZMQ_POLLIN,0},
+    };
+
+  if(zmq_poll(items,1,std::chrono::milliseconds{timeout}.count()) <= 0)
+    {
+      OPENTESTPOINT_TOOLKIT_LOG_FN_ERROR(logIdentifierCallable_,
+                                         "ready timeout");
+      return false;
+    }
+
+  zmq_msg_t message;
+
+  zmq_msg_init(&message);
+
+  zmq_msg_recv(&message,pStatusSocket_.get(),0);
+
+  OpenTestPoint::ProbeStatusReport report{};
+
+  if(!report.ParseFromArray(zmq_msg_data(&message),zmq_msg_size(&message)))
+    {
+      zmq_msg_close(&message);
+      throw Toolkit::Exception{"unable to deserialize transaction"};
+    }
+
+  zmq_msg_close(&message);
+
+  if(report.type() == OpenTestPoint::ProbeStatusReport::TYPE_READY)
+    {
+      sLogControlEndpoint_ = report.ready().logcontrol();
+      sLogPublishEndpoint_ = report.ready().logpublish();
+
+      sProbeControlEndpoint_ = report.ready().probecontrol();
+      sProbePublishEndpoint_ = report.ready().probepublish();
+
+      if(!(pClient_ = zmq_socket(pContext_.get(),ZMQ_REQ)))
+        {
+          throw Toolkit::Exception{"unable to create probe endpoint: %s ",
+              zmq_strerror(errno)};
+        }
+
+      int iLinger{0};
+
+      zmq_setsockopt(pClient_.get(),ZMQ_LINGER,&iLinger,sizeof(iLinger));
+
+      if(zmq_connect(pClient_.get(),sProbeControlEndpoint_.c_str()) < 0)
+        {
+          throw Toolkit::Exception{"unable to connect to probe endpoint: %s ",
+              zmq_strerror(errno)};
+        }
+
+      state_ = State::READY;
+    }
+
+  OpenTestPoint::ProbeStatusResponse response{};
+
+  response.set_type(OpenTestPoint::ProbeStatusResponse::TYPE_SUCCESS);
+
+  std::string sSerialization{};
+
+  response.SerializeToString(&sSerialization);
+
+  zmq_send(pStatusSocket_.get(),sSerialization.c_str(),sSerialization.size(),0);
+
+  return state_ == State::READY;
+}
+
+OpenTestPoint::ProbeProcess::~ProbeProcess()
+{
+  if(pid_)
+    {
+      OPENTESTPOINT_TOOLKIT_LOG_FN_ERROR(logIdentifierCallable_,
+                                         "sending kill to %d",pid_);
+
+      kill(pid_,SIGTERM);
+    }
+}
+
+bool OpenTestPoint::ProbeProcess::transaction(ProbeIndex probeIndex,
+                                              ProbeRequest::Type type,
+                                              const std::chrono::seconds & timeout,
+                                              std::function<void (ProbeRequest &)> buildRequestFunc,
+                                              std::function<void (ProbeResponse &)> parseResponseFunc)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  if(state_ != State::READY)
+    {
+      throw Toolkit::Exception{"probe process not ready"};
+    }
+
+  return Toolkit::transaction<OpenTestPoint::ProbeRequest,
+                              OpenTestPoint::ProbeResponse>
+    (pClient_.get(),
+     type,
+     timeout,
+     [probeIndex,&buildRequestFunc](OpenTestPoint::ProbeRequest & request)
+     {
+       request.set_index(probeIndex);
+
+       buildRequestFunc(request);
+     },
+     parseResponseFunc);
+}
+
+pid_t OpenTestPoint::ProbeProcess::getPid()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  return pid_;
+}
+
+void OpenTestPoint::ProbeProcess::exited()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  pid_ = 0;
+
+  state_ = State::FAILED;
+
+  // any outstanding request died with the process
+  pClient_.reset(nullptr);
+}
+
+void OpenTestPoint::ProbeProcess::restart()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  if(pid_)
+    {
+      throw Toolkit::Exception{"probe process %d still running",pid_};
+    }
+
+  state_ = State::STARTING;
+
+  // recovered probes attach again on create
+  attached_ = 0;
+
+  sProbeControlEndpoint_.clear();
+  sProbePublishEndpoint_.clear();
+  sLogControlEndpoint_.clear();
+  sLogPublishEndpoint_.clear();
+
+  spawn();
+}
+
+void OpenTestPoint::ProbeProcess::attach()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  ++attached_;
+}
+
+void OpenTestPoint::ProbeProcess::detach()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  // the host process exits once its last probe is destroyed
+  if(attached_ && !--attached_)
+    {
+      pid_ = 0;
+    }
+}
+
+const std::string & OpenTestPoint::ProbeProcess::getHostId() const
+{
+  return sHostId_;
+}
+
+const std::string & OpenTestPoint::ProbeProcess::getProbeControlEndpoint() const
+{
+  return sProbeControlEndpoint_;
+}
+
+const std::string & OpenTestPoint::ProbeProcess::getProbePublishEndpoint() const
+{
+  return sProbePublishEndpoint_;
+}
+
+const std::string & OpenTestPoint::ProbeProcess::getLogControlEndpoint() const
+{
+  return sLogControlEndpoint_;
+}
+
+const std::string & OpenTestPoint::ProbeProcess::getLogPublishEndpoint() const
+{
+  return sLogPublishEndpoint_;
+}
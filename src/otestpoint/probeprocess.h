@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2026 - Adjacent Link LLC, Bridgewater, New Jersey
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  * Neither the name of Adjacent Link LLC nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * See toplevel COPYING for more information.
+ */
+
+#ifndef OPENTESTPOINT_PROBEPROCESS_HEADER_
+#define OPENTESTPOINT_PROBEPROCESS_HEADER_
+
+#include "otestpoint/types.h"
+#include "otestpoint/probeoptions.h"
+#include "otestpoint/toolkit/raiizmq.h"
+#include "libotestpoint.pb.h"
+
+#include <functional>
+#include <chrono>
+#include <string>
+#include <list>
+#include <mutex>
+#include <uuid.h>
+#include <sys/types.h>
+
+namespace OpenTestPoint
+{
+  /**
+   * @class ProbeProcess
+   *
+   * @brief An otestpoint-probe host process.
+   *
+   * Starts an otestpoint-probe process and provides the control
+   * channel used by the probe containers hosted by the process. The
+   * process is started on construction and waited on by ready() so
+   * that several processes may start concurrently. All methods are
+   * safe to call from multiple threads, requests to probes sharing a
+   * process are serialized. A process is shared by all containers in
+   * the same group and is terminated when the last reference is
+   * released unless every hosted probe was destroyed. A process that
+   * exits may be restarted, hosted probes must then be created
+   * again.
+   */
+  class ProbeProcess
+  {
+  public:
+    /**
+     * Creates an instance and starts the host process
+     *
+     * @param uuid Controller UUID
+     * @param sNodeId Controller id
+     * @param sHostId Host identifier used in log labels, either the
+     * probe index of an isolated probe or a group name.
+     * @param options Options of the first hosted probe, only the
+     * affinity, scheduler and cgroup settings are used.
+     *
+     * @throws Toolkit::Exception on error
+     */
+    ProbeProcess(const uuid_t & uuid,
+                 const std::string & sNodeId,
+                 const std::string & sHostId,
+                 const ProbeOptions & options = ProbeOptions{});
+
+    ~ProbeProcess();
+
+    /**
+     * Waits for the process to report ready, once
+     *
+     * @param timeout Maximum time to wait
+     *
+     * @return @a true if the process is ready
+     *
+     * @throws Toolkit::Exception on error
+     */
+    bool ready(const std::chrono::seconds & timeout);
+
+    /**
+     * Sends a request to a hosted probe and waits for the response
+     *
+     * @return @a false on communication timeout
+     *
+     * @throws Toolkit::Exception on error or failure response
+     */
+    bool transaction(ProbeIndex probeIndex,
+                     ProbeRequest::Type type,
+                     const std::chrono::seconds & timeout,
+                     std::function<void (ProbeRequest &)> buildRequestFunc = [](ProbeRequest &){},
+                     std::function<void (ProbeResponse &)> parseResponseFunc = [](ProbeResponse &){});
+
+    /**
+     * Gets the process id
+     *
+     * @return pid or 0 if the process is not running
+     */
+    pid_t getPid();
+
+    /**
+     * Marks the process as exited once it has been reaped
+     */
+    void exited();
+
+    /**
+     * Starts a new host process in place of an exited one
+     *
+     * @throws Toolkit::Exception on error
+     */
+    void restart();
+
+    /**
+     * Registers a hosted probe
+     */
+    void attach();
+
+    /**
+     * Deregisters a hosted probe that was successfully destroyed
+     */
+    void detach();
+
+    const std::string & getHostId() const;
+
+    // valid once ready() returns true
+    const std::string & getProbeControlEndpoint() const;
+
+    const std::string & getProbePublishEndpoint() const;
+
+    const std::string & getLogControlEndpoint() const;
+
+    const std::string & getLogPublishEndpoint() const;
+
+  private:
+    enum class State {STARTING,READY,FAILED};
+
+    uuid_t uuid_;
+    const std::string sNodeId_;
+    const std::string sHostId_;
+    const ProbeOptions options_;
+    std::mutex mutex_;
+    State state_;
+    pid_t pid_;
+    Toolkit::RAIIZMQContext pContext_;
+    Toolkit::RAIIZMQSocket pStatusSocket_;
+    Toolkit::RAIIZMQSocket pClient_;
+    std::string sProbeControlEndpoint_;
+    std::string sProbePublishEndpoint_;
+    std::string sLogControlEndpoint_;
+    std::string sLogPublishEndpoint_;
+    std::size_t attached_;
+
+    std::function<std::list<std::string>()> logIdentifierCallable_;
+
+    // binds a new status socket and forks the host process
+    void spawn();
+  };
+}
+
+#endif // OPENTESTPOINT_PROBEPROCESS_HEADER_
@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2026 - Adjacent Link LLC, Bridgewater, New Jersey
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  * Neither the name of Adjacent Link LLC nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * See toplevel COPYING for more information.
+ */
+
+// Measures host process startup: the time from constructing a
+// ProbeProcess until otestpoint-probe reports ready, exec'ing
+// otestpoint-probe versus forking from the zygote. Run with
+// otestpoint-probe on the PATH.
+
+#include "probeprocess.h"
+#include "benchsupport.h"
+
+#include "otestpoint/toolkit/servicesingleton.h"
+
+#include <uuid.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <sys/wait.h>
+
+namespace
+{
+  // starts a host process and waits for ready, returns milliseconds
+  double start(const uuid_t & uuid,
+               const std::string & sHostId,
+               const OpenTestPoint::ProbeOptions & options)
+  {
+    pid_t pid{};
+
+    auto begin = std::chrono::steady_clock::now();
+
+    {
+      OpenTestPoint::ProbeProcess process{uuid,"bench",sHostId,options};
+
+      if(!process.ready(std::chrono::seconds{10}))
+        {
+          std::fprintf(stderr,"host %s not ready\n",sHostId.c_str());
+          std::exit(EXIT_FAILURE);
+        }
+
+      pid = process.getPid();
+    }
+
+    auto duration = std::chrono::steady_clock::now() - begin;
+
+    // terminated by the process destructor
+    waitpid(pid,nullptr,0);
+
+    return std::chrono::duration<double,std::milli>(duration).count();
+  }
+
+  void report(const char * pzPath,
+              const uuid_t & uuid,
+              const OpenTestPoint::ProbeOptions & options,
+              std::size_t iterations)
+  {
+    std::vector<double> samples{};
+
+    for(std::size_t i = 0; i < iterations; ++i)
+      {
+        samples.push_back(start(uuid,std::to_string(i),options));
+      }
+
+    auto summary = OpenTestPoint::Bench::summarize(samples);
+
+    std::printf("%-8s starts=%-4zu min=%-8.2f median=%-8.2f mean=%-8.2f max=%.2f ms\n",
+                pzPath,
+                iterations,
+                summary.dMin,
+                summary.dMedian,
+                summary.dMean,
+                summary.dMax);
+  }
+}
+
+int main(int argc, char * argv[])
+{
+  std::size_t iterations{argc > 1 ? std::strtoul(argv[1],nullptr,10) : 20};
+
+  OpenTestPoint::Toolkit::ServiceSingleton::instance()->initialize(new OpenTestPoint::Bench::NullLogClient{});
+
+  uuid_t uuid;
+
+  uuid_generate(uuid);
+
+  OpenTestPoint::ProbeOptions options{};
+
+  report("exec",uuid,options,iterations);
+
+  options.zygote = true;
+
+  // the first zygote start includes zygote initialization
+  std::printf("%-8s first=%.2f ms\n","zygote",start(uuid,"first",options));
+
+  report("zygote",uuid,options,iterations);
+
+  return 0;
+}
@@ -0,0 +1,740 @@
+/*
+ * Copyright (c) 2026 - Adjacent Link LLC, Bridgewater, New Jersey
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  * Neither the name of Adjacent Link LLC nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * See toplevel COPYING for more information.
+ */
+
+#include "probesupervisor.h"
+#include "otestpoint/toolkit/exception.h"
+#include "otestpoint/toolkit/servicesingleton.h"
+#include "controller.pb.h"
+#include "measurementtable.pb.h"
+
+#include <zmq.h>
+#include <algorithm>
+#include <iostream>
+#include <set>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include <sys/syscall.h>
+
+const char * OpenTestPoint::ProbeSupervisor::HealthEndpoint = "inproc://supervisor-health";
+
+const char * OpenTestPoint::ProbeSupervisor::RewireEndpoint = "inproc://supervisor-rewire";
+
+const char * OpenTestPoint::ProbeSupervisor::HealthProbeName = "OpenTestPoint.Health";
+
+namespace
+{
+  const char * InternalEndpoint = "inproc://supervisor";
+
+  const std::chrono::milliseconds InitialBackoff{1000};
+
+  const std::chrono::milliseconds MaximumBackoff{60000};
+
+  // a host running this long without exiting restarts with the
+  // initial backoff
+  const std::chrono::seconds StableInterval{60};
+
+  const std::chrono::seconds HealthInterval{1};
+
+  // matches the probe host log and timing report interval
+  const std::chrono::seconds LogInterval{10};
+
+  // waitpid() polling interval when a pidfd is not available
+  const std::chrono::milliseconds PollInterval{250};
+
+  int pidfdOpen(pid_t pid)
+  {
+#ifdef SYS_pidfd_open
+    return syscall(SYS_pidfd_open,pid,0);
+#else
+    (void)pid;
+    errno = ENOSYS;
+    return -1;
+#endif
+  }
+}
+
+OpenTestPoint::ProbeSupervisor::ProbeSupervisor(void * pContext,
+                                                const std::string & sNodeId,
+                                                const uuid_t & uuid,
+                                                const Toolkit::Log::Service & logService,
+                                                LogEndpointsCallable logEndpointsCallable):
+  pContext_{pContext},
+  logService_(logService),
+  logEndpointsCallable_{logEndpointsCallable},
+  sNodeId_{sNodeId},
+  selfMonitor_{sNodeId,uuid}
+{
+  logIdentifierCallable_ =
+    []()->std::list<std::string>
+    {
+      return {"/supervisor"};
+    };
+}
+
+OpenTestPoint::ProbeSupervisor::~ProbeSupervisor()
+{
+  stop();
+}
+
+void OpenTestPoint::ProbeSupervisor::add(ProbeContainer * pContainer)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  auto pProcess = pContainer->getProcess();
+
+  auto iter = std::find_if(hosts_.begin(),
+                           hosts_.end(),
+                           [&pProcess](const Host & host)
+                           {
+                             return host.pProcess_ == pProcess;
+                           });
+
+  if(iter == hosts_.end())
+    {
+      hosts_.push_back(Host{pProcess,
+            {},
+            0,
+            -1,
+            {},
+            0,
+            InitialBackoff,
+            {},
+            {},
+            {},
+            Clock::duration::zero(),
+            false});
+
+      iter = hosts_.end() - 1;
+
+      if(thread_.joinable())
+        {
+          iter->sPublishEndpoint_ = pProcess->getProbePublishEndpoint();
+
+          watch(*iter);
+
+          // wake the supervisor to poll the new host
+          zmq_send(pInternalSocket_.get(),"wake",4,0);
+        }
+    }
+
+  iter->containers_.push_back(pContainer);
+}
+
+void OpenTestPoint::ProbeSupervisor::remove(ProbeContainer * pContainer)
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  // a restart recovers its containers without holding the lock
+  restartCondition_.wait(lock,
+                         [this,pContainer]()
+                         {
+                           return std::none_of(hosts_.begin(),
+                                               hosts_.end(),
+                                               [pContainer](const Host & host)
+                                               {
+                                                 return host.bRestarting_ &&
+                                                   std::count(host.containers_.begin(),
+                                                              host.containers_.end(),
+                                                              pContainer);
+                                               });
+                         });
+
+  for(auto iter = hosts_.begin(); iter != hosts_.end(); ++iter)
+    {
+      auto & containers = iter->containers_;
+
+      auto position = std::find(containers.begin(),containers.end(),pContainer);
+
+      if(position != containers.end())
+        {
+          containers.erase(position);
+
+          if(containers.empty())
+            {
+              if(iter->iPidFd_ >= 0)
+                {
+                  close(iter->iPidFd_);
+                }
+
+              hosts_.erase(iter);
+
+              if(thread_.joinable())
+                {
+                  zmq_send(pInternalSocket_.get(),"wake",4,0);
+                }
+            }
+
+          break;
+        }
+    }
+}
+
+void OpenTestPoint::ProbeSupervisor::start()
+{
+  if(thread_.joinable())
+    {
+      return;
+    }
+
+  pInternalSocket_.reset(zmq_socket(pContext_,ZMQ_PAIR));
+
+  if(!pInternalSocket_)
+    {
+      throw Toolkit::Exception{"unable to create supervisor socket: %s ",
+          zmq_strerror(errno)};
+    }
+
+  if(zmq_bind(pInternalSocket_.get(),InternalEndpoint) < 0)
+    {
+      throw Toolkit::Exception{"unable to bind supervisor socket: %s ",
+          zmq_strerror(errno)};
+    }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  for(auto & host : hosts_)
+    {
+      host.sPublishEndpoint_ = host.pProcess_->getProbePublishEndpoint();
+
+      watch(host);
+    }
+
+  thread_ = std::move(std::thread(&ProbeSupervisor::process,this));
+}
+
+void OpenTestPoint::ProbeSupervisor::stop()
+{
+  if(thread_.joinable())
+    {
+      zmq_send(pInternalSocket_.get(),"end",3,0);
+
+      thread_.join();
+
+      pInternalSocket_.reset(nullptr);
+    }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  for(auto & host : hosts_)
+    {
+      if(host.iPidFd_ >= 0)
+        {
+          close(host.iPidFd_);
+
+          host.iPidFd_ = -1;
+        }
+    }
+}
+
+std::vector<std::string> OpenTestPoint::ProbeSupervisor::getTopics() const
+{
+  return {std::string{HealthProbeName} + "." + sNodeId_,
+      selfMonitor_.getLogName(),
+      selfMonitor_.getLogServiceName()};
+}
+
+void OpenTestPoint::ProbeSupervisor::watch(Host & host)
+{
+  host.pid_ = host.pProcess_->getPid();
+
+  host.upTime_ = Clock::now();
+
+  if(host.iPidFd_ >= 0)
+    {
+      close(host.iPidFd_);
+    }
+
+  host.iPidFd_ = host.pid_ ? pidfdOpen(host.pid_) : -1;
+}
+
+void OpenTestPoint::ProbeSupervisor::process()
+{
+  try
+    {
+      Toolkit::RAIIZMQSocket pInternalSocket{zmq_socket(pContext_,ZMQ_PAIR)};
+
+      if(!pInternalSocket)
+        {
+          throw Toolkit::Exception{"unable to create supervisor socket: %s ",
+              zmq_strerror(errno)};
+        }
+
+      if(zmq_connect(pInternalSocket.get(),InternalEndpoint) < 0)
+        {
+          throw Toolkit::Exception{"unable to connect supervisor socket: %s ",
+              zmq_strerror(errno)};
+        }
+
+      Toolkit::RAIIZMQSocket pHealthSocket{zmq_socket(pContext_,ZMQ_PUB)};
+
+      if(!pHealthSocket)
+        {
+          throw Toolkit::Exception{"unable to create health socket: %s ",
+              zmq_strerror(errno)};
+        }
+
+      if(zmq_bind(pHealthSocket.get(),HealthEndpoint) < 0)
+        {
+          throw Toolkit::Exception{"unable to bind health socket: %s ",
+              zmq_strerror(errno)};
+        }
+
+      Toolkit::RAIIZMQSocket pRewireSocket{zmq_socket(pContext_,ZMQ_PUSH)};
+
+      if(!pRewireSocket)
+        {
+          throw Toolkit::Exception{"unable to create rewire socket: %s ",
+              zmq_strerror(errno)};
+        }
+
+      if(zmq_connect(pRewireSocket.get(),RewireEndpoint) < 0)
+        {
+          throw Toolkit::Exception{"unable to connect rewire socket: %s ",
+              zmq_strerror(errno)};
+        }
+
+      auto healthTime = Clock::now();
+
+      auto logTime = healthTime + LogInterval;
+
+      bool bRun{true};
+
+      while(bRun)
+        {
+          std::vector<zmq_pollitem_t> items =
+            {
+              {pInternalSocket.get(),0,ZMQ_POLLIN,0},
+            };
+
+          std::unique_lock<std::mutex> lock(mutex_);
+
+          auto wakeTime = std::min(healthTime,logTime);
+
+          bool bPolling{};
+
+          for(const auto & host : hosts_)
+            {
+              if(host.pid_)
+                {
+                  if(host.iPidFd_ >= 0)
+                    {
+                      items.push_back({nullptr,host.iPidFd_,ZMQ_POLLIN,0});
+                    }
+                  else
+                    {
+                      bPolling = true;
+                    }
+                }
+              else
+                {
+                  wakeTime = std::min(wakeTime,host.restartTime_);
+                }
+            }
+
+          auto timeout =
+            std::max(std::chrono::duration_cast<std::chrono::milliseconds>(wakeTime - Clock::now()),
+                     std::chrono::milliseconds::zero());
+
+          if(bPolling)
+            {
+              timeout = std::min(timeout,PollInterval);
+            }
+
+          // hosts may be added or removed while polling
+          lock.unlock();
+
+          if(zmq_poll(&items[0],items.size(),timeout.count()) < 0)
+            {
+              continue;
+            }
+
+          if(items[0].revents & ZMQ_POLLIN)
+            {
+              zmq_msg_t message;
+
+              zmq_msg_init(&message);
+
+              zmq_msg_recv(&message,pInternalSocket.get(),0);
+
+              // anything other than end is a wake up
+              bRun = zmq_msg_size(&message) != 3;
+
+              zmq_msg_close(&message);
+
+              continue;
+            }
+
+          lock.lock();
+
+          std::vector<std::shared_ptr<ProbeProcess>> restarts{};
+
+          for(auto & host : hosts_)
+            {
+              if(host.pid_)
+                {
+                  int iStatus{};
+
+                  if(waitpid(host.pid_,&iStatus,WNOHANG) == host.pid_)
+                    {
+                      exited(host,iStatus);
+                    }
+                }
+              else if(Clock::now() >= host.restartTime_)
+                {
+                  restarts.push_back(host.pProcess_);
+                }
+            }
+
+          for(const auto & pProcess : restarts)
+            {
+              restart(lock,pProcess,pRewireSocket.get());
+            }
+
+          // a table that fails to publish is skipped, supervision
+          // continues
+          if(Clock::now() >= healthTime)
+            {
+              try
+                {
+                  publishHealth(pHealthSocket.get());
+                }
+              catch(std::exception & exp)
+                {
+                  OPENTESTPOINT_TOOLKIT_LOG_FN_ERROR(logIdentifierCallable_,
+                                                     "unable to publish health: %s",
+                                                     exp.what());
+                }
+
+              healthTime = std::max(healthTime + HealthInterval,Clock::now());
+            }
+
+          if(Clock::now() >= logTime)
+            {
+              try
+                {
+                  publishLog(pHealthSocket.get());
+                }
+              catch(std::exception & exp)
+                {
+                  OPENTESTPOINT_TOOLKIT_LOG_FN_ERROR(logIdentifierCallable_,
+                                                     "unable to publish log statistics: %s",
+                                                     exp.what());
+                }
+
+              logTime = std::max(logTime + LogInterval,Clock::now());
+            }
+        }
+    }
+  catch(std::exception & exp)
+    {
+      std::cerr<<exp.what()<<std::endl;
+    }
+  catch(...)
+    {}
+}
+
+void OpenTestPoint::ProbeSupervisor::exited(Host & host, int iStatus)
+{
+  if(WIFSIGNALED(iStatus))
+    {
+      OPENTESTPOINT_TOOLKIT_LOG_FN_ERROR(logIdentifierCallable_,
+                                         "host %s pid %d killed by signal %d",
+                                         host.pProcess_->getHostId().c_str(),
+                                         host.pid_,
+                                         WTERMSIG(iStatus));
+    }
+  else
+    {
+      OPENTESTPOINT_TOOLKIT_LOG_FN_ERROR(logIdentifierCallable_,
+                                         "host %s pid %d exited with status %d",
+                                         host.pProcess_->getHostId().c_str(),
+                                         host.pid_,
+                                         WEXITSTATUS(iStatus));
+    }
+
+  if(host.iPidFd_ >= 0)
+    {
+      close(host.iPidFd_);
+
+      host.iPidFd_ = -1;
+    }
+
+  host.pid_ = 0;
+
+  host.pProcess_->exited();
+
+  auto now = Clock::now();
+
+  if(now - host.upTime_ >= StableInterval)
+    {
+      host.backoff_ = InitialBackoff;
+    }
+
+  host.downSince_ = now;
+
+  host.restartTime_ = now + host.backoff_;
+
+  OPENTESTPOINT_TOOLKIT_LOG_FN_INFO(logIdentifierCallable_,
+                                    "host %s restart in %lld msec",
+                                    host.pProcess_->getHostId().c_str(),
+                                    static_cast<long long>(host.backoff_.count()));
+
+  host.backoff_ = std::min(host.backoff_ * 2,MaximumBackoff);
+}
+
+OpenTestPoint::ProbeSupervisor::Host *
+OpenTestPoint::ProbeSupervisor::find(const std::shared_ptr<ProbeProcess> & pProcess)
+{
+  auto iter = std::find_if(hosts_.begin(),
+                           hosts_.end(),
+                           [&pProcess](const Host & host)
+                           {
+                             return host.pProcess_ == pProcess;
+                           });
+
+  return iter != hosts_.end() ? &*iter : nullptr;
+}
+
+void OpenTestPoint::ProbeSupervisor::restart(std::unique_lock<std::mutex> & lock,
+                                             std::shared_ptr<ProbeProcess> pProcess,
+                                             void * pRewireSocket)
+{
+  auto pHost = find(pProcess);
+
+  if(!pHost)
+    {
+      return;
+    }
+
+  // remove() waits while the host is restarting, so the containers
+  // remain valid with the lock released. Hosts may be added, the
+  // host is found again once the lock is reacquired.
+  pHost->bRestarting_ = true;
+
+  auto containers = pHost->containers_;
+
+  auto sPreviousEndpoint = pHost->sPublishEndpoint_;
+
+  auto sPreviousLogControlEndpoint = pProcess->getLogControlEndpoint();
+
+  auto sPreviousLogPublishEndpoint = pProcess->getLogPublishEndpoint();
+
+  lock.unlock();
+
+  std::string sError{};
+
+  try
+    {
+      pProcess->restart();
+    }
+  catch(Toolkit::Exception & exp)
+    {
+      sError = exp.what();
+    }
+
+  std::set<std::string> topics{};
+
+  bool bRecovered{sError.empty()};
+
+  if(bRecovered)
+    {
+      for(auto pContainer : containers)
+        {
+          ProbeNames probeNames{};
+
+          bRecovered = pContainer->recover(probeNames) && bRecovered;
+
+          topics.insert(probeNames.begin(),probeNames.end());
+        }
+    }
+
+  // known once the replacement reports ready, it logs even if its
+  // probes fail to recover
+  if(!pProcess->getLogControlEndpoint().empty() &&
+     pProcess->getLogControlEndpoint() != sPreviousLogControlEndpoint)
+    {
+      logEndpointsCallable_(sPreviousLogControlEndpoint,
+                            sPreviousLogPublishEndpoint,
+                            pProcess->getLogControlEndpoint(),
+                            pProcess->getLogPublishEndpoint());
+    }
+
+  if(bRecovered)
+    {
+      OpenTestPoint::ControllerCommand command;
+
+      command.set_type(OpenTestPoint::ControllerCommand::TYPE_REWIRE);
+
+      auto pRewire = command.mutable_rewire();
+
+      pRewire->set_previous(sPreviousEndpoint);
+
+      pRewire->set_publish(pProcess->getProbePublishEndpoint());
+
+      for(const auto & topic : topics)
+        {
+          pRewire->add_topics(topic);
+        }
+
+      std::string sSerialization;
+
+      if(command.SerializeToString(&sSerialization))
+        {
+          // never block on a controller that is shutting down
+          zmq_send(pRewireSocket,sSerialization.c_str(),sSerialization.length(),ZMQ_DONTWAIT);
+        }
+      else
+        {
+          OPENTESTPOINT_TOOLKIT_LOG_FN_ERROR(logIdentifierCallable_,
+                                             "host %s unable to serialize rewire message",
+                                             pProcess->getHostId().c_str());
+        }
+    }
+
+  lock.lock();
+
+  pHost = find(pProcess);
+
+  pHost->bRestarting_ = false;
+
+  restartCondition_.notify_all();
+
+  if(!sError.empty())
+    {
+      OPENTESTPOINT_TOOLKIT_LOG_FN_ERROR(logIdentifierCallable_,
+                                         "host %s restart failed: %s",
+                                         pProcess->getHostId().c_str(),
+                                         sError.c_str());
+
+      pHost->restartTime_ = Clock::now() + pHost->backoff_;
+
+      pHost->backoff_ = std::min(pHost->backoff_ * 2,MaximumBackoff);
+
+      return;
+    }
+
+  ++pHost->u32Restarts_;
+
+  watch(*pHost);
+
+  if(!bRecovered)
+    {
+      // exit is detected and the restart retried after backoff
+      OPENTESTPOINT_TOOLKIT_LOG_FN_ERROR(logIdentifierCallable_,
+                                         "host %s recovery failed, sending kill to %d",
+                                         pProcess->getHostId().c_str(),
+                                         pHost->pid_);
+
+      kill(pHost->pid_,SIGKILL);
+
+      return;
+    }
+
+  pHost->downDuration_ += Clock::now() - pHost->downSince_;
+
+  pHost->sPublishEndpoint_ = pProcess->getProbePublishEndpoint();
+
+  OPENTESTPOINT_TOOLKIT_LOG_FN_INFO(logIdentifierCallable_,
+                                    "host %s restarted pid %d",
+                                    pProcess->getHostId().c_str(),
+                                    pHost->pid_);
+}
+
+void OpenTestPoint::ProbeSupervisor::publishHealth(void * pHealthSocket)
+{
+  OpenTestPoint::MeasurementTable table;
+
+  for(const auto & sLabel : {"Host","PID","State","Restarts","Downtime"})
+    {
+      table.add_labels(sLabel);
+    }
+
+  auto now = Clock::now();
+
+  for(const auto & host : hosts_)
+    {
+      auto pRow = table.add_rows();
+
+      auto pValue = pRow->add_values();
+      pValue->set_type(OpenTestPoint::MeasurementTable::Measurement::TYPE_STRING);
+      pValue->set_svalue(host.pProcess_->getHostId());
+
+      pValue = pRow->add_values();
+      pValue->set_type(OpenTestPoint::MeasurementTable::Measurement::TYPE_UINTEGER);
+      pValue->set_uvalue(host.pid_);
+
+      pValue = pRow->add_values();
+      pValue->set_type(OpenTestPoint::MeasurementTable::Measurement::TYPE_STRING);
+      pValue->set_svalue(host.pid_ ? "up" : "down");
+
+      pValue = pRow->add_values();
+      pValue->set_type(OpenTestPoint::MeasurementTable::Measurement::TYPE_UINTEGER);
+      pValue->set_uvalue(host.u32Restarts_);
+
+      // total downtime including any current outage, in seconds
+      auto downDuration = host.downDuration_;
+
+      if(!host.pid_)
+        {
+          downDuration += now - host.downSince_;
+        }
+
+      pValue = pRow->add_values();
+      pValue->set_type(OpenTestPoint::MeasurementTable::Measurement::TYPE_DOUBLE);
+      pValue->set_dvalue(std::chrono::duration_cast<std::chrono::duration<double>>(downDuration).count());
+    }
+
+  const std::string sTopic{std::string{HealthProbeName} + "." + sNodeId_};
+
+  send(pHealthSocket,sTopic,selfMonitor_.serialize(sNodeId_,sTopic,table));
+}
+
+void OpenTestPoint::ProbeSupervisor::publishLog(void * pHealthSocket)
+{
+  send(pHealthSocket,selfMonitor_.getLogName(),selfMonitor_.logReport(sNodeId_));
+
+  send(pHealthSocket,
+       selfMonitor_.getLogServiceName(),
+       selfMonitor_.logServiceReport(sNodeId_,logService_));
+}
+
+void OpenTestPoint::ProbeSupervisor::send(void * pHealthSocket,
+                                          const std::string & sTopic,
+                                          const std::string & sSerialization)
+{
+  zmq_send(pHealthSocket,sTopic.c_str(),sTopic.length(),ZMQ_SNDMORE);
+
+  zmq_send(pHealthSocket,sSerialization.c_str(),sSerialization.length(),0);
+}
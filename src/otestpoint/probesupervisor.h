@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2026 - Adjacent Link LLC, Bridgewater, New Jersey
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  * Neither the name of Adjacent Link LLC nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * See toplevel COPYING for more information.
+ */
+
+#ifndef OPENTESTPOINT_PROBESUPERVISOR_HEADER_
+#define OPENTESTPOINT_PROBESUPERVISOR_HEADER_
+
+#include "otestpoint/toolkit/raiizmq.h"
+#include "otestpoint/toolkit/log/service.h"
+#include "probecontainer.h"
+#include "selfmonitor.h"
+
+#include <functional>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <uuid.h>
+
+namespace OpenTestPoint
+{
+  /**
+   * @class ProbeSupervisor
+   *
+   * @brief Restarts otestpoint-probe host processes that exit
+   * unexpectedly.
+   *
+   * Host processes are watched using a pidfd, falling back to
+   * periodic waitpid() polling when unavailable. A host that exits
+   * is restarted with exponential backoff and its probes are
+   * recovered to their requested lifecycle state. The controller is
+   * sent a rewire command with the new publish endpoint. Restart
+   * counts and downtime are published as a health measurement table,
+   * along with the log client and log service counters of the
+   * process.
+   */
+  class ProbeSupervisor
+  {
+  public:
+    static const char * HealthEndpoint;
+    static const char * RewireEndpoint;
+    static const char * HealthProbeName;
+
+    // called from the supervisor thread when a host process is
+    // restarted, with the log endpoints of the exited process and of
+    // its replacement
+    using LogEndpointsCallable = std::function<void (const std::string & sPreviousControlEndpoint,
+                                                     const std::string & sPreviousPublishEndpoint,
+                                                     const std::string & sControlEndpoint,
+                                                     const std::string & sPublishEndpoint)>;
+
+    ProbeSupervisor(void * pContext,
+                    const std::string & sNodeId,
+                    const uuid_t & uuid,
+                    const Toolkit::Log::Service & logService,
+                    LogEndpointsCallable logEndpointsCallable);
+
+    ~ProbeSupervisor();
+
+    // supervision of hosts added after start() begins immediately,
+    // add once the probe is initialized
+    void add(ProbeContainer * pContainer);
+
+    // ends supervision of a probe, a host without probes is no
+    // longer supervised, call before the probe is destroyed. Waits
+    // for a restart of the probe's host in progress to complete.
+    void remove(ProbeContainer * pContainer);
+
+    // begins supervision, call once probes are initialized
+    void start();
+
+    // ends supervision, call before probes are destroyed
+    void stop();
+
+    // topics published on the health endpoint, suffixed with the
+    // node id like every probe topic
+    std::vector<std::string> getTopics() const;
+
+  private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Host
+    {
+      std::shared_ptr<ProbeProcess> pProcess_;
+      std::vector<ProbeContainer *> containers_;
+      pid_t pid_;
+      int iPidFd_;
+      std::string sPublishEndpoint_;
+      std::uint32_t u32Restarts_;
+      std::chrono::milliseconds backoff_;
+      Clock::time_point upTime_;
+      Clock::time_point downSince_;
+      Clock::time_point restartTime_;
+      Clock::duration downDuration_;
+      bool bRestarting_;
+    };
+
+    void * pContext_;
+    const Toolkit::Log::Service & logService_;
+    LogEndpointsCallable logEndpointsCallable_;
+    std::string sNodeId_;
+    // serializes the supervisor tables, named by node so its log
+    // tables are OpenTestPoint.Log.<node> and
+    // OpenTestPoint.LogService.<node>
+    SelfMonitor selfMonitor_;
+    std::vector<Host> hosts_;
+    std::mutex mutex_;
+    std::condition_variable restartCondition_;
+    Toolkit::RAIIZMQSocket pInternalSocket_;
+    std::thread thread_;
+
+    std::function<std::list<std::string>()> logIdentifierCallable_;
+
+    void process();
+
+    void watch(Host & host);
+
+    void exited(Host & host, int iStatus);
+
+    Host * find(const std::shared_ptr<ProbeProcess> & pProcess);
+
+    void restart(std::unique_lock<std::mutex> & lock,
+                 std::shared_ptr<ProbeProcess> pProcess,
+                 void * pRewireSocket);
+
+    void publishHealth(void * pHealthSocket);
+
+    void publishLog(void * pHealthSocket);
+
+    void send(void * pHealthSocket,
+              const std::string & sTopic,
+              const std::string & sSerialization);
+  };
+}
+
+#endif // OPENTESTPOINT_PROBESUPERVISOR_HEADER_
@@ -0,0 +1,240 @@
+/*
+ * Copyright (c) 2026 - Adjacent Link LLC, Bridgewater, New Jersey
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  * Neither the name of Adjacent Link LLC nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * See toplevel COPYING for more information.
+ */
+
+#include "probezygote.h"
+#include "otestpoint/toolkit/servicesingleton.h"
+
+#include <cstring>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <list>
+#include <unistd.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+
+#ifndef HAVE_SECURE_GETENV
+#  ifdef HAVE___SECURE_GETENV
+#    define secure_getenv __secure_getenv
+#  else
+#    error neither secure_getenv nor __secure_getenv is available
+#  endif
+#endif
+
+namespace
+{
+  // the first spawn waits for the zygote to initialize
+  const timeval SpawnTimeout{10,0};
+
+  std::list<std::string> logIdentifier()
+  {
+    return {"/zygote"};
+  }
+}
+
+OpenTestPoint::ProbeZygote::ProbeZygote():
+  iFd_{-1},
+  pid_{}{}
+
+OpenTestPoint::ProbeZygote::~ProbeZygote()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  stop_i();
+}
+
+pid_t OpenTestPoint::ProbeZygote::spawn(const std::vector<std::string> & environment)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  if(iFd_ < 0 && !start_i())
+    {
+      return 0;
+    }
+
+  // one datagram of nul terminated environment entries
+  std::string sRequest{};
+
+  for(const auto & sEntry : environment)
+    {
+      sRequest.append(sEntry);
+      sRequest.push_back('\0');
+    }
+
+  if(send(iFd_,sRequest.data(),sRequest.size(),MSG_NOSIGNAL) < 0)
+    {
+      OPENTESTPOINT_TOOLKIT_LOG_FN_ERROR(logIdentifier,
+                                         "unable to send spawn request: %s",
+                                         strerror(errno));
+      stop_i();
+
+      return 0;
+    }
+
+  std::int32_t i32Pid{};
+
+  if(recv(iFd_,&i32Pid,sizeof(i32Pid),0) != sizeof(i32Pid))
+    {
+      OPENTESTPOINT_TOOLKIT_LOG_FN_ERROR(logIdentifier,
+                                         "no spawn response");
+      stop_i();
+
+      return 0;
+    }
+
+  if(i32Pid < 0)
+    {
+      OPENTESTPOINT_TOOLKIT_LOG_FN_ERROR(logIdentifier,
+                                         "unable to fork: %s",
+                                         strerror(-i32Pid));
+      return 0;
+    }
+
+  return i32Pid;
+}
+
+bool OpenTestPoint::ProbeZygote::start_i()
+{
+  int fds[2];
+
+  if(socketpair(AF_UNIX,SOCK_SEQPACKET | SOCK_CLOEXEC,0,fds))
+    {
+      OPENTESTPOINT_TOOLKIT_LOG_FN_ERROR(logIdentifier,
+                                         "unable to create zygote channel: %s",
+                                         strerror(errno));
+      return false;
+    }
+
+  setsockopt(fds[0],SOL_SOCKET,SO_RCVTIMEO,&SpawnTimeout,sizeof(SpawnTimeout));
+
+  pid_ = fork();
+
+  switch(pid_)
+    {
+    case 0:
+      // child
+      {
+        // the zygote end of the channel survives exec
+        fcntl(fds[1],F_SETFD,0);
+
+        std::string sZygoteEnv{"zygote="};
+        sZygoteEnv.append(std::to_string(fds[1]));
+
+        std::string sPythonPathEnv{"PYTHONPATH="};
+
+        const char * pzPYTHON_PATH=secure_getenv("PYTHONPATH");
+
+        if(pzPYTHON_PATH)
+          {
+            sPythonPathEnv.append(pzPYTHON_PATH);
+          }
+
+        std::string sLDLibraryPathEnv{"LD_LIBRARY_PATH="};
+
+        const char * pzLD_LIBRARY_PATH=secure_getenv("LD_LIBRARY_PATH");
+
+        if(pzLD_LIBRARY_PATH)
+          {
+            sLDLibraryPathEnv.append(pzLD_LIBRARY_PATH);
+          }
+
+        const char * const argv[] = {"otestpoint-probe",0};
+
+        const char * const envp[] =
+          {
+            sZygoteEnv.c_str(),
+            sPythonPathEnv.c_str(),
+            sLDLibraryPathEnv.c_str(),
+            0};
+
+        if(execvpe("otestpoint-probe",
+                   const_cast<char **>(argv),
+                   const_cast<char **>(&envp[0])) < 0)
+          {
+            std::cerr<<"unable to start zygote: "<<strerror(errno)<<std::endl;
+          }
+
+        exit(1);
+      }
+      break;
+
+    case -1:
+      // error
+      OPENTESTPOINT_TOOLKIT_LOG_FN_ERROR(logIdentifier,
+                                         "unable to start zygote: %s",
+                                         strerror(errno));
+      pid_ = 0;
+      close(fds[0]);
+      close(fds[1]);
+      return false;
+
+    default:
+      //parent
+      break;
+    }
+
+  close(fds[1]);
+
+  iFd_ = fds[0];
+
+  OPENTESTPOINT_TOOLKIT_LOG_FN_INFO(logIdentifier,
+                                    "started pid %d",
+                                    pid_);
+  return true;
+}
+
+void OpenTestPoint::ProbeZygote::stop_i()
+{
+  if(iFd_ >= 0)
+    {
+      // the zygote exits when its channel closes
+      close(iFd_);
+
+      iFd_ = -1;
+    }
+
+  if(pid_)
+    {
+      if(waitpid(pid_,nullptr,WNOHANG) != pid_)
+        {
+          kill(pid_,SIGKILL);
+
+          waitpid(pid_,nullptr,0);
+        }
+
+      pid_ = 0;
+    }
+}
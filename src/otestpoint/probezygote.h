@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2026 - Adjacent Link LLC, Bridgewater, New Jersey
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  * Neither the name of Adjacent Link LLC nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * See toplevel COPYING for more information.
+ */
+#ifndef OPENTESTPOINT_PROBEZYGOTE_HEADER_
+#define OPENTESTPOINT_PROBEZYGOTE_HEADER_
+
+#include "otestpoint/toolkit/singleton.h"
+
+#include <mutex>
+#include <string>
+#include <vector>
+#include <sys/types.h>
+
+namespace OpenTestPoint
+{
+  /**
+   * @class ProbeZygote
+   *
+   * @brief A pre-initialized otestpoint-probe that forks host
+   * processes on request.
+   *
+   * The zygote is an otestpoint-probe started with the Python
+   * interpreter initialized and common modules imported. Host
+   * processes are forked from it as children of the calling process,
+   * so they are supervised and reaped exactly like an exec'd
+   * otestpoint-probe. The zygote is started on first use and exits
+   * when the calling process does.
+   */
+  class ProbeZygote : public Toolkit::Singleton<ProbeZygote>
+  {
+  public:
+    ~ProbeZygote();
+
+    /**
+     * Forks a host process
+     *
+     * @param environment Host process environment entries in
+     * name=value form
+     *
+     * @return pid of the host process or 0 if the zygote is
+     * unavailable
+     */
+    pid_t spawn(const std::vector<std::string> & environment);
+
+  protected:
+    ProbeZygote();
+
+  private:
+    std::mutex mutex_;
+    int iFd_;
+    pid_t pid_;
+
+    bool start_i();
+
+    void stop_i();
+  };
+}
+
+#endif // OPENTESTPOINT_PROBEZYGOTE_HEADER_
@@ -64,7 +64,8 @@ void OpenTestPoint::RecorderBuilder::buildRecorder(Toolkit::Log::Service & logSe
     {
       pImpl_->pRecorderImpl_.reset(new RecorderImpl{logService,
             logClient,
-            sRecordFileName});
+            sRecordFileName,
+            pImpl_->uuid_});
     }
   else
     {
@@ -65,10 +65,13 @@ CREATE TABLE probes (time INT,\
 
 OpenTestPoint::RecorderImpl::RecorderImpl(Toolkit::Log::Service & logService,
                                           Toolkit::Log::Client & logClient,
-                                          const std::string & sRecordFileName):
+                                          const std::string & sRecordFileName,
+                                          const uuid_t & uuid):
   logService_(logService),
   logClient_(logClient)
 {
+  uuid_copy(uuid_,uuid);
+
   pContext_.reset(zmq_ctx_new());
 
   if(!pContext_)
@@ -250,6 +253,9 @@ void OpenTestPoint::RecorderImpl::process()
       // subscribe to all logs
       zmq_send(pXSubSocket.get(),"\x1",1,0);
 
+      // recorded along with the probe reports
+      SelfMonitor selfMonitor{"recorder",uuid_};
+
       bool bRun{true};
 
       while(bRun)
@@ -260,7 +266,9 @@ void OpenTestPoint::RecorderImpl::process()
               {pXSubSocket.get(),0,ZMQ_POLLIN,0},
             };
 
-          int rc = zmq_poll(&items[0],items.size(),-1);
+          int rc = zmq_poll(&items[0],items.size(),selfMonitor.timeout());
+
+          selfMonitor.iteration();
 
           if(rc == -1)
             {
@@ -378,50 +386,17 @@ void OpenTestPoint::RecorderImpl::process()
                               sProbeName = std::string{reinterpret_cast<const char *>(zmq_msg_data(&message)),
                                                        zmq_msg_size(&message)};
                             }
+                          else if(record(sProbeName,
+                                         zmq_msg_data(&message),
+                                         zmq_msg_size(&message),
+                                         pLogClient.get()))
+                            {
+                              selfMonitor.forwarded(SelfMonitor::Direction::PUBLISH,
+                                                    zmq_msg_size(&message));
+                            }
                           else
                             {
-                              OpenTestPoint::ProbeReport report{};
-                              char buf[64];
-
-                              if(report.ParseFromArray(zmq_msg_data(&message),
-                                                       zmq_msg_size(&message)))
-                                {
-                                  std::stringstream sstream{};
-
-                                  uuid_unparse(reinterpret_cast<const unsigned char *>(report.uuid().data()),buf);
-
-                                  sstream<<"INSERT INTO probes VALUES ("
-                                         <<report.timestamp()<<","
-                                         <<"'"<<buf<<"',"
-                                         <<"'"<<sProbeName<<"',"
-                                         <<"'"<<report.tag()<<"',"
-                                         <<"'"<<report.index()<<"',"
-                                         <<recorderFile_.tellp()+4L<<","
-                                         <<zmq_msg_size(&message)<<");";
-
-                                  char * pzErrMsg{};
-
-                                  if(sqlite3_exec(pSQLiteDB_.get(),sstream.str().c_str(), nullptr, nullptr, &pzErrMsg) == SQLITE_OK)
-                                    {
-                                      std::uint32_t u32MessageLength{htonl(static_cast<uint32_t>(zmq_msg_size(&message)))};
-
-                                      recorderFile_.write(reinterpret_cast<const char *>(&u32MessageLength),
-                                                          sizeof(u32MessageLength));
-
-                                      recorderFile_.write(reinterpret_cast<const char *>(zmq_msg_data(&message)),
-                                                          zmq_msg_size(&message)).flush();
-                                    }
-                                  else
-                                    {
-                                      char * pzErrMsg{};
-
-                                      pLogClient->log(OpenTestPoint::Toolkit::Log::Level::ERROR_LEVEL,
-                                                      "unable to insert probe database info %s",
-                                                      pzErrMsg);
-
-                                      sqlite3_free(pzErrMsg);
-                                    }
-                                }
+                              selfMonitor.dropped(SelfMonitor::Direction::PUBLISH);
                             }
 
                           zmq_msg_close(&message);
@@ -436,8 +411,90 @@ void OpenTestPoint::RecorderImpl::process()
                     }
                 }
             }
+
+          if(selfMonitor.due())
+            {
+              const std::string & sSerialization{selfMonitor.report({})};
+
+              if(!record(selfMonitor.getName(),
+                         sSerialization.data(),
+                         sSerialization.size(),
+                         pLogClient.get()))
+                {
+                  selfMonitor.dropped(SelfMonitor::Direction::PUBLISH);
+                }
+
+              const std::string & sLogSerialization{selfMonitor.logReport({})};
+
+              if(!record(selfMonitor.getLogName(),
+                         sLogSerialization.data(),
+                         sLogSerialization.size(),
+                         pLogClient.get()))
+                {
+                  selfMonitor.dropped(SelfMonitor::Direction::PUBLISH);
+                }
+
+              const std::string & sLogServiceSerialization{selfMonitor.logServiceReport({},logService_)};
+
+              if(!record(selfMonitor.getLogServiceName(),
+                         sLogServiceSerialization.data(),
+                         sLogServiceSerialization.size(),
+                         pLogClient.get()))
+                {
+                  selfMonitor.dropped(SelfMonitor::Direction::PUBLISH);
+                }
+            }
         }
     }
   catch(...)
     {}
 }
+
+bool OpenTestPoint::RecorderImpl::record(const std::string & sProbeName,
+                                         const void * pData,
+                                         std::size_t size,
+                                         Toolkit::Log::Client * pLogClient)
+{
+  OpenTestPoint::ProbeReport report{};
+  char buf[64];
+
+  if(!report.ParseFromArray(pData,size))
+    {
+      return false;
+    }
+
+  std::stringstream sstream{};
+
+  uuid_unparse(reinterpret_cast<const unsigned char *>(report.uuid().data()),buf);
+
+  sstream<<"INSERT INTO probes VALUES ("
+         <<report.timestamp()<<","
+         <<"'"<<buf<<"',"
+         <<"'"<<sProbeName<<"',"
+         <<"'"<<report.tag()<<"',"
+         <<"'"<<report.index()<<"',"
+         <<recorderFile_.tellp()+4L<<","
+         <<size<<");";
+
+  char * pzErrMsg{};
+
+  if(sqlite3_exec(pSQLiteDB_.get(),sstream.str().c_str(), nullptr, nullptr, &pzErrMsg) != SQLITE_OK)
+    {
+      pLogClient->log(OpenTestPoint::Toolkit::Log::Level::ERROR_LEVEL,
+                      "unable to insert probe database info %s",
+                      pzErrMsg);
+
+      sqlite3_free(pzErrMsg);
+
+      return false;
+    }
+
+  std::uint32_t u32MessageLength{htonl(static_cast<uint32_t>(size))};
+
+  recorderFile_.write(reinterpret_cast<const char *>(&u32MessageLength),
+                      sizeof(u32MessageLength));
+
+  recorderFile_.write(reinterpret_cast<const char *>(pData),size).flush();
+
+  return true;
+}
@@ -40,10 +40,12 @@
 #include "otestpoint/toolkit/log/client.h"
 #include "otestpoint/toolkit/raiizmq.h"
 #include "otestpoint/toolkit/raiisqlite3.h"
+#include "selfmonitor.h"
 
 #include <string>
 #include <thread>
 #include <fstream>
+#include <uuid.h>
 
 namespace OpenTestPoint
 {
@@ -53,7 +55,8 @@ namespace OpenTestPoint
   public:
     RecorderImpl(Toolkit::Log::Service & logService,
                  Toolkit::Log::Client & logClient,
-                 const std::string & sRecorderFileName);
+                 const std::string & sRecorderFileName,
+                 const uuid_t & uuid);
 
     ~RecorderImpl();
 
@@ -74,9 +77,16 @@ namespace OpenTestPoint
     Toolkit::Log::Client & logClient_;
     std::ofstream recorderFile_;
     Toolkit::RAIISQLiteDB pSQLiteDB_;
+    uuid_t uuid_;
     std::thread thread_;
 
     void process();
+
+    // appends a probe report to the record file and database
+    bool record(const std::string & sProbeName,
+                const void * pData,
+                std::size_t size,
+                Toolkit::Log::Client * pLogClient);
   };
 }
 
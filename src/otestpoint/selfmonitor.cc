@@ -0,0 +1,221 @@
+/*
+ * Copyright (c) 2026 - Adjacent Link LLC, Bridgewater, New Jersey
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  * Neither the name of Adjacent Link LLC nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * See toplevel COPYING for more information.
+ */
+
+#include "selfmonitor.h"
+#include "otestpoint/types.h"
+#include "otestpoint/toolkit/exception.h"
+#include "logtables.h"
+#include "probereport.pb.h"
+
+#include <algorithm>
+#include <limits>
+
+const char * OpenTestPoint::SelfMonitor::ProbeName = "OpenTestPoint.Self";
+
+namespace
+{
+  const std::chrono::seconds ReportInterval{10};
+
+  void addRow(OpenTestPoint::MeasurementTable & table,
+              const std::string & sName,
+              std::uint64_t u64Value)
+  {
+    auto pRow = table.add_rows();
+
+    auto pValue = pRow->add_values();
+    pValue->set_type(OpenTestPoint::MeasurementTable::Measurement::TYPE_STRING);
+    pValue->set_svalue(sName);
+
+    pValue = pRow->add_values();
+    pValue->set_type(OpenTestPoint::MeasurementTable::Measurement::TYPE_UINTEGER);
+    pValue->set_uvalue(u64Value);
+  }
+
+  void addRow(OpenTestPoint::MeasurementTable & table,
+              const std::string & sName,
+              const std::string & sValue)
+  {
+    auto pRow = table.add_rows();
+
+    auto pValue = pRow->add_values();
+    pValue->set_type(OpenTestPoint::MeasurementTable::Measurement::TYPE_STRING);
+    pValue->set_svalue(sName);
+
+    pValue = pRow->add_values();
+    pValue->set_type(OpenTestPoint::MeasurementTable::Measurement::TYPE_STRING);
+    pValue->set_svalue(sValue);
+  }
+}
+
+OpenTestPoint::SelfMonitor::SelfMonitor(const std::string & sComponent,
+                                        const uuid_t & uuid):
+  sName_{std::string{ProbeName} + "." + sComponent},
+  sLogName_{"OpenTestPoint.Log." + sComponent},
+  sLogServiceName_{"OpenTestPoint.LogService." + sComponent},
+  reportTime_{Clock::now() + ReportInterval},
+  u64Iterations_{},
+  counters_{},
+  u64DiscoveryRequests_{},
+  u64DiscoveryTotalUsec_{},
+  u64DiscoveryMaxUsec_{}
+{
+  uuid_copy(uuid_,uuid);
+}
+
+const std::string & OpenTestPoint::SelfMonitor::getName() const
+{
+  return sName_;
+}
+
+void OpenTestPoint::SelfMonitor::discovery(const Clock::duration & latency)
+{
+  std::uint64_t u64Usec = std::chrono::duration_cast<std::chrono::microseconds>(latency).count();
+
+  ++u64DiscoveryRequests_;
+
+  u64DiscoveryTotalUsec_ += u64Usec;
+
+  u64DiscoveryMaxUsec_ = std::max(u64DiscoveryMaxUsec_,u64Usec);
+}
+
+long OpenTestPoint::SelfMonitor::timeout() const
+{
+  return std::max(0L,
+                  static_cast<long>(std::chrono::duration_cast<std::chrono::milliseconds>
+                                    (reportTime_ - Clock::now()).count()));
+}
+
+bool OpenTestPoint::SelfMonitor::due() const
+{
+  return Clock::now() >= reportTime_;
+}
+
+const std::string & OpenTestPoint::SelfMonitor::report(const std::string & sTag,
+                                                       const Status & status)
+{
+  reportTime_ = std::max(reportTime_ + ReportInterval,Clock::now());
+
+  OpenTestPoint::MeasurementTable table;
+
+  table.add_labels("Metric");
+  table.add_labels("Value");
+
+  addRow(table,"Iterations",u64Iterations_);
+
+  const char * directions[] = {"Publish","Subscribe"};
+
+  for(std::size_t i = 0; i < 2; ++i)
+    {
+      std::string sDirection{directions[i]};
+
+      addRow(table,sDirection + " Messages",counters_[i].u64Messages);
+      addRow(table,sDirection + " Bytes",counters_[i].u64Bytes);
+      addRow(table,sDirection + " Drops",counters_[i].u64Drops);
+    }
+
+  addRow(table,"Discovery Requests",u64DiscoveryRequests_);
+
+  addRow(table,
+         "Discovery Mean(us)",
+         u64DiscoveryRequests_ ? u64DiscoveryTotalUsec_ / u64DiscoveryRequests_ : 0);
+
+  addRow(table,"Discovery Max(us)",u64DiscoveryMaxUsec_);
+
+  for(const auto & entry : status)
+    {
+      addRow(table,entry.first,entry.second);
+    }
+
+  return serialize(sTag,sName_,table);
+}
+
+const std::string & OpenTestPoint::SelfMonitor::getLogName() const
+{
+  return sLogName_;
+}
+
+const std::string & OpenTestPoint::SelfMonitor::getLogServiceName() const
+{
+  return sLogServiceName_;
+}
+
+const std::string & OpenTestPoint::SelfMonitor::logReport(const std::string & sTag)
+{
+  OpenTestPoint::MeasurementTable table;
+
+  LogTables::clients(table);
+
+  return serialize(sTag,sLogName_,table);
+}
+
+const std::string & OpenTestPoint::SelfMonitor::logServiceReport(const std::string & sTag,
+                                                                 const Toolkit::Log::Service & logService)
+{
+  OpenTestPoint::MeasurementTable table;
+
+  LogTables::service(table,logService.getStatistics());
+
+  return serialize(sTag,sLogServiceName_,table);
+}
+
+const std::string & OpenTestPoint::SelfMonitor::serialize(const std::string & sTag,
+                                                          const std::string & sName,
+                                                          const MeasurementTable & table)
+{
+  OpenTestPoint::ProbeReport report;
+
+  report.set_index(std::numeric_limits<ProbeIndex>::max());
+  report.set_tag(sTag);
+  report.set_uuid(reinterpret_cast<const char *>(uuid_),sizeof(uuid_t));
+  report.set_timestamp(std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count());
+  report.set_type(OpenTestPoint::ProbeReport::TYPE_DATA);
+
+  auto pData = report.mutable_data();
+
+  pData->set_name("MeasurementTable");
+  pData->set_module("otestpoint.interface.measurementtable_pb2");
+  pData->set_version(1);
+
+  if(!table.SerializeToString(pData->mutable_blob()))
+    {
+      throw Toolkit::Exception{"unable to serialize %s table",sName.c_str()};
+    }
+
+  if(!report.SerializeToString(&sSerialization_))
+    {
+      throw Toolkit::Exception{"unable to serialize %s report",sName.c_str()};
+    }
+
+  return sSerialization_;
+}
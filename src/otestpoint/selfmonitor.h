@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2026 - Adjacent Link LLC, Bridgewater, New Jersey
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  * Neither the name of Adjacent Link LLC nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * See toplevel COPYING for more information.
+ */
+
+#ifndef OPENTESTPOINT_SELFMONITOR_HEADER_
+#define OPENTESTPOINT_SELFMONITOR_HEADER_
+
+#include "otestpoint/toolkit/log/service.h"
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+#include <uuid.h>
+
+namespace OpenTestPoint
+{
+  class MeasurementTable;
+
+  /**
+   * @class SelfMonitor
+   *
+   * @brief Event loop counters of a controller, broker or recorder.
+   *
+   * Counts poll loop iterations, messages and bytes forwarded in
+   * each direction, messages dropped by a failed send and discovery
+   * request latency. A report is a MeasurementTable of metric name
+   * and value rows published as OpenTestPoint.Self.<component>,
+   * along with the process log counters.
+   * Counters are not synchronized, use from the event loop thread.
+   */
+  class SelfMonitor
+  {
+  public:
+    static const char * ProbeName;
+
+    using Clock = std::chrono::steady_clock;
+
+    // name and value rows appended to a report
+    using Status = std::vector<std::pair<std::string,std::string>>;
+
+    enum class Direction
+    {
+      // probe reports toward subscribers
+      PUBLISH,
+      // subscriptions toward publishers
+      SUBSCRIBE,
+    };
+
+    SelfMonitor(const std::string & sComponent,
+                const uuid_t & uuid);
+
+    const std::string & getName() const;
+
+    void iteration()
+    {
+      ++u64Iterations_;
+    }
+
+    void forwarded(Direction direction, std::size_t bytes)
+    {
+      auto & counters = counters_[static_cast<std::size_t>(direction)];
+
+      ++counters.u64Messages;
+
+      counters.u64Bytes += bytes;
+    }
+
+    void dropped(Direction direction)
+    {
+      ++counters_[static_cast<std::size_t>(direction)].u64Drops;
+    }
+
+    void discovery(const Clock::duration & latency);
+
+    // milliseconds until the next report is due
+    long timeout() const;
+
+    bool due() const;
+
+    // serializes a ProbeReport holding the table and schedules the
+    // next report
+    const std::string & report(const std::string & sTag,
+                               const Status & status = {});
+
+    // OpenTestPoint.Log.<component> and OpenTestPoint.LogService.<component>
+    const std::string & getLogName() const;
+
+    const std::string & getLogServiceName() const;
+
+    // serializes a ProbeReport holding the process log client
+    // counters, one row per client. Sent along with report().
+    const std::string & logReport(const std::string & sTag);
+
+    // serializes a ProbeReport holding the log service counters
+    const std::string & logServiceReport(const std::string & sTag,
+                                         const Toolkit::Log::Service & logService);
+
+    // serializes a ProbeReport holding a table, sName identifies
+    // the table in errors
+    const std::string & serialize(const std::string & sTag,
+                                  const std::string & sName,
+                                  const MeasurementTable & table);
+
+  private:
+    struct Counters
+    {
+      std::uint64_t u64Messages{};
+      std::uint64_t u64Bytes{};
+      std::uint64_t u64Drops{};
+    };
+
+    std::string sName_;
+    std::string sLogName_;
+    std::string sLogServiceName_;
+    uuid_t uuid_;
+    Clock::time_point reportTime_;
+    std::uint64_t u64Iterations_;
+    Counters counters_[2];
+    std::uint64_t u64DiscoveryRequests_;
+    std::uint64_t u64DiscoveryTotalUsec_;
+    std::uint64_t u64DiscoveryMaxUsec_;
+    std::string sSerialization_;
+  };
+}
+
+#endif // OPENTESTPOINT_SELFMONITOR_HEADER_
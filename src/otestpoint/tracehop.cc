@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2026 - Adjacent Link LLC, Bridgewater, New Jersey
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  * Neither the name of Adjacent Link LLC nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * See toplevel COPYING for more information.
+ */
+
+#include "tracehop.h"
+#include "probereport.pb.h"
+
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/wire_format_lite.h>
+#include <chrono>
+#include <cstring>
+
+namespace
+{
+  using google::protobuf::io::CodedInputStream;
+  using google::protobuf::io::CodedOutputStream;
+  using google::protobuf::internal::WireFormatLite;
+
+  const std::uint32_t TRACE_TAG{WireFormatLite::MakeTag(OpenTestPoint::ProbeReport::kTraceFieldNumber,
+                                                        WireFormatLite::WIRETYPE_LENGTH_DELIMITED)};
+
+  const std::uint32_t HOPS_TAG{WireFormatLite::MakeTag(OpenTestPoint::ProbeReport::Trace::kHopsFieldNumber,
+                                                       WireFormatLite::WIRETYPE_LENGTH_DELIMITED)};
+
+  const std::uint32_t NAME_TAG{WireFormatLite::MakeTag(OpenTestPoint::ProbeReport::Trace::Hop::kNameFieldNumber,
+                                                       WireFormatLite::WIRETYPE_LENGTH_DELIMITED)};
+
+  const std::uint32_t TIMESTAMP_TAG{WireFormatLite::MakeTag(OpenTestPoint::ProbeReport::Trace::Hop::kTimestampFieldNumber,
+                                                            WireFormatLite::WIRETYPE_VARINT)};
+
+  // walks the top level fields, skipping over values without reading
+  // them
+  bool isTraced(const void * pData, std::size_t size)
+  {
+    CodedInputStream stream{static_cast<const std::uint8_t *>(pData),
+        static_cast<int>(size)};
+
+    while(std::uint32_t u32Tag = stream.ReadTag())
+      {
+        if(u32Tag == TRACE_TAG)
+          {
+            return true;
+          }
+
+        if(!WireFormatLite::SkipField(&stream,u32Tag))
+          {
+            break;
+          }
+      }
+
+    return false;
+  }
+}
+
+OpenTestPoint::TraceHop::TraceHop(const std::string & sName)
+{
+  sNameField_.resize(CodedOutputStream::VarintSize32(NAME_TAG) +
+                     CodedOutputStream::VarintSize32(sName.size()) +
+                     sName.size());
+
+  auto pTarget = reinterpret_cast<std::uint8_t *>(&sNameField_[0]);
+
+  pTarget = CodedOutputStream::WriteVarint32ToArray(NAME_TAG,pTarget);
+  pTarget = CodedOutputStream::WriteVarint32ToArray(sName.size(),pTarget);
+
+  std::memcpy(pTarget,sName.data(),sName.size());
+}
+
+void OpenTestPoint::TraceHop::stamp(zmq_msg_t & message) const
+{
+  if(!isTraced(zmq_msg_data(&message),zmq_msg_size(&message)))
+    {
+      return;
+    }
+
+  std::uint64_t u64Timestamp = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+
+  std::uint32_t u32HopSize{static_cast<std::uint32_t>(sNameField_.size() +
+                                                      CodedOutputStream::VarintSize32(TIMESTAMP_TAG) +
+                                                      CodedOutputStream::VarintSize64(u64Timestamp))};
+
+  std::uint32_t u32TraceSize{static_cast<std::uint32_t>(CodedOutputStream::VarintSize32(HOPS_TAG) +
+                                                        CodedOutputStream::VarintSize32(u32HopSize) +
+                                                        u32HopSize)};
+
+  std::size_t size{zmq_msg_size(&message)};
+
+  zmq_msg_t stamped;
+
+  if(zmq_msg_init_size(&stamped,
+                       size +
+                       CodedOutputStream::VarintSize32(TRACE_TAG) +
+                       CodedOutputStream::VarintSize32(u32TraceSize) +
+                       u32TraceSize) < 0)
+    {
+      // forward the report without the hop
+      return;
+    }
+
+  auto pTarget = static_cast<std::uint8_t *>(zmq_msg_data(&stamped));
+
+  std::memcpy(pTarget,zmq_msg_data(&message),size);
+
+  pTarget += size;
+
+  pTarget = CodedOutputStream::WriteVarint32ToArray(TRACE_TAG,pTarget);
+  pTarget = CodedOutputStream::WriteVarint32ToArray(u32TraceSize,pTarget);
+  pTarget = CodedOutputStream::WriteVarint32ToArray(HOPS_TAG,pTarget);
+  pTarget = CodedOutputStream::WriteVarint32ToArray(u32HopSize,pTarget);
+
+  std::memcpy(pTarget,sNameField_.data(),sNameField_.size());
+
+  pTarget += sNameField_.size();
+
+  pTarget = CodedOutputStream::WriteVarint32ToArray(TIMESTAMP_TAG,pTarget);
+  CodedOutputStream::WriteVarint64ToArray(u64Timestamp,pTarget);
+
+  zmq_msg_move(&message,&stamped);
+
+  zmq_msg_close(&stamped);
+}
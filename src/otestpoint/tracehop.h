@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2026 - Adjacent Link LLC, Bridgewater, New Jersey
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  * Neither the name of Adjacent Link LLC nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * See toplevel COPYING for more information.
+ */
+
+#ifndef OPENTESTPOINT_TRACEHOP_HEADER_
+#define OPENTESTPOINT_TRACEHOP_HEADER_
+
+#include <string>
+#include <zmq.h>
+
+namespace OpenTestPoint
+{
+  /**
+   * @class TraceHop
+   *
+   * @brief Appends a forwarding hop stamp to traced probe reports.
+   *
+   * Reports published by a traced probe carry a ProbeReport::Trace.
+   * A controller or broker stamps each one it forwards by appending a
+   * serialized trace holding a single hop to the report frame: a
+   * parser merges the repeated trace field occurrences, so the report
+   * is never parsed or reserialized. Reports without a trace are
+   * forwarded untouched.
+   */
+  class TraceHop
+  {
+  public:
+    explicit TraceHop(const std::string & sName);
+
+    // replaces the report message with a stamped copy when traced
+    void stamp(zmq_msg_t & message) const;
+
+  private:
+    // encoded hop name field
+    std::string sNameField_;
+  };
+}
+
+#endif // OPENTESTPOINT_TRACEHOP_HEADER_
@@ -34,6 +34,7 @@
 
 #include "otestpoint/toolkit/lifecycleapplication.h"
 #include "otestpoint/probebuilder.h"
+#include "otestpoint/controller.h"
 #include "probedirector.h"
 
 
@@ -52,7 +53,19 @@ public:
       "that instantiates and manages one or more probes based on input XML\n"
       "configuration. Each probe is created within its own isolated process,\n"
       "otestpoint-probe, which acts as a container for the plugin and\n"
-      "provides process isolation between probes.";
+      "provides process isolation between probes.\n\n"
+      "Sending SIGHUP reloads the configuration. Probes with unchanged\n"
+      "settings keep running, removed probes are destroyed and new or\n"
+      "changed probes are created.\n\n"
+      "loglevel elements set the log level of matching labels, for\n"
+      "example label='/node-1/3/*' level='4' logs debug for the probe\n"
+      "with index 3 on node-1. Other labels use -l, --loglevel.";
+  }
+
+  void doReload(const std::string & sConfigurationFile) override
+  {
+    pDirector_->reconfigure(sConfigurationFile,
+                            dynamic_cast<OpenTestPoint::Controller *>(pController_.get()));
   }
 
 
@@ -61,6 +74,7 @@ public:
     return \
       "Sample XML configuration:\n\n"
       "<otestpoint id='node-1' discovery='node-1:8881' publish='node-1:8882'>\n"
+      "  <loglevel label='/node-1/3/*' level='4'/>\n"
       "  <probe>\n"
       "    <plugin library='libprobeplugintimeofday.so'/>\n"
       "  </probe>\n"
@@ -44,15 +44,52 @@
 #include <libxml/parser.h>
 #include <libxml/xmlschemas.h>
 #include <cstring>
+#include <sstream>
+#include <sched.h>
 
 namespace
 {
   const char * pzSchema="\
 <?xml version='1.0' encoding='UTF-8' standalone='yes'?>\
 <xs:schema xmlns:xs='http://www.w3.org/2001/XMLSchema'>\
+  <xs:simpleType name='PhaseType'>\
+    <xs:restriction base='xs:token'>\
+      <xs:enumeration value='aligned'/>\
+      <xs:enumeration value='deterministic'/>\
+      <xs:enumeration value='random'/>\
+    </xs:restriction>\
+  </xs:simpleType>\
+  <xs:simpleType name='CPUListType'>\
+    <xs:restriction base='xs:token'>\
+      <xs:pattern value='[0-9]+(-[0-9]+)?(,[0-9]+(-[0-9]+)?)*'/>\
+    </xs:restriction>\
+  </xs:simpleType>\
+  <xs:simpleType name='NiceType'>\
+    <xs:restriction base='xs:int'>\
+      <xs:minInclusive value='-20'/>\
+      <xs:maxInclusive value='19'/>\
+    </xs:restriction>\
+  </xs:simpleType>\
+  <xs:simpleType name='LogLevelType'>\
+    <xs:restriction base='xs:unsignedByte'>\
+      <xs:maxInclusive value='4'/>\
+    </xs:restriction>\
+  </xs:simpleType>\
+  <xs:simpleType name='PriorityType'>\
+    <xs:restriction base='xs:int'>\
+      <xs:minInclusive value='1'/>\
+      <xs:maxInclusive value='99'/>\
+    </xs:restriction>\
+  </xs:simpleType>\
   <xs:element name='otestpoint'>\
     <xs:complexType>\
       <xs:sequence>\
+        <xs:element name='loglevel' minOccurs='0' maxOccurs='unbounded'>\
+          <xs:complexType>\
+            <xs:attribute name='label' type='xs:string' use='required'/>\
+            <xs:attribute name='level' type='LogLevelType' use='required'/>\
+          </xs:complexType>\
+        </xs:element>\
         <xs:element name='probe' maxOccurs='unbounded'>\
           <xs:complexType>\
             <xs:choice>\
@@ -71,6 +108,19 @@ namespace
             <xs:attribute name='configuration' type='xs:string' use='optional'/> \
             <xs:attribute name='rate' type='xs:unsignedShort' use='optional'/> \
             <xs:attribute name='commthreshold' type='xs:unsignedShort' use='optional'/>\
+            <xs:attribute name='phase' type='PhaseType' use='optional'/>\
+            <xs:attribute name='phasewindow' type='xs:unsignedInt' use='optional'/>\
+            <xs:attribute name='group' type='xs:string' use='optional'/>\
+            <xs:attribute name='isolate' type='xs:boolean' default='false'/>\
+            <xs:attribute name='budget' type='xs:unsignedInt' use='optional'/>\
+            <xs:attribute name='affinity' type='CPUListType' use='optional'/>\
+            <xs:attribute name='nice' type='NiceType' use='optional'/>\
+            <xs:attribute name='priority' type='PriorityType' use='optional'/>\
+            <xs:attribute name='cgroup' type='xs:string' use='optional'/>\
+            <xs:attribute name='zygote' type='xs:boolean' use='optional'/>\
+            <xs:attribute name='ondemand' type='xs:boolean' use='optional'/>\
+            <xs:attribute name='idlerate' type='xs:unsignedShort' use='optional'/>\
+            <xs:attribute name='trace' type='xs:boolean' use='optional'/>\
           </xs:complexType>\
         </xs:element>\
       </xs:sequence>\
@@ -79,9 +129,207 @@ namespace
       <xs:attribute name='publish' type='xs:string' use='required'/> \
       <xs:attribute name='rate' type='xs:unsignedShort' default='5'/>\
       <xs:attribute name='commthreshold' type='xs:unsignedShort' default='5'/>\
+      <xs:attribute name='phase' type='PhaseType' default='aligned'/>\
+      <xs:attribute name='phasewindow' type='xs:unsignedInt' default='0'/>\
+      <xs:attribute name='group' type='xs:string' use='optional'/>\
+      <xs:attribute name='budget' type='xs:unsignedInt' default='0'/>\
+      <xs:attribute name='affinity' type='CPUListType' use='optional'/>\
+      <xs:attribute name='nice' type='NiceType' use='optional'/>\
+      <xs:attribute name='priority' type='PriorityType' use='optional'/>\
+      <xs:attribute name='cgroup' type='xs:string' use='optional'/>\
+      <xs:attribute name='zygote' type='xs:boolean' default='false'/>\
+      <xs:attribute name='ondemand' type='xs:boolean' default='false'/>\
+      <xs:attribute name='idlerate' type='xs:unsignedShort' default='0'/>\
+      <xs:attribute name='trace' type='xs:boolean' default='false'/>\
     </xs:complexType>\
   </xs:element>\
 </xs:schema>";
+
+  // parses a cpu list of the form 0-3,6
+  std::vector<std::uint16_t> parseCPUList(const std::string & sCPUList)
+  {
+    std::vector<std::uint16_t> cpus{};
+
+    std::stringstream ss{sCPUList};
+
+    std::string sRange{};
+
+    while(std::getline(ss,sRange,','))
+      {
+        auto pos = sRange.find('-');
+
+        std::uint16_t u16First{OpenTestPoint::Toolkit::strToUINT16(sRange.substr(0,pos),
+                                                                   0,
+                                                                   CPU_SETSIZE - 1)};
+
+        std::uint16_t u16Last{u16First};
+
+        if(pos != std::string::npos)
+          {
+            u16Last = OpenTestPoint::Toolkit::strToUINT16(sRange.substr(pos + 1),
+                                                          u16First,
+                                                          CPU_SETSIZE - 1);
+          }
+
+        for(std::uint16_t u16CPU = u16First; u16CPU <= u16Last; ++u16CPU)
+          {
+            cpus.push_back(u16CPU);
+          }
+      }
+
+    return cpus;
+  }
+
+  // reads probe option attributes present on a node into options
+  void parseProbeOptions(xmlNodePtr pNode,
+                         OpenTestPoint::ProbeOptions & options)
+  {
+    xmlChar * pPhase = xmlGetProp(pNode,BAD_CAST "phase");
+
+    if(pPhase)
+      {
+        if(!xmlStrcmp(pPhase,BAD_CAST "deterministic"))
+          {
+            options.phase = OpenTestPoint::ProbeOptions::Phase::DETERMINISTIC;
+          }
+        else if(!xmlStrcmp(pPhase,BAD_CAST "random"))
+          {
+            options.phase = OpenTestPoint::ProbeOptions::Phase::RANDOM;
+          }
+        else
+          {
+            options.phase = OpenTestPoint::ProbeOptions::Phase::ALIGNED;
+          }
+
+        xmlFree(pPhase);
+      }
+
+    xmlChar * pPhaseWindow = xmlGetProp(pNode,BAD_CAST "phasewindow");
+
+    if(pPhaseWindow)
+      {
+        options.phaseWindow =
+          std::chrono::milliseconds{OpenTestPoint::Toolkit::strToUINT32(reinterpret_cast<const char *>(pPhaseWindow))};
+
+        xmlFree(pPhaseWindow);
+      }
+
+    xmlChar * pGroup = xmlGetProp(pNode,BAD_CAST "group");
+
+    if(pGroup)
+      {
+        options.group = reinterpret_cast<const char *>(pGroup);
+
+        xmlFree(pGroup);
+      }
+
+    xmlChar * pIsolate = xmlGetProp(pNode,BAD_CAST "isolate");
+
+    if(pIsolate)
+      {
+        if(OpenTestPoint::Toolkit::strToBool(reinterpret_cast<const char *>(pIsolate)))
+          {
+            options.group.clear();
+          }
+
+        xmlFree(pIsolate);
+      }
+
+    xmlChar * pBudget = xmlGetProp(pNode,BAD_CAST "budget");
+
+    if(pBudget)
+      {
+        options.budget =
+          std::chrono::milliseconds{OpenTestPoint::Toolkit::strToUINT32(reinterpret_cast<const char *>(pBudget))};
+
+        xmlFree(pBudget);
+      }
+
+    xmlChar * pAffinity = xmlGetProp(pNode,BAD_CAST "affinity");
+
+    if(pAffinity)
+      {
+        options.affinity = parseCPUList(reinterpret_cast<const char *>(pAffinity));
+
+        xmlFree(pAffinity);
+      }
+
+    xmlChar * pNice = xmlGetProp(pNode,BAD_CAST "nice");
+
+    xmlChar * pPriority = xmlGetProp(pNode,BAD_CAST "priority");
+
+    if(pNice && pPriority)
+      {
+        xmlFree(pNice);
+        xmlFree(pPriority);
+
+        throw OpenTestPoint::Toolkit::Exception{"nice and priority are mutually exclusive"};
+      }
+
+    if(pNice)
+      {
+        options.scheduler = OpenTestPoint::ProbeOptions::Scheduler::OTHER;
+
+        options.nice = OpenTestPoint::Toolkit::strToINT32(reinterpret_cast<const char *>(pNice));
+
+        xmlFree(pNice);
+      }
+
+    if(pPriority)
+      {
+        options.scheduler = OpenTestPoint::ProbeOptions::Scheduler::FIFO;
+
+        options.priority = OpenTestPoint::Toolkit::strToINT32(reinterpret_cast<const char *>(pPriority));
+
+        xmlFree(pPriority);
+      }
+
+    xmlChar * pCGroup = xmlGetProp(pNode,BAD_CAST "cgroup");
+
+    if(pCGroup)
+      {
+        options.cgroup = reinterpret_cast<const char *>(pCGroup);
+
+        xmlFree(pCGroup);
+      }
+
+    xmlChar * pZygote = xmlGetProp(pNode,BAD_CAST "zygote");
+
+    if(pZygote)
+      {
+        options.zygote = OpenTestPoint::Toolkit::strToBool(reinterpret_cast<const char *>(pZygote));
+
+        xmlFree(pZygote);
+      }
+
+    xmlChar * pOnDemand = xmlGetProp(pNode,BAD_CAST "ondemand");
+
+    if(pOnDemand)
+      {
+        options.onDemand = OpenTestPoint::Toolkit::strToBool(reinterpret_cast<const char *>(pOnDemand));
+
+        xmlFree(pOnDemand);
+      }
+
+    xmlChar * pIdleRate = xmlGetProp(pNode,BAD_CAST "idlerate");
+
+    if(pIdleRate)
+      {
+        options.idleRate =
+          std::chrono::seconds{OpenTestPoint::Toolkit::strToUINT16(reinterpret_cast<const char *>(pIdleRate))};
+
+        xmlFree(pIdleRate);
+      }
+
+    xmlChar * pTrace = xmlGetProp(pNode,BAD_CAST "trace");
+
+    if(pTrace)
+      {
+        options.trace = OpenTestPoint::Toolkit::strToBool(reinterpret_cast<const char *>(pTrace));
+
+        xmlFree(pTrace);
+      }
+  }
 }
 
 OpenTestPoint::ProbeDirector::ProbeDirector(Toolkit::Log::Service & logService,
@@ -97,6 +345,95 @@ OpenTestPoint::ProbeDirector::ProbeDirector(Toolkit::Log::Service & logService,
 
 OpenTestPoint::Controller *
 OpenTestPoint::ProbeDirector::construct(const std::string & sConfigurationFile)
+{
+  xmlDocPtr pDoc{load(sConfigurationFile)};
+
+  xmlNodePtr pRoot = xmlDocGetRootElement(pDoc);
+
+  xmlChar * pId = xmlGetProp(pRoot,BAD_CAST "id");
+
+  xmlChar * pDiscoveryEndpoint = xmlGetProp(pRoot,BAD_CAST "discovery");
+
+  xmlChar * pPublishEndpoint = xmlGetProp(pRoot,BAD_CAST "publish");
+
+  std::string sNodeId{reinterpret_cast<const char *>(pId)};
+
+  sDiscoveryEndpoint_ = reinterpret_cast<const char *>(pDiscoveryEndpoint);
+
+  sPublishEndpoint_ = reinterpret_cast<const char *>(pPublishEndpoint);
+
+  xmlFree(pDiscoveryEndpoint);
+
+  xmlFree(pPublishEndpoint);
+
+  xmlFree(pId);
+
+  builder_.buildController(sNodeId,
+                           logService_,
+                           logClient_,
+                           std::string{"tcp://"} +
+                           Toolkit::getHostAddressAsString(sDiscoveryEndpoint_,true),
+                           std::string{"tcp://"} +
+                           Toolkit::getHostAddressAsString(sPublishEndpoint_,true));
+
+  logService_.setLevelRules(parseLogLevels(pRoot));
+
+  buildProbes(pRoot);
+
+  xmlFreeDoc(pDoc);
+
+  return builder_.getController();
+}
+
+void OpenTestPoint::ProbeDirector::reconfigure(const std::string & sConfigurationFile,
+                                               Controller * pController)
+{
+  // an invalid configuration throws before any probe or log level
+  // is changed
+  xmlDocPtr pDoc{load(sConfigurationFile)};
+
+  xmlNodePtr pRoot = xmlDocGetRootElement(pDoc);
+
+  xmlChar * pDiscoveryEndpoint = xmlGetProp(pRoot,BAD_CAST "discovery");
+
+  xmlChar * pPublishEndpoint = xmlGetProp(pRoot,BAD_CAST "publish");
+
+  if(sDiscoveryEndpoint_ != reinterpret_cast<const char *>(pDiscoveryEndpoint) ||
+     sPublishEndpoint_ != reinterpret_cast<const char *>(pPublishEndpoint))
+    {
+      logClient_.log(Toolkit::Log::Level::ERROR_LEVEL,
+                     "reconfigure: discovery and publish endpoint changes require a restart");
+    }
+
+  xmlFree(pDiscoveryEndpoint);
+
+  xmlFree(pPublishEndpoint);
+
+  try
+    {
+      auto rules = parseLogLevels(pRoot);
+
+      // probes are only recorded until endReconfiguration(), probe
+      // options are parsed and validated first
+      builder_.beginReconfiguration(pController);
+
+      buildProbes(pRoot);
+
+      builder_.endReconfiguration();
+
+      // also clears rules removed by a reconfiguration
+      logService_.setLevelRules(rules);
+    }
+  catch(...)
+    {
+      xmlFreeDoc(pDoc);
+      throw;
+    }
+
+  xmlFreeDoc(pDoc);
+}
+
+xmlDocPtr OpenTestPoint::ProbeDirector::load(const std::string & sConfigurationFile)
 {
   LIBXML_TEST_VERSION;
 
@@ -136,31 +473,58 @@ OpenTestPoint::ProbeDirector::construct(const std::string & sConfigurationFile)
 
   xmlDocPtr pDoc = xmlReadFile(sConfigurationFile.c_str(),nullptr,0);
 
-  if(xmlSchemaValidateDoc(pSchemaValidCtxtPtr, pDoc))
+  int iResult{xmlSchemaValidateDoc(pSchemaValidCtxtPtr, pDoc)};
+
+  xmlSchemaFreeValidCtxt(pSchemaValidCtxtPtr);
+
+  xmlSchemaFree(pSchema);
+
+  xmlSchemaFreeParserCtxt(pParserContext);
+
+  xmlFreeDoc(pSchemaDoc);
+
+  if(iResult)
     {
+      if(pDoc)
+        {
+          xmlFreeDoc(pDoc);
+        }
+
       throw Toolkit::Exception{"invalid document"};
     }
 
-  xmlNodePtr pRoot = xmlDocGetRootElement(pDoc);
+  return pDoc;
+}
 
-  xmlChar * pId = xmlGetProp(pRoot,BAD_CAST "id");
+OpenTestPoint::Toolkit::Log::LevelRules
+OpenTestPoint::ProbeDirector::parseLogLevels(xmlNodePtr pRoot)
+{
+  Toolkit::Log::LevelRules rules{};
 
-  xmlChar * pDiscoveryEndpoint = xmlGetProp(pRoot,BAD_CAST "discovery");
+  for(xmlNodePtr pNode = pRoot->children; pNode; pNode = pNode->next)
+    {
+      if(pNode->type == XML_ELEMENT_NODE &&
+         !xmlStrcmp(pNode->name,BAD_CAST "loglevel"))
+        {
+          xmlChar * pLabel = xmlGetProp(pNode,BAD_CAST "label");
 
-  xmlChar * pPublishEndpoint = xmlGetProp(pRoot,BAD_CAST "publish");
+          xmlChar * pLevel = xmlGetProp(pNode,BAD_CAST "level");
 
-  std::string sEndpointBase{"tcp://127.0.0.1:"};
+          rules.emplace_back(reinterpret_cast<const char *>(pLabel),
+                             static_cast<Toolkit::Log::Level>(Toolkit::strToUINT16(reinterpret_cast<const char *>(pLevel),0,4)));
 
-  builder_.buildController(logService_,
-                           logClient_,
-                           std::string{"tcp://"} +
-                           Toolkit::getHostAddressAsString(reinterpret_cast<const char *>(pDiscoveryEndpoint),true),
-                           std::string{"tcp://"} +
-                           Toolkit::getHostAddressAsString(reinterpret_cast<const char *>(pPublishEndpoint),true));
+          xmlFree(pLabel);
 
-  xmlFree(pDiscoveryEndpoint);
+          xmlFree(pLevel);
+        }
+    }
 
-  xmlFree(pPublishEndpoint);
+  return rules;
+}
+
+void OpenTestPoint::ProbeDirector::buildProbes(xmlNodePtr pRoot)
+{
+  xmlChar * pId = xmlGetProp(pRoot,BAD_CAST "id");
 
   xmlChar * pProbeRate = xmlGetProp(pRoot,BAD_CAST "rate");
 
@@ -174,57 +538,65 @@ OpenTestPoint::ProbeDirector::construct(const std::string & sConfigurationFile)
 
   xmlFree(pCommThreshold);
 
+  ProbeOptions defaultOptions{};
+
+  parseProbeOptions(pRoot,defaultOptions);
+
   for(xmlNodePtr pNode = pRoot->children; pNode; pNode = pNode->next)
     {
       if(pNode->type == XML_ELEMENT_NODE)
         {
           if(!xmlStrcmp(pNode->name,BAD_CAST "probe"))
             {
+              xmlChar * pConfiguration = xmlGetProp(pNode,BAD_CAST "configuration");
 
-              for(xmlNodePtr pChildNode = pNode->children; pChildNode; pChildNode = pChildNode->next)
+              std::string sConfiguration{};
+
+              if(pConfiguration)
                 {
-                  if(pChildNode->type == XML_ELEMENT_NODE)
-                    {
-                      if(!xmlStrcmp(pChildNode->name,BAD_CAST "plugin"))
-                        {
-                          xmlChar * pLibrary = xmlGetProp(pChildNode,BAD_CAST "library");
+                  sConfiguration = reinterpret_cast<const char *>(pConfiguration);
+                  xmlFree(pConfiguration);
+                }
 
-                          xmlChar * pConfiguration = xmlGetProp(pNode,BAD_CAST "configuration");
+              // local rate and threshold
+              std::uint16_t u16LocalProbeRate{u16ProbeRate};
 
-                          std::string sConfiguration{};
+              std::uint16_t u16LocalCommThreshold{u16CommThreshold};
 
-                          if(pConfiguration)
-                            {
-                              sConfiguration = reinterpret_cast<const char *>(pConfiguration);
-                              xmlFree(pConfiguration);
-                            }
+              xmlChar * pProbeRate = xmlGetProp(pNode,BAD_CAST "rate");
 
-                          // local rate and threshold
-                          std::uint16_t u16LocalProbeRate{u16ProbeRate};
+              if(pProbeRate)
+                {
+                  u16LocalProbeRate = Toolkit::strToUINT16(reinterpret_cast<const char *>(pProbeRate));
+                  xmlFree(pProbeRate);
+                }
 
-                          std::uint16_t u16LocalCommThreshold{u16CommThreshold};
+              xmlChar * pCommThreshold = xmlGetProp(pNode,BAD_CAST "commthreshold");
 
-                          xmlChar * pProbeRate = xmlGetProp(pNode,BAD_CAST "rate");
+              if(pCommThreshold)
+                {
+                  u16LocalCommThreshold = Toolkit::strToUINT16(reinterpret_cast<const char *>(pCommThreshold));
+                  xmlFree(pCommThreshold);
+                }
 
-                          if(pProbeRate)
-                            {
-                              u16LocalProbeRate = Toolkit::strToUINT16(reinterpret_cast<const char *>(pProbeRate));
-                              xmlFree(pProbeRate);
-                            }
+              ProbeOptions options{defaultOptions};
 
-                          xmlChar * pCommThreshold = xmlGetProp(pNode,BAD_CAST "commthreshold");
+              parseProbeOptions(pNode,options);
 
-                          if(pCommThreshold)
-                            {
-                              u16LocalCommThreshold = Toolkit::strToUINT16(reinterpret_cast<const char *>(pCommThreshold));
-                              xmlFree(pCommThreshold);
-                            }
+              for(xmlNodePtr pChildNode = pNode->children; pChildNode; pChildNode = pChildNode->next)
+                {
+                  if(pChildNode->type == XML_ELEMENT_NODE)
+                    {
+                      if(!xmlStrcmp(pChildNode->name,BAD_CAST "plugin"))
+                        {
+                          xmlChar * pLibrary = xmlGetProp(pChildNode,BAD_CAST "library");
 
                           builder_.buildPluginProbe(reinterpret_cast<const char *>(pId),
                                                     reinterpret_cast<const char *>(pLibrary),
                                                     std::chrono::seconds{u16LocalProbeRate},
                                                     std::chrono::seconds{u16LocalCommThreshold},
-                                                    sConfiguration);
+                                                    sConfiguration,
+                                                    options);
 
                           xmlFree(pLibrary);
                         }
@@ -234,43 +606,13 @@ OpenTestPoint::ProbeDirector::construct(const std::string & sConfigurationFile)
 
                           xmlChar * pClass = xmlGetProp(pChildNode,BAD_CAST "class");
 
-                          xmlChar * pConfiguration = xmlGetProp(pNode,BAD_CAST "configuration");
-
-                          std::string sConfiguration{};
-
-                          if(pConfiguration)
-                            {
-                              sConfiguration =  reinterpret_cast<const char *>(pConfiguration);
-                              xmlFree(pConfiguration);
-                            }
-
-                          // local rate and threshold
-                          std::uint16_t u16LocalProbeRate{u16ProbeRate};
-
-                          std::uint16_t u16LocalCommThreshold{u16CommThreshold};
-
-                          xmlChar * pProbeRate = xmlGetProp(pNode,BAD_CAST "rate");
-
-                          if(pProbeRate)
-                            {
-                              u16LocalProbeRate = Toolkit::strToUINT16(reinterpret_cast<const char *>(pProbeRate));
-                              xmlFree(pProbeRate);
-                            }
-
-                          xmlChar * pCommThreshold = xmlGetProp(pNode,BAD_CAST "commthreshold");
-
-                          if(pCommThreshold)
-                            {
-                              u16LocalCommThreshold = Toolkit::strToUINT16(reinterpret_cast<const char *>(pCommThreshold));
-                              xmlFree(pCommThreshold);
-                            }
-
                           builder_.buildPythonProbe(reinterpret_cast<const char *>(pId),
                                                     reinterpret_cast<const char *>(pModule),
                                                     reinterpret_cast<const char *>(pClass),
                                                     std::chrono::seconds{u16LocalProbeRate},
                                                     std::chrono::seconds{u16LocalCommThreshold},
-                                                    sConfiguration);
+                                                    sConfiguration,
+                                                    options);
 
                           xmlFree(pModule);
                           xmlFree(pClass);
@@ -282,10 +624,4 @@ OpenTestPoint::ProbeDirector::construct(const std::string & sConfigurationFile)
     }
 
   xmlFree(pId);
-
-  xmlFreeDoc(pDoc);
-
-  xmlCleanupParser();
-
-  return builder_.getController();
 }
@@ -38,6 +38,8 @@
 #include "otestpoint/toolkit/log/service.h"
 #include "otestpoint/toolkit/log/client.h"
 
+#include <libxml/tree.h>
+
 #include <string>
 #include <list>
 #include <uuid.h>
@@ -58,11 +60,24 @@ namespace OpenTestPoint
 
     Controller * construct(const std::string & sConfigurationFile);
 
+    // applies probe changes to a controller returned by construct()
+    void reconfigure(const std::string & sConfigurationFile,
+                     Controller * pController);
+
   private:
     Toolkit::Log::Service & logService_;
     Toolkit::Log::Client & logClient_;
     uuid_t uuid_;
     ProbeBuilder & builder_;
+    std::string sDiscoveryEndpoint_;
+    std::string sPublishEndpoint_;
+
+    xmlDocPtr load(const std::string & sConfigurationFile);
+
+    void buildProbes(xmlNodePtr pRoot);
+
+    // label level rules from loglevel elements
+    Toolkit::Log::LevelRules parseLogLevels(xmlNodePtr pRoot);
   };
 }
 
@@ -73,6 +73,21 @@ void OpenTestPoint::TimeOfDay::destroy()
 
 OpenTestPoint::ProbeData
 OpenTestPoint::TimeOfDay::probe()
+{
+  ProbeDataBuffer buffer{};
+
+  probeInto(buffer);
+
+  const auto & entry = *buffer.begin();
+
+  return {std::make_tuple(entry.sTopic,
+                          entry.sSerialization,
+                          entry.sName,
+                          entry.sModule,
+                          entry.u32Version)};
+}
+
+void OpenTestPoint::TimeOfDay::probeInto(ProbeDataBuffer & buffer)
 {
   OPENTESTPOINT_PROBESERVICE_LOG_DEBUG(pProbeService_,
                                        "/probe/timeofday probe");
@@ -85,15 +100,15 @@ OpenTestPoint::TimeOfDay::probe()
 
   data.set_microsecondssinceepoch(now.count());
 
-  std::string sSerialization{};
+  auto & entry = buffer.append();
+
+  entry.sTopic.assign("Probes.TimeOfDay");
 
-  data.SerializeToString(&sSerialization);
+  data.SerializeToString(&entry.sSerialization);
 
-  return {std::make_tuple("Probes.TimeOfDay",
-                          sSerialization,
-                          data.description().name(),
-                          data.description().module(),
-                          data.description().version())};
+  entry.sName.assign(data.description().name());
+  entry.sModule.assign(data.description().module());
+  entry.u32Version = data.description().version();
 }
 
 DECLARE_PROBEPLUGIN(OpenTestPoint::TimeOfDay)
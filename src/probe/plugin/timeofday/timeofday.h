@@ -55,6 +55,8 @@ namespace OpenTestPoint
     void destroy();
 
     ProbeData probe();
+
+    void probeInto(ProbeDataBuffer & buffer);
   };
 
 }
@@ -40,22 +40,35 @@
 
 #include <iostream>
 #include <fstream>
-#include <mutex>
 #include <sstream>
 
 #include <getopt.h>
 #include <unistd.h>
 #include <uuid.h>
 #include <signal.h>
+#include <fcntl.h>
+#include <cerrno>
+#include <cstring>
 
 
 namespace
 {
-  std::mutex mutex{};
+  // signals are forwarded to the main thread over a pipe, a write is
+  // async-signal-safe
+  int signalPipe[2]{-1,-1};
 
-  void sighandler(int)
+  void sighandler(int iSignal)
   {
-    mutex.unlock();
+    int iErrno{errno};
+
+    char command{iSignal == SIGHUP ? 'r' : 's'};
+
+    // the pipe is non blocking, a full pipe already holds a command
+    ssize_t rc{write(signalPipe[1],&command,sizeof(command))};
+
+    (void) rc;
+
+    errno = iErrno;
   }
 }
 
@@ -114,6 +127,10 @@ int OpenTestPoint::Toolkit::Application::main(int argc, char * argv[])
           {"pidfile" , 1, nullptr,  2},
           {"uuidfile", 1, nullptr,  3},
           {"priority", 1, nullptr,  'p'},
+          {"logformat", 1, nullptr,  4},
+          {"logrotatesize", 1, nullptr,  5},
+          {"logrotaterecords", 1, nullptr,  6},
+          {"logrotatekeep", 1, nullptr,  7},
         };
 
       std::string sOptString{"hrvdf:l:p:b:"};
@@ -127,6 +144,7 @@ int OpenTestPoint::Toolkit::Application::main(int argc, char * argv[])
       std::string sLogFile{};
       std::string sPIDFile{};
       std::string sUUIDFile{};
+      Log::SinkOptions sinkOptions{};
 
       // add any specialized options
       std::vector<option> additionalOptions = doGetOptions();
@@ -182,6 +200,55 @@ int OpenTestPoint::Toolkit::Application::main(int argc, char * argv[])
               sUUIDFile = optarg;
               break;
 
+            case 4:
+              try
+                {
+                  sinkOptions.format = Log::toSinkFormat(optarg);
+                }
+              catch(...)
+                {
+                  std::cerr<<"invalid log format: "<<optarg<<std::endl;
+                  return EXIT_FAILURE;
+                }
+
+              break;
+
+            case 5:
+            case 6:
+              try
+                {
+                  std::uint64_t u64Value{OpenTestPoint::Toolkit::strToUINT64(optarg)};
+
+                  if(iOption == 5)
+                    {
+                      sinkOptions.u64RotateSize = u64Value;
+                    }
+                  else
+                    {
+                      sinkOptions.u64RotateRecords = u64Value;
+                    }
+                }
+              catch(...)
+                {
+                  std::cerr<<"invalid log rotation limit: "<<optarg<<std::endl;
+                  return EXIT_FAILURE;
+                }
+
+              break;
+
+            case 7:
+              try
+                {
+                  sinkOptions.u32RotateKeep = OpenTestPoint::Toolkit::strToUINT32(optarg,0,1000);
+                }
+              catch(...)
+                {
+                  std::cerr<<"invalid log rotation keep: "<<optarg<<std::endl;
+                  return EXIT_FAILURE;
+                }
+
+              break;
+
             case 'p':
               try
                 {
@@ -251,7 +318,8 @@ int OpenTestPoint::Toolkit::Application::main(int argc, char * argv[])
       Log::ServiceBuilder serviceBuilder{};
 
       pImpl_->pLogService_.reset(serviceBuilder.buildService(static_cast<Log::Level>(iLogLevel),
-                                                             sLogFile));
+                                                             sLogFile,
+                                                             sinkOptions));
 
       Log::ClientBuilder clientBuilder{};
 
@@ -341,6 +409,13 @@ int OpenTestPoint::Toolkit::Application::main(int argc, char * argv[])
 
       doStart();
 
+      if(pipe2(signalPipe,O_CLOEXEC) ||
+         fcntl(signalPipe[1],F_SETFL,O_NONBLOCK))
+        {
+          std::cerr<<"unable to create signal pipe: "<<strerror(errno)<<std::endl;
+          return EXIT_FAILURE;
+        }
+
       struct sigaction action;
 
       memset(&action,0,sizeof(action));
@@ -349,11 +424,38 @@ int OpenTestPoint::Toolkit::Application::main(int argc, char * argv[])
 
       sigaction(SIGINT,&action,nullptr);
       sigaction(SIGQUIT,&action,nullptr);
+      sigaction(SIGTERM,&action,nullptr);
+      sigaction(SIGHUP,&action,nullptr);
+
+      while(true)
+        {
+          char command{};
 
-      mutex.lock();
+          ssize_t len{read(signalPipe[0],&command,sizeof(command))};
 
-      // signal handler unlocks mutex
-      mutex.lock();
+          if(len < 0 && errno == EINTR)
+            {
+              continue;
+            }
+
+          if(len <= 0 || command != 'r')
+            {
+              break;
+            }
+
+          OPENTESTPOINT_TOOLKIT_LOG_INFO("/application reload configuration: %s",
+                                         sConfigurationXML.c_str());
+
+          try
+            {
+              doReload(sConfigurationXML);
+            }
+          catch(const std::exception & exp)
+            {
+              OPENTESTPOINT_TOOLKIT_LOG_ERROR("/application reload failed: %s",
+                                              exp.what());
+            }
+        }
 
       doStop();
 
@@ -393,8 +495,14 @@ void OpenTestPoint::Toolkit::Application::usage() const
   std::cout<<"  -d, --daemonize                Run in the background."<<std::endl;
   std::cout<<"  -h, --help                     Print this message and exit."<<std::endl;
   std::cout<<"  -f, --logfile FILE             Log to a file instead of stdout."<<std::endl;
+  std::cout<<"  --logformat FORMAT             Log output format: text, json or binary."<<std::endl;
+  std::cout<<"                                  default: text"<<std::endl;
   std::cout<<"  -l, --loglevel [0,4]           Set initial log level."<<std::endl;
   std::cout<<"                                  default: "<<doGetDefaultLogLevel()<<std::endl;
+  std::cout<<"  --logrotatekeep COUNT          Rotated log files kept as FILE.1 ... FILE.COUNT."<<std::endl;
+  std::cout<<"                                  default: "<<Log::SinkOptions{}.u32RotateKeep<<std::endl;
+  std::cout<<"  --logrotaterecords COUNT       Rotate the log file after COUNT records."<<std::endl;
+  std::cout<<"  --logrotatesize BYTES          Rotate the log file once it reaches BYTES."<<std::endl;
   std::cout<<"  --pidfile FILE                 Write application pid to file."<<std::endl;
   std::cout<<"  -p, --priority [0,99]          Set realtime priority level."<<std::endl;
   std::cout<<"                                 Only used with -r, --realtime."<<std::endl;
@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2026 - Adjacent Link LLC, Bridgewater, New Jersey
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  * Neither the name of Adjacent Link LLC nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * See toplevel COPYING for more information.
+ */
+#ifndef OPENTESTPOINT_BENCHMEASURE_HEADER_
+#define OPENTESTPOINT_BENCHMEASURE_HEADER_
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
+// Timing shared by the toolkit, otestpoint and otestpoint-probe
+// benches. Not installed.
+
+namespace OpenTestPoint
+{
+  namespace Bench
+  {
+    struct NoOp
+    {
+      void operator()() const {}
+    };
+
+    /**
+     * Calls @a fn(i) @a warmup times so steady state storage has
+     * been reached, then @a iterations times under the clock.
+     *
+     * @param warmup Untimed iterations
+     * @param iterations Timed iterations
+     * @param fn Iteration, called with the iteration index
+     * @param begin Called just before the timed iterations
+     * @param end Called just after the timed iterations
+     *
+     * @return Mean nanoseconds per timed iteration
+     */
+    template<typename Function, typename Begin = NoOp, typename End = NoOp>
+    double measure(std::size_t warmup,
+                   std::size_t iterations,
+                   Function fn,
+                   Begin begin = {},
+                   End end = {})
+    {
+      for(std::size_t i = 0; i < warmup; ++i)
+        {
+          fn(i);
+        }
+
+      begin();
+
+      auto start = std::chrono::steady_clock::now();
+
+      for(std::size_t i = 0; i < iterations; ++i)
+        {
+          fn(i);
+        }
+
+      auto duration = std::chrono::steady_clock::now() - start;
+
+      end();
+
+      return std::chrono::duration<double,std::nano>(duration).count() /
+        iterations;
+    }
+
+    struct Summary
+    {
+      double dMin;
+      double dMedian;
+      double dMean;
+      double dMax;
+    };
+
+    /**
+     * Summarizes per iteration samples, for benches where each
+     * iteration is expensive enough to time on its own.
+     *
+     * @param samples Samples, must not be empty
+     */
+    inline Summary summarize(std::vector<double> samples)
+    {
+      std::sort(samples.begin(),samples.end());
+
+      double dSum{};
+
+      for(const auto & dSample : samples)
+        {
+          dSum += dSample;
+        }
+
+      return {samples.front(),
+          samples[samples.size() / 2],
+          dSum / samples.size(),
+          samples.back()};
+    }
+  }
+}
+
+#endif // OPENTESTPOINT_BENCHMEASURE_HEADER_
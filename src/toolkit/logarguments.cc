@@ -0,0 +1,346 @@
+/*
+ * Copyright (c) 2026 - Adjacent Link LLC, Bridgewater, New Jersey
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  * Neither the name of Adjacent Link LLC nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * See toplevel COPYING for more information.
+ */
+
+#include "otestpoint/toolkit/log/client.h"
+#include "otestpoint/toolkit/log/arguments.h"
+
+#include <cstdio>
+#include <vector>
+
+namespace
+{
+  using OpenTestPoint::Toolkit::Log::Arguments;
+
+  template<typename T>
+  void append(std::string & sOutput, const std::string & sSpecification, T value)
+  {
+    char buf[256];
+
+    int iLength{snprintf(buf,sizeof(buf),sSpecification.c_str(),value)};
+
+    if(iLength < 0)
+      {
+        return;
+      }
+
+    if(static_cast<std::size_t>(iLength) < sizeof(buf))
+      {
+        sOutput.append(buf,iLength);
+      }
+    else
+      {
+        std::vector<char> large(iLength + 1);
+
+        snprintf(large.data(),large.size(),sSpecification.c_str(),value);
+
+        sOutput.append(large.data(),iLength);
+      }
+  }
+
+  class Reader
+  {
+  public:
+    Reader(const char * pArguments, std::size_t length):
+      pNext_{pArguments},
+      pEnd_{pArguments + length}{}
+
+    bool type(Arguments::Type & type)
+    {
+      if(pNext_ == pEnd_)
+        {
+          return false;
+        }
+
+      type = static_cast<Arguments::Type>(*pNext_++);
+
+      return true;
+    }
+
+    template<typename T>
+    bool value(T & value)
+    {
+      if(pEnd_ - pNext_ < static_cast<std::ptrdiff_t>(sizeof(value)))
+        {
+          pNext_ = pEnd_;
+          return false;
+        }
+
+      std::memcpy(&value,pNext_,sizeof(value));
+
+      pNext_ += sizeof(value);
+
+      return true;
+    }
+
+    bool value(std::string & sValue)
+    {
+      std::uint16_t u16Length{};
+
+      if(!value(u16Length) || pEnd_ - pNext_ < u16Length)
+        {
+          pNext_ = pEnd_;
+          return false;
+        }
+
+      sValue.assign(pNext_,u16Length);
+
+      pNext_ += u16Length;
+
+      return true;
+    }
+
+  private:
+    const char * pNext_;
+    const char * pEnd_;
+  };
+
+  void append(std::string & sOutput, const std::string & sSpecification, const std::string & sValue)
+  {
+    append(sOutput,sSpecification,sValue.c_str());
+  }
+
+  template<typename T>
+  bool convert(std::string & sOutput,
+               const std::string & sSpecification,
+               bool bAllowed,
+               Reader & reader)
+  {
+    T value{};
+
+    if(!reader.value(value) || !bAllowed)
+      {
+        return false;
+      }
+
+    append(sOutput,sSpecification,value);
+
+    return true;
+  }
+
+  // formats a single argument with a conversion specification missing
+  // its length modifier, which is taken from the encoded type
+  bool format(std::string & sOutput,
+              const std::string & sSpecification,
+              char conversion,
+              Reader & reader)
+  {
+    Arguments::Type type{};
+
+    if(!reader.type(type))
+      {
+        return false;
+      }
+
+    bool bInteger{std::strchr("diouxX",conversion) != nullptr};
+
+    bool bFloat{std::strchr("eEfFgGaA",conversion) != nullptr};
+
+    switch(type)
+      {
+      case Arguments::TYPE_INT:
+        return convert<int>(sOutput,
+                            sSpecification + conversion,
+                            bInteger || conversion == 'c',
+                            reader);
+
+      case Arguments::TYPE_UINT:
+        return convert<unsigned int>(sOutput,
+                                     sSpecification + conversion,
+                                     bInteger || conversion == 'c',
+                                     reader);
+
+      case Arguments::TYPE_LONG:
+        return convert<long>(sOutput,
+                             sSpecification + 'l' + conversion,
+                             bInteger,
+                             reader);
+
+      case Arguments::TYPE_ULONG:
+        return convert<unsigned long>(sOutput,
+                                      sSpecification + 'l' + conversion,
+                                      bInteger,
+                                      reader);
+
+      case Arguments::TYPE_LONGLONG:
+        return convert<long long>(sOutput,
+                                  sSpecification + "ll" + conversion,
+                                  bInteger,
+                                  reader);
+
+      case Arguments::TYPE_ULONGLONG:
+        return convert<unsigned long long>(sOutput,
+                                           sSpecification + "ll" + conversion,
+                                           bInteger,
+                                           reader);
+
+      case Arguments::TYPE_DOUBLE:
+        return convert<double>(sOutput,
+                               sSpecification + conversion,
+                               bFloat,
+                               reader);
+
+      case Arguments::TYPE_STRING:
+        return convert<std::string>(sOutput,
+                                    sSpecification + conversion,
+                                    conversion == 's',
+                                    reader);
+
+      case Arguments::TYPE_POINTER:
+        return convert<const void *>(sOutput,
+                                     sSpecification + conversion,
+                                     conversion == 'p',
+                                     reader);
+      }
+
+    return false;
+  }
+}
+
+std::string OpenTestPoint::Toolkit::Log::Arguments::format(const char * pzFormat,
+                                                           const char * pArguments,
+                                                           std::size_t length)
+{
+  std::string sOutput{};
+
+  Reader reader{pArguments,length};
+
+  const char * pzNext{pzFormat};
+
+  while(*pzNext)
+    {
+      if(*pzNext != '%')
+        {
+          const char * pzPercent{std::strchr(pzNext,'%')};
+
+          if(!pzPercent)
+            {
+              sOutput.append(pzNext);
+              break;
+            }
+
+          sOutput.append(pzNext,pzPercent - pzNext);
+
+          pzNext = pzPercent;
+
+          continue;
+        }
+
+      if(pzNext[1] == '%')
+        {
+          sOutput.push_back('%');
+          pzNext += 2;
+          continue;
+        }
+
+      const char * pzSpecification{pzNext++};
+
+      std::string sSpecification{"%"};
+
+      bool bValid{true};
+
+      while(*pzNext && std::strchr("-+ #0'",*pzNext))
+        {
+          sSpecification.push_back(*pzNext++);
+        }
+
+      for(int i = 0; i < 2; ++i)
+        {
+          // width then precision
+          if(i == 1)
+            {
+              if(*pzNext != '.')
+                {
+                  break;
+                }
+
+              sSpecification.push_back(*pzNext++);
+            }
+
+          if(*pzNext == '*')
+            {
+              Arguments::Type type{};
+              int iValue{};
+
+              if(reader.type(type) && type == TYPE_INT && reader.value(iValue))
+                {
+                  sSpecification.append(std::to_string(iValue));
+                }
+              else
+                {
+                  bValid = false;
+                }
+
+              ++pzNext;
+            }
+          else
+            {
+              while(*pzNext >= '0' && *pzNext <= '9')
+                {
+                  sSpecification.push_back(*pzNext++);
+                }
+            }
+        }
+
+      // the length modifier comes from the encoded type
+      while(*pzNext && std::strchr("hlLqjzt",*pzNext))
+        {
+          ++pzNext;
+        }
+
+      char conversion{*pzNext};
+
+      if(!conversion)
+        {
+          sOutput.append(pzSpecification);
+          break;
+        }
+
+      ++pzNext;
+
+      if(!bValid || !::format(sOutput,sSpecification,conversion,reader))
+        {
+          sOutput.append(pzSpecification,pzNext - pzSpecification);
+        }
+    }
+
+  return sOutput;
+}
+
+void OpenTestPoint::Toolkit::Log::Client::logDeferred_i(Level level,
+                                                        const std::chrono::high_resolution_clock::time_point & timestamp,
+                                                        const char * pzFormat,
+                                                        const Arguments & arguments)
+{
+  log_i(level,timestamp,{Arguments::format(pzFormat,arguments.data(),arguments.size())});
+}
@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2026 - Adjacent Link LLC, Bridgewater, New Jersey
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  * Neither the name of Adjacent Link LLC nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * See toplevel COPYING for more information.
+ */
+
+// Measures the caller side cost of a log call through the log client:
+// printf style formatting on the calling thread versus the deferred
+// path that records the format and encoded arguments. Every message
+// level is logged at every client level, reporting nanoseconds per
+// call. Calls are made in batches the client drains between.
+
+#include "otestpoint/toolkit/log/clientbuilder.h"
+#include "otestpoint/toolkit/log/client.h"
+#include "logservice.pb.h"
+#include "logutils.h"
+#include "benchmeasure.h"
+
+#include <zmq.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <thread>
+
+namespace
+{
+  using OpenTestPoint::Toolkit::Log::Level;
+
+  const std::size_t BATCH{256};
+
+  void setLevel(void * pControl, Level level)
+  {
+    OpenTestPoint_Toolkit::LogClient request{};
+
+    request.set_type(OpenTestPoint_Toolkit::LogClient::TYPE_SETLOGLEVEL);
+
+    request.mutable_setloglevel()->set_level(OpenTestPoint::Toolkit::Log::convertLogLevel(level));
+
+    std::string sSerialization{};
+
+    request.SerializeToString(&sSerialization);
+
+    zmq_send(pControl,sSerialization.c_str(),sSerialization.size(),0);
+
+    char buf[256];
+
+    zmq_recv(pControl,buf,sizeof(buf),0);
+  }
+
+  template<typename Function>
+  void report(const char * pzPath,
+              Level clientLevel,
+              Level messageLevel,
+              std::size_t calls,
+              Function fn)
+  {
+    double dTotal{};
+
+    std::size_t batches{};
+
+    for(std::size_t i = 0; i < calls; i += BATCH, ++batches)
+      {
+        dTotal += OpenTestPoint::Bench::measure(0,BATCH,
+                                                [&fn,messageLevel,i](std::size_t j)
+                                                {
+                                                  fn(messageLevel,i + j);
+                                                });
+
+        // let the client drain its ring
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+
+    std::printf("%-9s client=%-6s message=%-6s ns/call=%.1f\n",
+                pzPath,
+                OpenTestPoint::Toolkit::Log::logLevelToString(clientLevel).c_str(),
+                OpenTestPoint::Toolkit::Log::logLevelToString(messageLevel).c_str(),
+                batches ? dTotal / batches : 0.0);
+  }
+}
+
+int main(int argc, char * argv[])
+{
+  std::size_t calls{argc > 1 ? std::strtoul(argv[1],nullptr,10) : 25600};
+
+  std::unique_ptr<OpenTestPoint::Toolkit::Log::Client>
+    pClient{OpenTestPoint::Toolkit::Log::ClientBuilder{}.buildClient("/bench")};
+
+  void * pContext{zmq_ctx_new()};
+
+  void * pControl{zmq_socket(pContext,ZMQ_REQ)};
+
+  zmq_connect(pControl,pClient->getControlEndpoint().c_str());
+
+  const std::string sTopic{"Probes.TimeOfDay.node1"};
+
+  for(auto clientLevel : {Level::NOLOG_LEVEL,
+        Level::ERROR_LEVEL,
+        Level::INFO_LEVEL,
+        Level::DEBUG_LEVEL})
+    {
+      setLevel(pControl,clientLevel);
+
+      for(auto messageLevel : {Level::ERROR_LEVEL,
+            Level::INFO_LEVEL,
+            Level::DEBUG_LEVEL})
+        {
+          report("immediate",clientLevel,messageLevel,calls,
+                  [&pClient,&sTopic](Level level, std::size_t i)
+                  {
+                    pClient->log(level,"/manager sending %s index %zu",sTopic.c_str(),i);
+                  });
+
+          report("deferred",clientLevel,messageLevel,calls,
+                  [&pClient,&sTopic](Level level, std::size_t i)
+                  {
+                    OPENTESTPOINT_TOOLKIT_LOG_DEFERRED(pClient,
+                                                       level,
+                                                       "/manager sending %s index %zu",
+                                                       sTopic.c_str(),
+                                                       i);
+                  });
+        }
+    }
+
+  zmq_close(pControl);
+
+  zmq_ctx_destroy(pContext);
+
+  return 0;
+}
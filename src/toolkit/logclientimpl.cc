@@ -33,93 +33,81 @@
  */
 
 #include "logclientimpl.h"
-#include "logservice.pb.h"
-#include "logutils.h"
 #include "otestpoint/toolkit/exception.h"
-#include "otestpoint/toolkit/transaction.h"
 
+#include <algorithm>
 #include <chrono>
-#include <zmq.h>
-#include <iostream>
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
 
-
-OpenTestPoint::Toolkit::Log::ClientImpl::ClientImpl(const std::string & sLabel):
-  Client{sLabel},
-  sInternalEndpoint_{std::string{"inproc://loggerimpl."}
-    + std::to_string(reinterpret_cast<unsigned long>(this))},
-  level_{Level::NOLOG_LEVEL}
+namespace
 {
-  pContext_.reset(zmq_ctx_new());
+  // records per producer thread ring, must be a power of 2
+  const std::size_t RING_CAPACITY{512};
 
-  if(!pContext_)
-    {
-      throw Exception{"Error creating new controller messaging context: %s",
-          zmq_strerror(errno)};
-    }
+  std::atomic<std::uint64_t> clientIds{};
 
-  pPublishSocket_.reset(zmq_socket(pContext_.get(),ZMQ_PUB));
+  // rings of the calling thread, one per client it has logged to
+  thread_local std::vector<std::pair<std::uint64_t,
+                                     std::shared_ptr<OpenTestPoint::Toolkit::Log::Ring>>> threadRings{};
+}
 
-  if(!pPublishSocket_)
+OpenTestPoint::Toolkit::Log::ClientImpl::ClientImpl(const std::string & sLabel):
+  Client{sLabel},
+  level_{Level::NOLOG_LEVEL},
+  u64Id_{++clientIds},
+  pMultiplexer_{Multiplexer::instance()},
+  pCounters_{std::make_shared<Counters>()}
+{
+  for(auto & rateLimit : rateLimits_)
     {
-      throw Exception{"unable to create logger publish socket: %s",
-          zmq_strerror(errno)};
+      rateLimit.dRate = 0;
+      rateLimit.dBurst = 0;
     }
 
-  if(zmq_bind(pPublishSocket_.get(), "tcp://127.0.0.1:*") < 0)
-    {
-      throw Exception{"unable to bind to logger publish endpoint:  %s",
-          zmq_strerror(errno)};
-    }
+  pMultiplexer_->attach(this);
+}
 
-  char buf[1024];
-  size_t len{sizeof(buf)};
+OpenTestPoint::Toolkit::Log::ClientImpl::~ClientImpl()
+{
+  pMultiplexer_->detach(this,u64Id_);
+}
 
-  if(zmq_getsockopt(pPublishSocket_.get(),ZMQ_LAST_ENDPOINT,buf,&len))
-    {
-      throw Toolkit::Exception{"unable to determine logger publish endpoint : %s",
-          zmq_strerror(errno)};
-    }
+void OpenTestPoint::Toolkit::Log::ClientImpl::setLevel(Level level)
+{
+  level_.store(level,std::memory_order_relaxed);
+}
 
-  sPublishEndpoint_ = buf;
+const std::string & OpenTestPoint::Toolkit::Log::ClientImpl::getLabel() const
+{
+  return sLabel_;
+}
 
-  pInternalSocket_.reset(zmq_socket(pContext_.get(),ZMQ_PAIR));
+void OpenTestPoint::Toolkit::Log::ClientImpl::setRateLimit(Level level,
+                                                           double dRate,
+                                                           double dBurst)
+{
+  auto index = static_cast<std::size_t>(level);
 
-  if(!pInternalSocket_)
+  if(index >= rateLimits_.size())
     {
-      throw Exception{"unable to create internal logger frontend socket: %s ",
-          zmq_strerror(errno)};
+      throw Exception{"invalid log level: %zu",index};
     }
 
-  if(zmq_bind(pInternalSocket_.get(),sInternalEndpoint_.c_str()) < 0)
+  if(dRate < 0 || dBurst < 0)
     {
-      throw Exception{"unable to bind internal logger frontend socket:  %s ",
-          zmq_strerror(errno)};
+      throw Exception{"invalid log rate limit: %f/s burst %f",dRate,dBurst};
     }
 
-
-  thread_ = std::move(std::thread(&ClientImpl::process,this));
-
-  zmq_msg_t message;
-
-  zmq_msg_init(&message);
-
-  zmq_msg_recv(&message,pInternalSocket_.get(),0);
-
-  sControlEndpoint_ = std::string{reinterpret_cast<const char *>(zmq_msg_data(&message)),
-                                  zmq_msg_size(&message)};
-
-  zmq_msg_close(&message);
-}
-
-OpenTestPoint::Toolkit::Log::ClientImpl::~ClientImpl()
-{
-  zmq_send(pInternalSocket_.get(),"end",3,0);
-  thread_.join();
+  // a burst of at least one record, otherwise nothing is ever allowed
+  rateLimits_[index].dBurst.store(std::max(dBurst,1.0),std::memory_order_relaxed);
+  rateLimits_[index].dRate.store(dRate,std::memory_order_relaxed);
 }
 
 void OpenTestPoint::Toolkit::Log::ClientImpl::log(Level level, const char *fmt,...)
 {
-  if(allowLog_i(level))
+  if(allowLog_i(level) && allowSite_i(level,fmt))
     {
       auto now = std::chrono::high_resolution_clock::now();
 
@@ -129,17 +117,23 @@ void OpenTestPoint::Toolkit::Log::ClientImpl::log(Level level, const char *fmt,.
 
       va_start(ap, fmt);
 
-      vsnprintf(buff,sizeof(buff),fmt,ap);
+      int iLength{vsnprintf(buff,sizeof(buff),fmt,ap)};
 
       va_end(ap);
 
-      log_i(level,now,{buff});
+      if(iLength >= 0)
+        {
+          append(level,
+                 now,
+                 buff,
+                 std::min(static_cast<std::size_t>(iLength),sizeof(buff) - 1));
+        }
     }
 }
 
 bool OpenTestPoint::Toolkit::Log::ClientImpl::allowLog_i(Level level)
 {
-  Level cached = level_;
+  Level cached = level_.load(std::memory_order_relaxed);
 
   if(static_cast<int>(level) <= static_cast<int>(cached))
     {
@@ -147,174 +141,226 @@ bool OpenTestPoint::Toolkit::Log::ClientImpl::allowLog_i(Level level)
     }
   else
     {
+      pCounters_->u64Filtered.fetch_add(1,std::memory_order_relaxed);
+
       return false;
     }
 }
 
-void OpenTestPoint::Toolkit::Log::ClientImpl::log_i(Level level,
-                                                    const std::chrono::high_resolution_clock::time_point & timestamp,
-                                                    const std::list<std::string> & strings)
+bool OpenTestPoint::Toolkit::Log::ClientImpl::allowSite_i(Level level, const void * pSite)
 {
-  OpenTestPoint_Toolkit::LogPublisher message;
+  auto & rateLimit = rateLimits_[static_cast<std::size_t>(level)];
+
+  double dRate{rateLimit.dRate.load(std::memory_order_relaxed)};
 
-  message.set_type(OpenTestPoint_Toolkit::LogPublisher::TYPE_RECORD);
+  if(dRate <= 0)
+    {
+      return true;
+    }
 
-  auto pRecord = message.mutable_record();
+  double dBurst{rateLimit.dBurst.load(std::memory_order_relaxed)};
 
-  pRecord->set_level(convertLogLevel(level));
+  Ring * pRing{ring()};
 
-  pRecord->set_label(sLabel_);
+  auto & bucket = pRing->bucket(pSite,level);
 
-  pRecord->set_timestamp(std::chrono::duration_cast<std::chrono::microseconds>(timestamp.time_since_epoch()).count());
+  auto now = std::chrono::high_resolution_clock::now();
 
-  for(const auto & log : strings)
-    {
-      pRecord->add_logs(log);
-    }
+  std::int64_t i64Now{std::chrono::duration_cast<std::chrono::microseconds>(now.time_since_epoch()).count()};
 
-  std::string sSerialization{};
+  std::int64_t i64Updated{bucket.i64Updated.load(std::memory_order_relaxed)};
 
-  if(message.SerializeToString(&sSerialization))
+  // a new call site starts with a full bucket
+  if(!i64Updated)
     {
-      zmq_send(pPublishSocket_.get(),"log",3,ZMQ_SNDMORE);
-      zmq_send(pPublishSocket_.get(),sSerialization.c_str(),sSerialization.length(),0);
+      bucket.dTokens = dBurst;
+    }
+  else
+    {
+      bucket.dTokens = std::min(dBurst,
+                                bucket.dTokens + (i64Now - i64Updated) * dRate / 1000000);
     }
-}
-
-std::string OpenTestPoint::Toolkit::Log::ClientImpl::getControlEndpoint() const
-{
-  return sControlEndpoint_;
-}
 
-std::string OpenTestPoint::Toolkit::Log::ClientImpl::getPublishEndpoint() const
-{
-  return sPublishEndpoint_;
-}
+  bucket.i64Updated.store(i64Now,std::memory_order_relaxed);
 
-void OpenTestPoint::Toolkit::Log::ClientImpl::process()
-{
-  try
+  if(bucket.dTokens < 1)
     {
-      RAIIZMQSocket pControlSocket{zmq_socket(pContext_.get(),ZMQ_REP)};
+      bucket.i64Interval.store(static_cast<std::int64_t>(1000000 / dRate),std::memory_order_relaxed);
 
-      if(!pControlSocket)
+      if(!bucket.u32Suppressed.fetch_add(1,std::memory_order_relaxed))
         {
-          throw Exception{"unable to create log client control socket: %s",
-              zmq_strerror(errno)};
+          pMultiplexer_->suppressed();
         }
 
-      if(zmq_bind(pControlSocket.get(),"tcp://127.0.0.1:*") < 0)
-        {
-          throw Exception{"unable to bind log client control endpoint:  %s",
-              zmq_strerror(errno)};
-        }
+      pCounters_->u64Filtered.fetch_add(1,std::memory_order_relaxed);
 
-      char buf[1024];
-      size_t len{sizeof(buf)};
+      return false;
+    }
 
-      if(zmq_getsockopt(pControlSocket.get(),ZMQ_LAST_ENDPOINT,buf,&len))
-        {
-          throw Toolkit::Exception{"unable to determine log client control endpoint : %s",
-              zmq_strerror(errno)};
-        }
+  bucket.dTokens -= 1;
 
-      RAIIZMQSocket pInternalSocket{zmq_socket(pContext_.get(),ZMQ_PAIR)};
+  // the multiplexer may have published the count already
+  std::uint32_t u32Suppressed{bucket.u32Suppressed.exchange(0,std::memory_order_relaxed)};
 
-      if(!pInternalSocket)
-        {
-          throw Exception{"unable to create internal log client backend socket: %s (%s)",
-              zmq_strerror(errno),
-              sInternalEndpoint_.c_str()};
-        }
+  if(u32Suppressed)
+    {
+      char buf[64];
 
-      if(zmq_connect(pInternalSocket.get(),sInternalEndpoint_.c_str()) < 0)
-        {
-          throw Exception{"unable to connect internal log client backend socket:  %s (%s)",
-              zmq_strerror(errno),
-              sInternalEndpoint_.c_str()};
-        }
+      int iLength{snprintf(buf,sizeof(buf),"/log %u repeats suppressed",u32Suppressed)};
 
-      zmq_send(pInternalSocket.get(),buf,strlen(buf),0);
+      append(level,now,buf,iLength);
+    }
 
-      bool bRun{true};
+  return true;
+}
 
-      while(bRun)
-        {
-          zmq_pollitem_t items[] =
-            {
-              {pControlSocket.get(),0,ZMQ_POLLIN,0},
-              {pInternalSocket.get(),0,ZMQ_POLLIN,0},
-            };
+void OpenTestPoint::Toolkit::Log::ClientImpl::log_i(Level level,
+                                                    const std::chrono::high_resolution_clock::time_point & timestamp,
+                                                    const std::list<std::string> & strings)
+{
+  if(strings.empty())
+    {
+      return;
+    }
 
-          int rc = zmq_poll(items, 2, -1);
+  Ring * pRing{ring()};
 
-          if(rc == -1)
-            {
-              continue;
-            }
+  std::size_t records{};
 
-          if(items[0].revents & ZMQ_POLLIN)
-            {
-              zmq_msg_t message;
+  std::size_t bytes{};
 
-              zmq_msg_init(&message);
+  for(const auto & log : strings)
+    {
+      records += Ring::records(log.size());
 
-              int iSize = zmq_msg_recv(&message,pControlSocket.get(),0);
+      bytes += log.size();
+    }
 
-              OpenTestPoint_Toolkit::LogClient request{};
+  if(!pRing->reserve(records))
+    {
+      pRing->drop();
+      pMultiplexer_->signal(true);
+      return;
+    }
 
-              if(iSize > 0)
-                {
-                  if(!request.ParseFromArray(zmq_msg_data(&message),zmq_msg_size(&message)))
-                    {
-                      sendFailureResponse<OpenTestPoint_Toolkit::LogServer>(pControlSocket.get(),
-                                                                            "unknown message");
-                      zmq_msg_close(&message);
-                    }
-                  else
-                    {
-                      switch(request.type())
-                        {
-                        case OpenTestPoint_Toolkit::LogClient::TYPE_SETLOGLEVEL:
+  std::int64_t i64Timestamp{std::chrono::duration_cast<std::chrono::microseconds>(timestamp.time_since_epoch()).count()};
 
-                          if(request.has_setloglevel())
-                            {
-                              const auto setLogLevel = request.setloglevel();
+  std::uint64_t u64Head{pRing->head()};
 
-                              level_ = convertLogLevel(setLogLevel.level());
+  for(const auto & log : strings)
+    {
+      pRing->write(u64Head,level,i64Timestamp,log.data(),log.size());
+    }
 
-                              sendSuccessResponse<OpenTestPoint_Toolkit::LogServer>(pControlSocket.get());
-                            }
-                          else
-                            {
-                              sendFailureResponse<OpenTestPoint_Toolkit::LogServer>(pControlSocket.get(),
-                                                                                    "invalid message format");
-                            }
+  commit(pRing,u64Head,level,bytes);
+}
 
-                          break;
-                        }
-                    }
-                }
+void OpenTestPoint::Toolkit::Log::ClientImpl::logDeferred_i(Level level,
+                                                            const std::chrono::high_resolution_clock::time_point & timestamp,
+                                                            const char * pzFormat,
+                                                            const Arguments & arguments)
+{
+  append(level,timestamp,arguments.data(),arguments.size(),pzFormat);
+}
 
-              zmq_msg_close(&message);
-            }
+void OpenTestPoint::Toolkit::Log::ClientImpl::append(Level level,
+                                                     const std::chrono::high_resolution_clock::time_point & timestamp,
+                                                     const char * pData,
+                                                     std::size_t length,
+                                                     const char * pzFormat)
+{
+  Ring * pRing{ring()};
 
-          if(items[1].revents & ZMQ_POLLIN)
-            {
-              zmq_msg_t message;
+  // the format is copied ahead of its arguments, it may belong to a
+  // library unloaded before the record is drained
+  std::size_t formatLength{pzFormat ? std::strlen(pzFormat) : 0};
 
-              zmq_msg_init(&message);
+  if(!pRing->reserve((pzFormat ? Ring::records(formatLength) : 0) + Ring::records(length)))
+    {
+      pRing->drop();
+      pMultiplexer_->signal(true);
+      return;
+    }
 
-              zmq_msg_recv(&message,pInternalSocket.get(),0);
+  std::uint64_t u64Head{pRing->head()};
 
-              zmq_msg_close(&message);
+  std::int64_t i64Timestamp{std::chrono::duration_cast<std::chrono::microseconds>(timestamp.time_since_epoch()).count()};
 
-              bRun = false;
-            }
-        }
+  if(pzFormat)
+    {
+      pRing->write(u64Head,level,i64Timestamp,pzFormat,formatLength,Record::FORMAT);
     }
-  catch(Exception & exp)
+
+  pRing->write(u64Head,level,i64Timestamp,pData,length);
+
+  commit(pRing,u64Head,level,formatLength + length);
+}
+
+void OpenTestPoint::Toolkit::Log::ClientImpl::commit(Ring * pRing,
+                                                     std::uint64_t u64Head,
+                                                     Level level,
+                                                     std::size_t bytes)
+{
+  pRing->commit(u64Head);
+
+  pCounters_->u64Emitted.fetch_add(1,std::memory_order_relaxed);
+
+  pCounters_->u64Bytes.fetch_add(bytes,std::memory_order_relaxed);
+
+  // errors and a ring past half full are published without waiting
+  // for the flush interval
+  pMultiplexer_->signal(static_cast<int>(level) <= static_cast<int>(Level::ERROR_LEVEL) ||
+                        pRing->size() > pRing->capacity() / 2);
+}
+
+OpenTestPoint::Toolkit::Log::Ring * OpenTestPoint::Toolkit::Log::ClientImpl::ring()
+{
+  for(const auto & entry : threadRings)
     {
-      std::cerr<<exp.what();
+      if(entry.first == u64Id_)
+        {
+          return entry.second.get();
+        }
     }
+
+  // first log from this thread, drop rings of destroyed clients
+  threadRings.erase(std::remove_if(threadRings.begin(),
+                                   threadRings.end(),
+                                   [](const std::pair<std::uint64_t,std::shared_ptr<Ring>> & entry)
+                                   {
+                                     return entry.second->closed();
+                                   }),
+                    threadRings.end());
+
+  auto pRing = std::make_shared<Ring>(RING_CAPACITY,sLabel_,u64Id_,pCounters_);
+
+  pMultiplexer_->add(pRing);
+
+  threadRings.emplace_back(u64Id_,pRing);
+
+  return pRing.get();
+}
+
+std::string OpenTestPoint::Toolkit::Log::ClientImpl::getControlEndpoint() const
+{
+  return pMultiplexer_->getControlEndpoint();
+}
+
+std::string OpenTestPoint::Toolkit::Log::ClientImpl::getPublishEndpoint() const
+{
+  return pMultiplexer_->getPublishEndpoint();
+}
+
+OpenTestPoint::Toolkit::Log::ClientStatistics
+OpenTestPoint::Toolkit::Log::ClientImpl::getStatistics() const
+{
+  ClientStatistics statistics{};
+
+  statistics.sLabel = sLabel_;
+  statistics.u64Emitted = pCounters_->u64Emitted.load(std::memory_order_relaxed);
+  statistics.u64Filtered = pCounters_->u64Filtered.load(std::memory_order_relaxed);
+  statistics.u64Dropped = pCounters_->u64Dropped.load(std::memory_order_relaxed);
+  statistics.u64Bytes = pCounters_->u64Bytes.load(std::memory_order_relaxed);
+
+  return statistics;
 }
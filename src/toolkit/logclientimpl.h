@@ -36,10 +36,12 @@
 #define OPENTESTPOINT_TOOLKIT_LOGGERIMPL_HEADER_
 
 #include "otestpoint/toolkit/log/client.h"
-#include "otestpoint/toolkit/raiizmq.h"
+#include "logmultiplexer.h"
+#include "logring.h"
 
+#include <array>
 #include <atomic>
-#include <thread>
+#include <memory>
 
 namespace OpenTestPoint
 {
@@ -61,32 +63,60 @@ namespace OpenTestPoint
 
         virtual std::string getPublishEndpoint() const override;
 
+        ClientStatistics getStatistics() const override;
+
+        void setRateLimit(Level level, double dRate, double dBurst) override;
+
+        // applied by the process log multiplexer
+        void setLevel(Level level);
+
+        const std::string & getLabel() const;
+
       private:
         bool allowLog_i(Level level) override;
 
+        bool allowSite_i(Level level, const void * pSite) override;
+
         void log_i(Level level,
                    const std::chrono::high_resolution_clock::time_point & timestamp,
                    const std::list<std::string> & strings) override;
 
-        RAIIZMQContext pContext_;
+        void logDeferred_i(Level level,
+                           const std::chrono::high_resolution_clock::time_point & timestamp,
+                           const char * pzFormat,
+                           const Arguments & arguments) override;
 
-        RAIIZMQSocket pInternalSocket_;
+        std::atomic<Level> level_;
 
-        RAIIZMQSocket pControlSocket_;
+        struct RateLimit
+        {
+          std::atomic<double> dRate;
+          std::atomic<double> dBurst;
+        };
 
-        RAIIZMQSocket pPublishSocket_;
+        // indexed by level
+        std::array<RateLimit,5> rateLimits_;
 
-        std::string sInternalEndpoint_;
+        // identifies the client in the per thread ring lookup, never
+        // reused unlike the client address
+        std::uint64_t u64Id_;
 
-        std::atomic<Level> level_;
+        std::shared_ptr<Multiplexer> pMultiplexer_;
 
-        std::thread thread_;
+        std::shared_ptr<Counters> pCounters_;
 
-        std::string sControlEndpoint_;
+        Ring * ring();
 
-        std::string sPublishEndpoint_;
+        void append(Level level,
+                    const std::chrono::high_resolution_clock::time_point & timestamp,
+                    const char * pData,
+                    std::size_t length,
+                    const char * pzFormat = nullptr);
 
-        void process();
+        void commit(Ring * pRing,
+                    std::uint64_t u64Head,
+                    Level level,
+                    std::size_t bytes);
       };
     }
   }
@@ -0,0 +1,726 @@
+/*
+ * Copyright (c) 2026 - Adjacent Link LLC, Bridgewater, New Jersey
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  * Neither the name of Adjacent Link LLC nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * See toplevel COPYING for more information.
+ */
+
+#include "logmultiplexer.h"
+#include "logclientimpl.h"
+#include "logutils.h"
+#include "otestpoint/toolkit/exception.h"
+#include "otestpoint/toolkit/transaction.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <zmq.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+namespace
+{
+  // records accumulate for at most this long before being published
+  const std::chrono::milliseconds FLUSH_INTERVAL{10};
+
+  // suppressed counts of quiet call sites are published this often
+  const std::chrono::milliseconds SUMMARY_INTERVAL{1000};
+
+  // frames are split once their records exceed this many bytes
+  const std::size_t MAX_FRAME_SIZE{262144};
+
+  // see Service::setLevelRules
+  bool matches(const std::string & sPattern, const std::string & sLabel)
+  {
+    std::size_t offset{};
+
+    if(!sPattern.empty() && sPattern[0] == '/')
+      {
+        offset = sLabel.find('/');
+
+        if(offset == std::string::npos)
+          {
+            return false;
+          }
+      }
+
+    std::size_t length{sLabel.size() - offset};
+
+    if(sPattern.size() >= 2 && !sPattern.compare(sPattern.size() - 2,2,"/*"))
+      {
+        std::size_t base{sPattern.size() - 2};
+
+        return !sLabel.compare(offset,base,sPattern,0,base) &&
+          (length == base || (length > base && sLabel[offset + base] == '/'));
+      }
+    else if(!sPattern.empty() && sPattern.back() == '*')
+      {
+        std::size_t base{sPattern.size() - 1};
+
+        return length >= base && !sLabel.compare(offset,base,sPattern,0,base);
+      }
+
+    return !sLabel.compare(offset,std::string::npos,sPattern);
+  }
+
+  std::int64_t now()
+  {
+    return std::chrono::duration_cast<std::chrono::microseconds>
+      (std::chrono::high_resolution_clock::now().time_since_epoch()).count();
+  }
+
+  std::mutex instanceMutex{};
+
+  std::weak_ptr<OpenTestPoint::Toolkit::Log::Multiplexer> instanceWeak{};
+}
+
+std::shared_ptr<OpenTestPoint::Toolkit::Log::Multiplexer>
+OpenTestPoint::Toolkit::Log::Multiplexer::instance()
+{
+  std::lock_guard<std::mutex> lock(instanceMutex);
+
+  auto pMultiplexer = instanceWeak.lock();
+
+  if(!pMultiplexer)
+    {
+      pMultiplexer.reset(new Multiplexer{});
+
+      instanceWeak = pMultiplexer;
+    }
+
+  return pMultiplexer;
+}
+
+OpenTestPoint::Toolkit::Log::ClientStatisticsList
+OpenTestPoint::Toolkit::Log::getClientStatistics()
+{
+  std::shared_ptr<Multiplexer> pMultiplexer{};
+
+  {
+    std::lock_guard<std::mutex> lock(instanceMutex);
+
+    pMultiplexer = instanceWeak.lock();
+  }
+
+  // no clients in the process
+  if(!pMultiplexer)
+    {
+      return {};
+    }
+
+  return pMultiplexer->getClientStatistics();
+}
+
+OpenTestPoint::Toolkit::Log::Multiplexer::Multiplexer():
+  sInternalEndpoint_{std::string{"inproc://logmultiplexer."}
+    + std::to_string(reinterpret_cast<unsigned long>(this))},
+  level_{Level::NOLOG_LEVEL},
+  iEventFd_{eventfd(0,EFD_NONBLOCK | EFD_CLOEXEC)},
+  bPending_{},
+  bUrgent_{},
+  bSuppressed_{},
+  pRecord_{},
+  pLog_{},
+  bytes_{}
+{
+  if(iEventFd_ < 0)
+    {
+      throw Exception{"unable to create log multiplexer event: %s",
+          strerror(errno)};
+    }
+
+  message_.set_type(OpenTestPoint_Toolkit::LogPublisher::TYPE_RECORDS);
+
+  pContext_.reset(zmq_ctx_new());
+
+  if(!pContext_)
+    {
+      throw Exception{"Error creating new log multiplexer messaging context: %s",
+          zmq_strerror(errno)};
+    }
+
+  pPublishSocket_.reset(zmq_socket(pContext_.get(),ZMQ_PUB));
+
+  if(!pPublishSocket_)
+    {
+      throw Exception{"unable to create logger publish socket: %s",
+          zmq_strerror(errno)};
+    }
+
+  if(zmq_bind(pPublishSocket_.get(), "tcp://127.0.0.1:*") < 0)
+    {
+      throw Exception{"unable to bind to logger publish endpoint:  %s",
+          zmq_strerror(errno)};
+    }
+
+  char buf[1024];
+  size_t len{sizeof(buf)};
+
+  if(zmq_getsockopt(pPublishSocket_.get(),ZMQ_LAST_ENDPOINT,buf,&len))
+    {
+      throw Toolkit::Exception{"unable to determine logger publish endpoint : %s",
+          zmq_strerror(errno)};
+    }
+
+  sPublishEndpoint_ = buf;
+
+  pInternalSocket_.reset(zmq_socket(pContext_.get(),ZMQ_PAIR));
+
+  if(!pInternalSocket_)
+    {
+      throw Exception{"unable to create internal log multiplexer frontend socket: %s ",
+          zmq_strerror(errno)};
+    }
+
+  if(zmq_bind(pInternalSocket_.get(),sInternalEndpoint_.c_str()) < 0)
+    {
+      throw Exception{"unable to bind internal log multiplexer frontend socket:  %s ",
+          zmq_strerror(errno)};
+    }
+
+  thread_ = std::thread(&Multiplexer::process,this);
+
+  zmq_msg_t message;
+
+  zmq_msg_init(&message);
+
+  zmq_msg_recv(&message,pInternalSocket_.get(),0);
+
+  sControlEndpoint_ = std::string{reinterpret_cast<const char *>(zmq_msg_data(&message)),
+                                  zmq_msg_size(&message)};
+
+  zmq_msg_close(&message);
+}
+
+OpenTestPoint::Toolkit::Log::Multiplexer::~Multiplexer()
+{
+  zmq_send(pInternalSocket_.get(),"end",3,0);
+
+  thread_.join();
+
+  for(const auto & pRing : rings_)
+    {
+      pRing->close();
+    }
+
+  close(iEventFd_);
+}
+
+void OpenTestPoint::Toolkit::Log::Multiplexer::attach(ClientImpl * pClient)
+{
+  std::lock_guard<std::mutex> lock(clientsMutex_);
+
+  clients_.insert(pClient);
+
+  pClient->setLevel(resolve(pClient->getLabel()));
+}
+
+void OpenTestPoint::Toolkit::Log::Multiplexer::detach(ClientImpl * pClient,
+                                                      std::uint64_t u64Id)
+{
+  {
+    std::lock_guard<std::mutex> lock(clientsMutex_);
+
+    clients_.erase(pClient);
+  }
+
+  // pending records are still published, the rings are released
+  // once drained
+  std::lock_guard<std::mutex> lock(ringsMutex_);
+
+  for(const auto & pRing : rings_)
+    {
+      if(pRing->owner() == u64Id)
+        {
+          pRing->close();
+        }
+    }
+}
+
+void OpenTestPoint::Toolkit::Log::Multiplexer::add(const std::shared_ptr<Ring> & pRing)
+{
+  std::lock_guard<std::mutex> lock(ringsMutex_);
+
+  rings_.push_back(pRing);
+}
+
+void OpenTestPoint::Toolkit::Log::Multiplexer::signal(bool bUrgent)
+{
+  // the exchange orders the ring commit before the process thread
+  // clears the flag and flushes
+  if(bUrgent)
+    {
+      if(!bUrgent_.exchange(true))
+        {
+          eventfd_write(iEventFd_,1);
+        }
+    }
+  else if(!bPending_.exchange(true))
+    {
+      eventfd_write(iEventFd_,1);
+    }
+}
+
+void OpenTestPoint::Toolkit::Log::Multiplexer::suppressed()
+{
+  if(!bSuppressed_.exchange(true))
+    {
+      eventfd_write(iEventFd_,1);
+    }
+}
+
+const std::string & OpenTestPoint::Toolkit::Log::Multiplexer::getControlEndpoint() const
+{
+  return sControlEndpoint_;
+}
+
+const std::string & OpenTestPoint::Toolkit::Log::Multiplexer::getPublishEndpoint() const
+{
+  return sPublishEndpoint_;
+}
+
+OpenTestPoint::Toolkit::Log::ClientStatisticsList
+OpenTestPoint::Toolkit::Log::Multiplexer::getClientStatistics()
+{
+  std::lock_guard<std::mutex> lock(clientsMutex_);
+
+  ClientStatisticsList statistics{};
+
+  statistics.reserve(clients_.size());
+
+  for(auto pClient : clients_)
+    {
+      statistics.push_back(pClient->getStatistics());
+    }
+
+  return statistics;
+}
+
+OpenTestPoint::Toolkit::Log::Level
+OpenTestPoint::Toolkit::Log::Multiplexer::resolve(const std::string & sLabel) const
+{
+  Level level{level_};
+
+  std::size_t longest{};
+
+  for(const auto & rule : rules_)
+    {
+      if(rule.first.size() >= longest && matches(rule.first,sLabel))
+        {
+          level = rule.second;
+
+          longest = rule.first.size();
+        }
+    }
+
+  return level;
+}
+
+void OpenTestPoint::Toolkit::Log::Multiplexer::flush()
+{
+  bPending_.exchange(false);
+  bUrgent_.exchange(false);
+
+  std::lock_guard<std::mutex> lock(ringsMutex_);
+
+  for(auto iter = rings_.begin(); iter != rings_.end();)
+    {
+      const Ring & ring{**iter};
+
+      (*iter)->drain([this,&ring](const Record & record)
+                     {
+                       publish(ring,record);
+                     });
+
+      std::uint64_t u64Dropped{(*iter)->dropped()};
+
+      if(u64Dropped)
+        {
+          publish(ring,
+                  Level::ERROR_LEVEL,
+                  "/log dropped " + std::to_string(u64Dropped) + " records");
+        }
+
+      // the client has been destroyed or the producer thread has exited
+      if(((*iter)->closed() || iter->use_count() == 1) && (*iter)->empty())
+        {
+          summarize(**iter,now(),true);
+
+          iter = rings_.erase(iter);
+        }
+      else
+        {
+          ++iter;
+        }
+    }
+
+  send();
+}
+
+bool OpenTestPoint::Toolkit::Log::Multiplexer::summarize(Ring & ring,
+                                                         std::int64_t i64Now,
+                                                         bool bAll)
+{
+  return ring.summarize(i64Now,
+                        bAll,
+                        [this,&ring](Level level, std::uint32_t u32Suppressed)
+                        {
+                          publish(ring,
+                                  level,
+                                  "/log " + std::to_string(u32Suppressed) + " repeats suppressed");
+                        });
+}
+
+void OpenTestPoint::Toolkit::Log::Multiplexer::summarize()
+{
+  bSuppressed_.exchange(false);
+
+  std::lock_guard<std::mutex> lock(ringsMutex_);
+
+  std::int64_t i64Now{now()};
+
+  bool bRemaining{};
+
+  for(auto & pRing : rings_)
+    {
+      bRemaining |= summarize(*pRing,i64Now,false);
+    }
+
+  if(bRemaining)
+    {
+      bSuppressed_.exchange(true);
+    }
+
+  send();
+}
+
+void OpenTestPoint::Toolkit::Log::Multiplexer::publish(const Ring & ring,
+                                                       Level level,
+                                                       const std::string & sText)
+{
+  Record record{};
+
+  record.i64Timestamp = now();
+  record.level = level;
+  record.u16Size = std::min(sText.size(),Record::DATA_SIZE);
+  record.u8Flags = Record::END_OF_STRING | Record::END_OF_ENTRY;
+
+  std::memcpy(record.data,sText.data(),record.u16Size);
+
+  publish(ring,record);
+}
+
+void OpenTestPoint::Toolkit::Log::Multiplexer::publish(const Ring & ring,
+                                                       const Record & record)
+{
+  if(!pRecord_)
+    {
+      pRecord_ = message_.add_records();
+
+      pRecord_->set_label(ring.label());
+
+      pRecord_->set_level(convertLogLevel(record.level));
+
+      pRecord_->set_timestamp(record.i64Timestamp);
+    }
+
+  if(!pLog_)
+    {
+      // a format and its arguments are formatted by the log service
+      if(record.u8Flags & Record::FORMAT)
+        {
+          pLog_ = pRecord_->mutable_format();
+        }
+      else if(pRecord_->has_format() && !pRecord_->has_arguments())
+        {
+          pLog_ = pRecord_->mutable_arguments();
+        }
+      else
+        {
+          pLog_ = pRecord_->add_logs();
+        }
+    }
+
+  pLog_->append(record.data,record.u16Size);
+
+  bytes_ += record.u16Size;
+
+  if(record.u8Flags & Record::END_OF_STRING)
+    {
+      pLog_ = nullptr;
+    }
+
+  if(record.u8Flags & Record::END_OF_ENTRY)
+    {
+      pRecord_ = nullptr;
+
+      // records of a ring are published consecutively
+      if(frameEntries_.empty() || frameEntries_.back().first != ring.counters())
+        {
+          frameEntries_.emplace_back(ring.counters(),0);
+        }
+
+      ++frameEntries_.back().second;
+
+      if(bytes_ >= MAX_FRAME_SIZE)
+        {
+          send();
+        }
+    }
+}
+
+void OpenTestPoint::Toolkit::Log::Multiplexer::send()
+{
+  if(!message_.records_size())
+    {
+      return;
+    }
+
+  if(!message_.SerializeToString(&sSerialization_) ||
+     zmq_send(pPublishSocket_.get(),"log",3,ZMQ_SNDMORE | ZMQ_DONTWAIT) < 0 ||
+     zmq_send(pPublishSocket_.get(),sSerialization_.c_str(),sSerialization_.length(),ZMQ_DONTWAIT) < 0)
+    {
+      for(const auto & entry : frameEntries_)
+        {
+          entry.first->u64Dropped.fetch_add(entry.second,std::memory_order_relaxed);
+        }
+    }
+
+  frameEntries_.clear();
+
+  // retains the record storage for the next flush
+  message_.clear_records();
+
+  bytes_ = 0;
+}
+
+void OpenTestPoint::Toolkit::Log::Multiplexer::process()
+{
+  try
+    {
+      RAIIZMQSocket pControlSocket{zmq_socket(pContext_.get(),ZMQ_REP)};
+
+      if(!pControlSocket)
+        {
+          throw Exception{"unable to create log multiplexer control socket: %s",
+              zmq_strerror(errno)};
+        }
+
+      if(zmq_bind(pControlSocket.get(),"tcp://127.0.0.1:*") < 0)
+        {
+          throw Exception{"unable to bind log multiplexer control endpoint:  %s",
+              zmq_strerror(errno)};
+        }
+
+      char buf[1024];
+      size_t len{sizeof(buf)};
+
+      if(zmq_getsockopt(pControlSocket.get(),ZMQ_LAST_ENDPOINT,buf,&len))
+        {
+          throw Toolkit::Exception{"unable to determine log multiplexer control endpoint : %s",
+              zmq_strerror(errno)};
+        }
+
+      RAIIZMQSocket pInternalSocket{zmq_socket(pContext_.get(),ZMQ_PAIR)};
+
+      if(!pInternalSocket)
+        {
+          throw Exception{"unable to create internal log multiplexer backend socket: %s (%s)",
+              zmq_strerror(errno),
+              sInternalEndpoint_.c_str()};
+        }
+
+      if(zmq_connect(pInternalSocket.get(),sInternalEndpoint_.c_str()) < 0)
+        {
+          throw Exception{"unable to connect internal log multiplexer backend socket:  %s (%s)",
+              zmq_strerror(errno),
+              sInternalEndpoint_.c_str()};
+        }
+
+      zmq_send(pInternalSocket.get(),buf,strlen(buf),0);
+
+      using Clock = std::chrono::steady_clock;
+
+      // set while records wait for the flush interval to expire
+      bool bScheduled{};
+
+      Clock::time_point flushTime{};
+
+      Clock::time_point summaryTime{Clock::now() + SUMMARY_INTERVAL};
+
+      bool bRun{true};
+
+      while(bRun)
+        {
+          zmq_pollitem_t items[] =
+            {
+              {pControlSocket.get(),0,ZMQ_POLLIN,0},
+              {pInternalSocket.get(),0,ZMQ_POLLIN,0},
+              {nullptr,iEventFd_,ZMQ_POLLIN,0},
+            };
+
+          long lTimeout{-1};
+
+          if(bScheduled)
+            {
+              lTimeout = std::max(0L,
+                                  static_cast<long>(std::chrono::duration_cast<std::chrono::milliseconds>
+                                                    (flushTime - Clock::now()).count()));
+            }
+
+          // suppressed counts are checked while any are pending
+          if(bSuppressed_.load(std::memory_order_relaxed))
+            {
+              long lSummaryTimeout{std::max(0L,
+                                            static_cast<long>(std::chrono::duration_cast<std::chrono::milliseconds>
+                                                              (summaryTime - Clock::now()).count()))};
+
+              lTimeout = lTimeout < 0 ? lSummaryTimeout : std::min(lTimeout,lSummaryTimeout);
+            }
+
+          int rc = zmq_poll(items, 3, lTimeout);
+
+          if(rc == -1)
+            {
+              continue;
+            }
+
+          if(items[0].revents & ZMQ_POLLIN)
+            {
+              zmq_msg_t message;
+
+              zmq_msg_init(&message);
+
+              int iSize = zmq_msg_recv(&message,pControlSocket.get(),0);
+
+              OpenTestPoint_Toolkit::LogClient request{};
+
+              if(iSize > 0)
+                {
+                  if(!request.ParseFromArray(zmq_msg_data(&message),zmq_msg_size(&message)))
+                    {
+                      sendFailureResponse<OpenTestPoint_Toolkit::LogServer>(pControlSocket.get(),
+                                                                            "unknown message");
+                    }
+                  else
+                    {
+                      switch(request.type())
+                        {
+                        case OpenTestPoint_Toolkit::LogClient::TYPE_SETLOGLEVEL:
+
+                          if(request.has_setloglevel())
+                            {
+                              const auto setLogLevel = request.setloglevel();
+
+                              std::lock_guard<std::mutex> lock(clientsMutex_);
+
+                              level_ = convertLogLevel(setLogLevel.level());
+
+                              rules_.clear();
+
+                              for(const auto & rule : setLogLevel.rules())
+                                {
+                                  rules_.emplace_back(rule.label(),convertLogLevel(rule.level()));
+                                }
+
+                              for(auto pClient : clients_)
+                                {
+                                  pClient->setLevel(resolve(pClient->getLabel()));
+                                }
+
+                              sendSuccessResponse<OpenTestPoint_Toolkit::LogServer>(pControlSocket.get());
+                            }
+                          else
+                            {
+                              sendFailureResponse<OpenTestPoint_Toolkit::LogServer>(pControlSocket.get(),
+                                                                                    "invalid message format");
+                            }
+
+                          break;
+                        }
+                    }
+                }
+
+              zmq_msg_close(&message);
+            }
+
+          if(items[1].revents & ZMQ_POLLIN)
+            {
+              zmq_msg_t message;
+
+              zmq_msg_init(&message);
+
+              zmq_msg_recv(&message,pInternalSocket.get(),0);
+
+              zmq_msg_close(&message);
+
+              bRun = false;
+            }
+
+          if(items[2].revents & ZMQ_POLLIN)
+            {
+              eventfd_t count{};
+
+              eventfd_read(iEventFd_,&count);
+
+              if(!bScheduled)
+                {
+                  bScheduled = true;
+
+                  flushTime = Clock::now() + FLUSH_INTERVAL;
+                }
+            }
+
+          if(!bRun ||
+             bUrgent_.load(std::memory_order_relaxed) ||
+             (bScheduled && Clock::now() >= flushTime))
+            {
+              bScheduled = false;
+
+              flush();
+            }
+
+          if(Clock::now() >= summaryTime)
+            {
+              summaryTime = Clock::now() + SUMMARY_INTERVAL;
+
+              if(bSuppressed_.load(std::memory_order_relaxed))
+                {
+                  summarize();
+                }
+            }
+        }
+    }
+  catch(Exception & exp)
+    {
+      std::cerr<<exp.what();
+    }
+}
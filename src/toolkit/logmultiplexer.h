@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2026 - Adjacent Link LLC, Bridgewater, New Jersey
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  * Neither the name of Adjacent Link LLC nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * See toplevel COPYING for more information.
+ */
+
+#ifndef OPENTESTPOINT_TOOLKIT_LOGMULTIPLEXER_HEADER_
+#define OPENTESTPOINT_TOOLKIT_LOGMULTIPLEXER_HEADER_
+
+#include "otestpoint/toolkit/log/level.h"
+#include "otestpoint/toolkit/log/statistics.h"
+#include "otestpoint/toolkit/raiizmq.h"
+#include "logring.h"
+#include "logservice.pb.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace OpenTestPoint
+{
+  namespace Toolkit
+  {
+    namespace Log
+    {
+      class ClientImpl;
+
+      // process wide log pipeline shared by every log client: one
+      // publish endpoint, one control endpoint and one thread
+      // draining the client rings into a single frame of records per
+      // flush interval
+      class Multiplexer
+      {
+      public:
+        // the instance lives while any client holds it
+        static std::shared_ptr<Multiplexer> instance();
+
+        ~Multiplexer();
+
+        void attach(ClientImpl * pClient);
+
+        void detach(ClientImpl * pClient, std::uint64_t u64Id);
+
+        void add(const std::shared_ptr<Ring> & pRing);
+
+        // called by producers after a commit, at most one wake up per
+        // flush interval unless urgent
+        void signal(bool bUrgent);
+
+        // called by producers when a call site starts suppressing
+        // records, its count is published once the call site has been
+        // quiet for its refill interval
+        void suppressed();
+
+        const std::string & getControlEndpoint() const;
+
+        const std::string & getPublishEndpoint() const;
+
+        ClientStatisticsList getClientStatistics();
+
+      private:
+        Multiplexer();
+
+        RAIIZMQContext pContext_;
+
+        RAIIZMQSocket pInternalSocket_;
+
+        RAIIZMQSocket pPublishSocket_;
+
+        std::string sInternalEndpoint_;
+
+        std::string sControlEndpoint_;
+
+        std::string sPublishEndpoint_;
+
+        // default level and label rules, see Service::setLevelRules
+        Level level_;
+
+        std::vector<std::pair<std::string,Level>> rules_;
+
+        std::mutex clientsMutex_;
+
+        std::set<ClientImpl *> clients_;
+
+        Level resolve(const std::string & sLabel) const;
+
+        std::mutex ringsMutex_;
+
+        std::vector<std::shared_ptr<Ring>> rings_;
+
+        int iEventFd_;
+
+        std::atomic<bool> bPending_;
+
+        std::atomic<bool> bUrgent_;
+
+        std::atomic<bool> bSuppressed_;
+
+        std::thread thread_;
+
+        // process thread only
+        OpenTestPoint_Toolkit::LogPublisher message_;
+
+        OpenTestPoint_Toolkit::LogPublisher::Record * pRecord_;
+
+        std::string * pLog_;
+
+        std::size_t bytes_;
+
+        // entries in the frame per client, counted as dropped when
+        // the frame cannot be sent
+        std::vector<std::pair<std::shared_ptr<Counters>,std::uint64_t>> frameEntries_;
+
+        std::string sSerialization_;
+
+        void process();
+
+        void flush();
+
+        // publishes the counts of call sites that have stopped
+        // logging, or of every call site of the ring when bAll
+        bool summarize(Ring & ring, std::int64_t i64Now, bool bAll);
+
+        void summarize();
+
+        void publish(const Ring & ring, const Record & record);
+
+        void publish(const Ring & ring, Level level, const std::string & sText);
+
+        void send();
+      };
+    }
+  }
+}
+
+#endif // OPENTESTPOINT_TOOLKIT_LOGMULTIPLEXER_HEADER_
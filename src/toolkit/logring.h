@@ -0,0 +1,324 @@
+/*
+ * Copyright (c) 2026 - Adjacent Link LLC, Bridgewater, New Jersey
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  * Neither the name of Adjacent Link LLC nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * See toplevel COPYING for more information.
+ */
+
+#ifndef OPENTESTPOINT_TOOLKIT_LOGRING_HEADER_
+#define OPENTESTPOINT_TOOLKIT_LOGRING_HEADER_
+
+#include "otestpoint/toolkit/log/level.h"
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace OpenTestPoint
+{
+  namespace Toolkit
+  {
+    namespace Log
+    {
+      // fixed size log record fragment, a log entry is one or more
+      // consecutive records: each string ends on a record flagged
+      // END_OF_STRING and the entry ends on one flagged END_OF_ENTRY.
+      // A string flagged FORMAT holds a copy of a printf style format
+      // and the string following it holds its encoded arguments. The
+      // format is copied so a record outlives the library that logged
+      // it.
+      struct Record
+      {
+        static const std::uint8_t END_OF_STRING{0x01};
+        static const std::uint8_t END_OF_ENTRY{0x02};
+        static const std::uint8_t FORMAT{0x04};
+
+        static const std::size_t DATA_SIZE{244};
+
+        std::int64_t i64Timestamp;
+        std::uint16_t u16Size;
+        Level level;
+        std::uint8_t u8Flags;
+        char data[DATA_SIZE];
+      };
+
+      // token bucket of a rate limited call site. The suppressed
+      // count, the last call time and the refill interval are shared
+      // with the log multiplexer, which publishes the count of a call
+      // site that stops logging.
+      struct Bucket
+      {
+        double dTokens{};
+        Level level{};
+        std::atomic<std::int64_t> i64Updated{};
+        std::atomic<std::int64_t> i64Interval{};
+        std::atomic<std::uint32_t> u32Suppressed{};
+        Bucket * pNext{};
+      };
+
+      // client counters, shared with the client rings so records
+      // lost after the client is destroyed are still counted
+      struct Counters
+      {
+        std::atomic<std::uint64_t> u64Emitted{};
+        std::atomic<std::uint64_t> u64Filtered{};
+        std::atomic<std::uint64_t> u64Dropped{};
+        std::atomic<std::uint64_t> u64Bytes{};
+      };
+
+      // single producer, single consumer ring of records: written
+      // only by the thread that owns it and drained only by the log
+      // multiplexer process thread. Each ring belongs to one client
+      // and carries its label.
+      class Ring
+      {
+      public:
+        Ring(std::size_t capacity,
+             const std::string & sLabel,
+             std::uint64_t u64Owner,
+             const std::shared_ptr<Counters> & pCounters):
+          head_{},
+          tail_{},
+          bClosed_{},
+          dropped_{},
+          records_(capacity),
+          mask_{capacity - 1},
+          sLabel_{sLabel},
+          u64Owner_{u64Owner},
+          pCounters_{pCounters}{}
+
+        // producer: records needed for a string of the given length
+        static std::size_t records(std::size_t length)
+        {
+          return length ? (length + Record::DATA_SIZE - 1) / Record::DATA_SIZE : 1;
+        }
+
+        // producer: space for count records
+        bool reserve(std::size_t count) const
+        {
+          return head_.load(std::memory_order_relaxed) + count -
+            tail_.load(std::memory_order_acquire) <= records_.size();
+        }
+
+        // producer: appends a string to the reserved space, fragments
+        // become visible to the consumer on commit()
+        void write(std::uint64_t & u64Index,
+                   Level level,
+                   std::int64_t i64Timestamp,
+                   const char * pData,
+                   std::size_t length,
+                   std::uint8_t u8Flags = 0)
+        {
+          do
+            {
+              auto & record = records_[u64Index++ & mask_];
+
+              std::size_t size{length < Record::DATA_SIZE ? length : Record::DATA_SIZE};
+
+              record.i64Timestamp = i64Timestamp;
+              record.level = level;
+              record.u16Size = size;
+              record.u8Flags = u8Flags | (size == length ? Record::END_OF_STRING : 0);
+
+              std::memcpy(record.data,pData,size);
+
+              pData += size;
+              length -= size;
+            }
+          while(length);
+        }
+
+        std::uint64_t head() const
+        {
+          return head_.load(std::memory_order_relaxed);
+        }
+
+        // producer: committed records not yet drained
+        std::size_t size() const
+        {
+          return head_.load(std::memory_order_relaxed) -
+            tail_.load(std::memory_order_relaxed);
+        }
+
+        std::size_t capacity() const
+        {
+          return records_.size();
+        }
+
+        // producer: rate limit state of a call site, starts zeroed
+        Bucket & bucket(const void * pSite, Level level)
+        {
+          auto & pBucket = buckets_[pSite];
+
+          if(!pBucket)
+            {
+              pBucket.reset(new Bucket{});
+
+              pBucket->level = level;
+
+              pBucket->pNext = pBuckets_.load(std::memory_order_relaxed);
+
+              pBuckets_.store(pBucket.get(),std::memory_order_release);
+            }
+
+          return *pBucket;
+        }
+
+        // consumer: visits the suppressed count of every call site
+        // quiet for at least its refill interval, or of every call
+        // site when bAll. A call site still logging reports its own
+        // count ahead of its next allowed record. Returns true if
+        // counts remain.
+        template<typename Function>
+        bool summarize(std::int64_t i64Now, bool bAll, Function fn)
+        {
+          bool bRemaining{};
+
+          for(Bucket * pBucket = pBuckets_.load(std::memory_order_acquire);
+              pBucket;
+              pBucket = pBucket->pNext)
+            {
+              if(!pBucket->u32Suppressed.load(std::memory_order_relaxed))
+                {
+                  continue;
+                }
+
+              if(bAll ||
+                 i64Now - pBucket->i64Updated.load(std::memory_order_relaxed) >=
+                 pBucket->i64Interval.load(std::memory_order_relaxed))
+                {
+                  std::uint32_t u32Suppressed{pBucket->u32Suppressed.exchange(0,std::memory_order_relaxed)};
+
+                  if(u32Suppressed)
+                    {
+                      fn(pBucket->level,u32Suppressed);
+                    }
+                }
+              else
+                {
+                  bRemaining = true;
+                }
+            }
+
+          return bRemaining;
+        }
+
+        // producer: an entry did not fit
+        void drop()
+        {
+          dropped_.fetch_add(1,std::memory_order_relaxed);
+
+          pCounters_->u64Dropped.fetch_add(1,std::memory_order_relaxed);
+        }
+
+        // consumer: entries dropped since the last call
+        std::uint64_t dropped()
+        {
+          return dropped_.exchange(0,std::memory_order_relaxed);
+        }
+
+        void commit(std::uint64_t u64Head)
+        {
+          records_[(u64Head - 1) & mask_].u8Flags |= Record::END_OF_ENTRY;
+
+          head_.store(u64Head,std::memory_order_release);
+        }
+
+        // consumer: visits every committed record in order
+        template<typename Function>
+        std::size_t drain(Function fn)
+        {
+          std::uint64_t u64Tail{tail_.load(std::memory_order_relaxed)};
+          std::uint64_t u64Head{head_.load(std::memory_order_acquire)};
+
+          for(std::uint64_t i = u64Tail; i != u64Head; ++i)
+            {
+              fn(records_[i & mask_]);
+            }
+
+          tail_.store(u64Head,std::memory_order_release);
+
+          return u64Head - u64Tail;
+        }
+
+        bool empty() const
+        {
+          return head_.load(std::memory_order_acquire) ==
+            tail_.load(std::memory_order_relaxed);
+        }
+
+        // the owning client has been destroyed
+        void close()
+        {
+          bClosed_.store(true,std::memory_order_relaxed);
+        }
+
+        bool closed() const
+        {
+          return bClosed_.load(std::memory_order_relaxed);
+        }
+
+        const std::string & label() const
+        {
+          return sLabel_;
+        }
+
+        std::uint64_t owner() const
+        {
+          return u64Owner_;
+        }
+
+        const std::shared_ptr<Counters> & counters() const
+        {
+          return pCounters_;
+        }
+
+      private:
+        alignas(64) std::atomic<std::uint64_t> head_;
+        alignas(64) std::atomic<std::uint64_t> tail_;
+        alignas(64) std::atomic<bool> bClosed_;
+        std::atomic<std::uint64_t> dropped_;
+        std::vector<Record> records_;
+        std::uint64_t mask_;
+        std::string sLabel_;
+        std::uint64_t u64Owner_;
+        std::shared_ptr<Counters> pCounters_;
+        std::unordered_map<const void *,std::unique_ptr<Bucket>> buckets_;
+        std::atomic<Bucket *> pBuckets_{};
+      };
+    }
+  }
+}
+
+#endif // OPENTESTPOINT_TOOLKIT_LOGRING_HEADER_
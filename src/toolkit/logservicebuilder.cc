@@ -37,7 +37,8 @@
 
 OpenTestPoint::Toolkit::Log::Service *
 OpenTestPoint::Toolkit::Log::ServiceBuilder::buildService(Level level,
-                                                          const std::string & sLogFileName)
+                                                          const std::string & sLogFileName,
+                                                          const SinkOptions & options)
 {
-  return new ServiceImpl{level,sLogFileName};
+  return new ServiceImpl{level,sLogFileName,options};
 }
@@ -37,18 +37,19 @@
 #include "logservice.pb.h"
 #include "logutils.h"
 
-#include "otestpoint/toolkit/transaction.h"
 #include "otestpoint/toolkit/exception.h"
 
 #include <zmq.h>
+#include <algorithm>
 #include <iostream>
-#include <sstream>
 
 OpenTestPoint::Toolkit::Log::ServiceImpl::ServiceImpl(Level level,
-                                                      const std::string & sLogFileName):
+                                                      const std::string & sLogFileName,
+                                                      const SinkOptions & options):
   level_(level),
-  sLogFileName_(sLogFileName)
-
+  pSink_{new Sink{sLogFileName,options}},
+  u64Received_{},
+  flushInterval_{options.flushInterval}
 {
   pContext_.reset(zmq_ctx_new());
 
@@ -73,25 +74,14 @@ OpenTestPoint::Toolkit::Log::ServiceImpl::ServiceImpl(Level level,
     }
 
 
-  if(!sLogFileName_.empty())
-    {
-      logStream_.open(sLogFileName_.c_str(), std::ios::out);
-
-      if(!logStream_)
-        {
-          throw Exception{"unable to open log file: %s",sLogFileName_.c_str()};
-        }
-    }
-
-
   thread_ = std::move(std::thread(&ServiceImpl::process,this));
 }
 
 OpenTestPoint::Toolkit::Log::ServiceImpl::~ServiceImpl()
 {
-  for(const auto & controlSocket: controlSockets_)
+  for(const auto & entry : controlSockets_)
     {
-      zmq_close(controlSocket);
+      zmq_close(entry.second);
     }
 
   std::string sSerialization{};
@@ -111,6 +101,13 @@ OpenTestPoint::Toolkit::Log::ServiceImpl::~ServiceImpl()
 void OpenTestPoint::Toolkit::Log::ServiceImpl::add(const std::string & sControlEndpoint,
                                                    const std::string & sPublishEndpoint)
 {
+  std::lock_guard<std::mutex> lock(controlMutex_);
+
+  if(controlSockets_.count(sControlEndpoint))
+    {
+      return;
+    }
+
   OpenTestPoint_Toolkit::LogServiceImpl command;
 
   command.set_type(OpenTestPoint_Toolkit::LogServiceImpl::TYPE_ADD);
@@ -132,13 +129,17 @@ void OpenTestPoint::Toolkit::Log::ServiceImpl::add(const std::string & sControlE
 
   void * pControlSocket{};
 
-  if(!(pControlSocket = zmq_socket(pContext_.get(),ZMQ_REQ)))
+  if(!(pControlSocket = zmq_socket(pContext_.get(),ZMQ_DEALER)))
     {
       throw Exception{"unable to create log client control socket: %s (%s)",
           zmq_strerror(errno),
           sControlEndpoint.c_str()};
     }
 
+  int iLinger{0};
+
+  zmq_setsockopt(pControlSocket,ZMQ_LINGER,&iLinger,sizeof(iLinger));
+
   if(zmq_connect(pControlSocket,sControlEndpoint.c_str()) < 0)
     {
       zmq_close(pControlSocket);
@@ -147,45 +148,138 @@ void OpenTestPoint::Toolkit::Log::ServiceImpl::add(const std::string & sControlE
           sControlEndpoint.c_str()};
     }
 
-  controlSockets_.push_back(pControlSocket);
+  controlSockets_.insert(std::make_pair(sControlEndpoint,pControlSocket));
 
-  transaction<OpenTestPoint_Toolkit::LogClient,
-              OpenTestPoint_Toolkit::LogServer>
-    (pControlSocket,
-     OpenTestPoint_Toolkit::LogClient::TYPE_SETLOGLEVEL,
-     std::chrono::milliseconds{10000},
-     [this](OpenTestPoint_Toolkit::LogClient & request)
-     {
-       auto pSetLogLevel = request.mutable_setloglevel();
+  if(sSetLogLevel_.empty())
+    {
+      update();
+    }
 
-       pSetLogLevel->set_level(convertLogLevel(level_));
-     });
+  push(pControlSocket);
+}
+
+void OpenTestPoint::Toolkit::Log::ServiceImpl::remove(const std::string & sControlEndpoint,
+                                                      const std::string & sPublishEndpoint)
+{
+  std::lock_guard<std::mutex> lock(controlMutex_);
+
+  auto iter = controlSockets_.find(sControlEndpoint);
+
+  if(iter == controlSockets_.end())
+    {
+      return;
+    }
+
+  zmq_close(iter->second);
+
+  controlSockets_.erase(iter);
+
+  OpenTestPoint_Toolkit::LogServiceImpl command;
+
+  command.set_type(OpenTestPoint_Toolkit::LogServiceImpl::TYPE_REMOVE);
+
+  command.mutable_remove()->set_publish(sPublishEndpoint);
+
+  std::string sSerialization;
+
+  if(!command.SerializeToString(&sSerialization))
+    {
+      throw Exception{"unable to serialize logger message"};
+    }
+
+  zmq_send(pInternalSocket_.get(),sSerialization.c_str(),sSerialization.length(),0);
 }
 
 void OpenTestPoint::Toolkit::Log::ServiceImpl::setLevel(Level level)
 {
+  std::lock_guard<std::mutex> lock(controlMutex_);
+
   level_ = level;
 
-  for(const auto & pControlSocket : controlSockets_)
+  update();
+
+  for(const auto & entry : controlSockets_)
     {
-      transaction<OpenTestPoint_Toolkit::LogClient,
-                  OpenTestPoint_Toolkit::LogServer>
-        (pControlSocket,
-         OpenTestPoint_Toolkit::LogClient::TYPE_SETLOGLEVEL,
-         std::chrono::milliseconds{10000},
-         [level](OpenTestPoint_Toolkit::LogClient & request)
-         {
-           auto pSetLogLevel = request.mutable_setloglevel();
-
-           pSetLogLevel->set_level(convertLogLevel(level));
-         });
+      push(entry.second);
     }
 }
 
-void OpenTestPoint::Toolkit::Log::ServiceImpl::process()
+void OpenTestPoint::Toolkit::Log::ServiceImpl::setLevelRules(const LevelRules & rules)
+{
+  std::lock_guard<std::mutex> lock(controlMutex_);
+
+  rules_ = rules;
+
+  update();
+
+  for(const auto & entry : controlSockets_)
+    {
+      push(entry.second);
+    }
+}
+
+OpenTestPoint::Toolkit::Log::ServiceStatistics
+OpenTestPoint::Toolkit::Log::ServiceImpl::getStatistics() const
+{
+  ServiceStatistics statistics{};
+
+  statistics.u64Received = u64Received_.load(std::memory_order_relaxed);
+
+  pSink_->getStatistics(statistics);
+
+  return statistics;
+}
+
+void OpenTestPoint::Toolkit::Log::ServiceImpl::update()
+{
+  OpenTestPoint_Toolkit::LogClient request{};
+
+  request.set_type(OpenTestPoint_Toolkit::LogClient::TYPE_SETLOGLEVEL);
+
+  auto pSetLogLevel = request.mutable_setloglevel();
+
+  pSetLogLevel->set_level(convertLogLevel(level_));
+
+  for(const auto & rule : rules_)
+    {
+      auto pRule = pSetLogLevel->add_rules();
+
+      pRule->set_label(rule.first);
+
+      pRule->set_level(convertLogLevel(rule.second));
+    }
+
+  if(!request.SerializeToString(&sSetLogLevel_))
+    {
+      throw Exception{"unable to serialize log level request"};
+    }
+}
+
+void OpenTestPoint::Toolkit::Log::ServiceImpl::push(void * pControlSocket)
+{
+  // responses to earlier pushes
+  drain(pControlSocket);
+
+  // a dealer frames the request for the client rep socket with an
+  // empty delimiter
+  zmq_send(pControlSocket,"",0,ZMQ_SNDMORE | ZMQ_DONTWAIT);
+
+  zmq_send(pControlSocket,sSetLogLevel_.c_str(),sSetLogLevel_.size(),ZMQ_DONTWAIT);
+}
+
+void OpenTestPoint::Toolkit::Log::ServiceImpl::drain(void * pControlSocket)
 {
-  std::ostream & log = sLogFileName_.empty() ? std::cout : logStream_;
+  zmq_msg_t message;
 
+  zmq_msg_init(&message);
+
+  while(zmq_msg_recv(&message,pControlSocket,ZMQ_DONTWAIT) >= 0);
+
+  zmq_msg_close(&message);
+}
+
+void OpenTestPoint::Toolkit::Log::ServiceImpl::process()
+{
   try
     {
       Toolkit::RAIIZMQSocket pInternalSocket{zmq_socket(pContext_.get(),ZMQ_PAIR)};
@@ -213,6 +307,14 @@ void OpenTestPoint::Toolkit::Log::ServiceImpl::process()
       // subscribe to all logs
       zmq_send(pXSubSocket.get(),"\x1log",4,0);
 
+      using Clock = std::chrono::steady_clock;
+
+      // buffered records are written at most flushInterval_ after the
+      // first of them arrived
+      Clock::time_point flushTime{};
+
+      OpenTestPoint_Toolkit::LogPublisher logPublisher;
+
       bool bRun{true};
 
       while(bRun)
@@ -223,13 +325,29 @@ void OpenTestPoint::Toolkit::Log::ServiceImpl::process()
               {pXSubSocket.get(),0,ZMQ_POLLIN,0},
             };
 
-          int rc = zmq_poll(&items[0], items.size(), -1);
+          long lTimeout{-1};
+
+          if(pSink_->pending())
+            {
+              lTimeout = std::max(0L,
+                                  static_cast<long>(std::chrono::duration_cast<std::chrono::milliseconds>
+                                                    (flushTime - Clock::now()).count()));
+            }
+
+          int rc = zmq_poll(&items[0], items.size(), lTimeout);
 
           if(rc == -1)
             {
               continue;
             }
 
+          if(!rc)
+            {
+              pSink_->flush();
+
+              continue;
+            }
+
           for(const auto & item : items)
             {
               // process internal messages between frontend and backend
@@ -282,6 +400,18 @@ void OpenTestPoint::Toolkit::Log::ServiceImpl::process()
                               }
                           }
                           break;
+
+                        case OpenTestPoint_Toolkit::LogServiceImpl::TYPE_REMOVE:
+                          if(command.has_remove())
+                            {
+                              // stops reconnecting to an exited process
+                              zmq_disconnect(pXSubSocket.get(),command.remove().publish().c_str());
+                            }
+                          else
+                            {
+                              throw Exception{"malformed logger command"};
+                            }
+                          break;
                         }
                     }
                   else if(item.socket == pXSubSocket.get())
@@ -300,8 +430,6 @@ void OpenTestPoint::Toolkit::Log::ServiceImpl::process()
 
                       zmq_msg_recv(&message,item.socket, 0);
 
-                      OpenTestPoint_Toolkit::LogPublisher logPublisher;
-
                       if(!logPublisher.ParseFromArray(zmq_msg_data(&message),
                                                       zmq_msg_size(&message)))
                         {
@@ -310,81 +438,41 @@ void OpenTestPoint::Toolkit::Log::ServiceImpl::process()
                           throw Exception{"unable to deserialize log publisher command"};
                         }
 
-                      if(logPublisher.type() == OpenTestPoint_Toolkit::LogPublisher::TYPE_RECORD)
+                      if(!pSink_->pending())
                         {
-                          const auto & record = logPublisher.record();
+                          flushTime = Clock::now() + flushInterval_;
+                        }
 
-                          std::uint16_t iLength{};
+                      // errors are written without waiting for the
+                      // flush interval
+                      bool bFlush{};
 
-                          std::stringstream ssBuf{};
+                      auto write = [this,&bFlush](const OpenTestPoint_Toolkit::LogPublisher::Record & record)
+                        {
+                          pSink_->write(record);
 
-                          std::stringstream ssLabel{};
+                          u64Received_.fetch_add(1,std::memory_order_relaxed);
 
-                          ssLabel<<record.label();
+                          bFlush |= record.level() <= OpenTestPoint_Toolkit::LogLevel::TYPE_ERROR;
+                        };
 
-                          for(int i = 0; i < record.logs_size(); ++i)
+                      if(logPublisher.type() == OpenTestPoint_Toolkit::LogPublisher::TYPE_RECORD)
+                        {
+                          write(logPublisher.record());
+                        }
+                      else if(logPublisher.type() == OpenTestPoint_Toolkit::LogPublisher::TYPE_RECORDS)
+                        {
+                          for(const auto & record : logPublisher.records())
                             {
-                              std::string sRecord{record.logs(i)};
-
-                              if(sRecord[0] == '/')
-                                {
-                                  auto pos = sRecord.find(' ');
-
-                                  ssLabel<<sRecord.substr(0,pos);
-
-                                  if(pos != std::string::npos)
-                                    {
-                                      sRecord = sRecord.substr(pos+1);
-                                    }
-                                  else
-                                    {
-                                      sRecord.clear();
-                                    }
-                                }
-
-                              if(!sRecord.empty())
-                                {
-                                  if(ssBuf.str().empty())
-                                    {
-                                      ssBuf<<sRecord;
-                                    }
-                                  else
-                                    {
-                                      ssBuf<<" "<<sRecord;
-                                    }
-                                }
+                              write(record);
                             }
+                        }
 
-                          using Clock = std::chrono::high_resolution_clock;
-
-                          auto timestamp = std::chrono::microseconds{record.timestamp()};
-
-                          std::time_t t{Clock::to_time_t(Clock::time_point{timestamp})};;
-
-                          std::tm ltm;
-
-                          localtime_r(&t, &ltm);
-
-                          char buf[64];
-
-                          iLength =
-                            snprintf(buf, sizeof(buf),"%02d:%02d:%02d.%06zu",
-                                     ltm.tm_hour,
-                                     ltm.tm_min,
-                                     ltm.tm_sec,
-                                     timestamp.count()%1000000);
-
-                          buf[iLength] ='\0';
-
-                          log<<buf
-                             <<" "
-                             <<logLevelToString(record.level()).c_str()
-                             <<" ["
-                             <<ssLabel.str()
-                             <<"] "
-                             <<ssBuf.str()
-                             <<std::endl;
+                      if(bFlush || Clock::now() >= flushTime)
+                        {
+                          pSink_->flush();
                         }
+
                       zmq_msg_close(&message);
 
                       zmq_msg_close(&message);
@@ -399,4 +487,6 @@ void OpenTestPoint::Toolkit::Log::ServiceImpl::process()
     }
   catch(...)
     {}
+
+  pSink_->flush();
 }
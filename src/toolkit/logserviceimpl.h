@@ -36,11 +36,17 @@
 #define OPENTESTPOINT_TOOLKIT_LOG_SERVICEIMPL_HEADER_
 
 #include "otestpoint/toolkit/log/service.h"
+#include "otestpoint/toolkit/log/sinkoptions.h"
 #include "otestpoint/toolkit/raiizmq.h"
+#include "logsink.h"
 
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <thread>
 #include <vector>
-#include <fstream>
 
 namespace OpenTestPoint
 {
@@ -52,25 +58,43 @@ namespace OpenTestPoint
       {
       public:
         ServiceImpl(Level level,
-                    const std::string & sLogFileName = "");
+                    const std::string & sLogFileName = "",
+                    const SinkOptions & options = SinkOptions{});
 
         ~ServiceImpl();
 
         void add(const std::string & sControlEndpoint,
                  const std::string & sPublishEndpoint) override;
 
+        void remove(const std::string & sControlEndpoint,
+                    const std::string & sPublishEndpoint) override;
+
         void setLevel(Level level) override;
 
+        void setLevelRules(const LevelRules & rules) override;
+
+        ServiceStatistics getStatistics() const override;
+
       private:
         RAIIZMQContext pContext_;
         RAIIZMQSocket pInternalSocket_;
+        std::mutex controlMutex_;
         std::thread thread_;
-        using ControlSockets = std::vector<void *>;
+        // control socket per log multiplexer endpoint, clients of a
+        // process share one log multiplexer
+        using ControlSockets = std::map<std::string,void *>;
         ControlSockets controlSockets_;
         Level level_;
-        std::string sLogFileName_;
-        std::ofstream logStream_;
+        LevelRules rules_;
+        // serialized SETLOGLEVEL request for the level and rules
+        std::string sSetLogLevel_;
+        std::unique_ptr<Sink> pSink_;
+        std::atomic<std::uint64_t> u64Received_;
+        std::chrono::milliseconds flushInterval_;
         void process();
+        void update();
+        void push(void * pControlSocket);
+        void drain(void * pControlSocket);
       };
     }
   }
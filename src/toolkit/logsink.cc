@@ -0,0 +1,428 @@
+/*
+ * Copyright (c) 2026 - Adjacent Link LLC, Bridgewater, New Jersey
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  * Neither the name of Adjacent Link LLC nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * See toplevel COPYING for more information.
+ */
+
+#include "logsink.h"
+#include "otestpoint/toolkit/exception.h"
+#include "otestpoint/toolkit/log/arguments.h"
+
+#include <google/protobuf/io/coded_stream.h>
+
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace
+{
+  const char * levelNames[] =
+    {
+      "NOLOG",
+      "ABORT",
+      "ERROR",
+      "INFO",
+      "DEBUG",
+    };
+
+  const char * levelName(OpenTestPoint_Toolkit::LogLevel level)
+  {
+    return static_cast<unsigned>(level) < sizeof(levelNames) / sizeof(levelNames[0]) ?
+      levelNames[level] : "UNKNOWN";
+  }
+
+  void appendJSONString(std::string & buffer, const std::string & s)
+  {
+    buffer.push_back('"');
+
+    for(unsigned char c : s)
+      {
+        switch(c)
+          {
+          case '"':
+            buffer.append("\\\"",2);
+            break;
+          case '\\':
+            buffer.append("\\\\",2);
+            break;
+          case '\n':
+            buffer.append("\\n",2);
+            break;
+          case '\r':
+            buffer.append("\\r",2);
+            break;
+          case '\t':
+            buffer.append("\\t",2);
+            break;
+          default:
+            if(c < 0x20)
+              {
+                char buf[7];
+                snprintf(buf,sizeof(buf),"\\u%04x",c);
+                buffer.append(buf,6);
+              }
+            else
+              {
+                buffer.push_back(c);
+              }
+          }
+      }
+
+    buffer.push_back('"');
+  }
+}
+
+OpenTestPoint::Toolkit::Log::SinkFormat
+OpenTestPoint::Toolkit::Log::toSinkFormat(const std::string & sFormat)
+{
+  if(sFormat == "text")
+    {
+      return SinkFormat::TEXT;
+    }
+  else if(sFormat == "json")
+    {
+      return SinkFormat::JSON;
+    }
+  else if(sFormat == "binary")
+    {
+      return SinkFormat::BINARY;
+    }
+
+  throw Exception{"unknown log format: %s",sFormat.c_str()};
+}
+
+OpenTestPoint::Toolkit::Log::Sink::Sink(const std::string & sFileName,
+                                        const SinkOptions & options):
+  sFileName_{sFileName},
+  options_(options),
+  iFd_{STDOUT_FILENO},
+  u64FileBytes_{},
+  u64FileRecords_{},
+  u64Buffered_{},
+  u64Written_{},
+  u64Lost_{},
+  u64Writes_{},
+  u64WriteTotalUsec_{},
+  u64WriteMaxUsec_{},
+  lastSecond_{-1},
+  time_{}
+{
+  buffer_.reserve(options_.bufferSize + 1024);
+
+  if(!sFileName_.empty())
+    {
+      open();
+
+      if(iFd_ < 0)
+        {
+          throw Exception{"unable to open log file: %s",sFileName_.c_str()};
+        }
+    }
+}
+
+OpenTestPoint::Toolkit::Log::Sink::~Sink()
+{
+  flush();
+
+  if(iFd_ >= 0 && iFd_ != STDOUT_FILENO)
+    {
+      close(iFd_);
+    }
+}
+
+bool OpenTestPoint::Toolkit::Log::Sink::pending() const
+{
+  return !buffer_.empty();
+}
+
+void OpenTestPoint::Toolkit::Log::Sink::getStatistics(ServiceStatistics & statistics) const
+{
+  statistics.u64Written = u64Written_.load(std::memory_order_relaxed);
+  statistics.u64Lost = u64Lost_.load(std::memory_order_relaxed);
+  statistics.u64Writes = u64Writes_.load(std::memory_order_relaxed);
+  statistics.u64WriteTotalUsec = u64WriteTotalUsec_.load(std::memory_order_relaxed);
+  statistics.u64WriteMaxUsec = u64WriteMaxUsec_.load(std::memory_order_relaxed);
+}
+
+void OpenTestPoint::Toolkit::Log::Sink::open()
+{
+  iFd_ = ::open(sFileName_.c_str(),O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC,0644);
+
+  u64FileBytes_ = 0;
+  u64FileRecords_ = 0;
+}
+
+void OpenTestPoint::Toolkit::Log::Sink::rotate()
+{
+  flush();
+
+  if(iFd_ >= 0)
+    {
+      close(iFd_);
+    }
+
+  if(options_.u32RotateKeep)
+    {
+      for(auto i = options_.u32RotateKeep; i > 1; --i)
+        {
+          std::rename((sFileName_ + "." + std::to_string(i - 1)).c_str(),
+                      (sFileName_ + "." + std::to_string(i)).c_str());
+        }
+
+      std::rename(sFileName_.c_str(),(sFileName_ + ".1").c_str());
+    }
+
+  open();
+
+  if(iFd_ < 0)
+    {
+      std::cerr<<"unable to open log file: "<<sFileName_<<": "<<strerror(errno)<<std::endl;
+    }
+}
+
+void OpenTestPoint::Toolkit::Log::Sink::flush()
+{
+  if(buffer_.empty())
+    {
+      return;
+    }
+
+  const char * p{buffer_.data()};
+  std::size_t remaining{buffer_.size()};
+
+  auto start = std::chrono::steady_clock::now();
+
+  while(remaining && iFd_ >= 0)
+    {
+      ssize_t written{::write(iFd_,p,remaining)};
+
+      if(written < 0)
+        {
+          if(errno == EINTR)
+            {
+              continue;
+            }
+
+          break;
+        }
+
+      p += written;
+      remaining -= written;
+    }
+
+  std::uint64_t u64Usec = std::chrono::duration_cast<std::chrono::microseconds>
+    (std::chrono::steady_clock::now() - start).count();
+
+  // only the service thread updates the counters
+  u64Writes_.store(u64Writes_.load(std::memory_order_relaxed) + 1,
+                   std::memory_order_relaxed);
+
+  u64WriteTotalUsec_.store(u64WriteTotalUsec_.load(std::memory_order_relaxed) + u64Usec,
+                           std::memory_order_relaxed);
+
+  if(u64Usec > u64WriteMaxUsec_.load(std::memory_order_relaxed))
+    {
+      u64WriteMaxUsec_.store(u64Usec,std::memory_order_relaxed);
+    }
+
+  // records of a partially written buffer are counted as lost
+  auto & counter = remaining ? u64Lost_ : u64Written_;
+
+  counter.store(counter.load(std::memory_order_relaxed) + u64Buffered_,
+                std::memory_order_relaxed);
+
+  u64Buffered_ = 0;
+
+  buffer_.clear();
+}
+
+void OpenTestPoint::Toolkit::Log::Sink::write(const OpenTestPoint_Toolkit::LogPublisher::Record & record)
+{
+  if(!sFileName_.empty() &&
+     ((options_.u64RotateSize && u64FileBytes_ >= options_.u64RotateSize) ||
+      (options_.u64RotateRecords && u64FileRecords_ >= options_.u64RotateRecords)))
+    {
+      rotate();
+    }
+
+  // label suffixes are log strings starting with '/', the remaining
+  // strings are joined by a space
+  sLabel_ = record.label();
+
+  sMessage_.clear();
+
+  auto append = [this](const char * pzString, std::size_t length)
+    {
+      if(length && pzString[0] == '/')
+        {
+          const char * pSpace{static_cast<const char *>(std::memchr(pzString,' ',length))};
+
+          std::size_t suffix{pSpace ? static_cast<std::size_t>(pSpace - pzString) : length};
+
+          sLabel_.append(pzString,suffix);
+
+          if(pSpace)
+            {
+              ++suffix;
+            }
+
+          pzString += suffix;
+          length -= suffix;
+        }
+
+      if(length)
+        {
+          if(!sMessage_.empty())
+            {
+              sMessage_.push_back(' ');
+            }
+
+          sMessage_.append(pzString,length);
+        }
+    };
+
+  if(record.has_format())
+    {
+      std::string sFormatted{Arguments::format(record.format().c_str(),
+                                               record.arguments().data(),
+                                               record.arguments().size())};
+
+      append(sFormatted.data(),sFormatted.size());
+    }
+
+  for(const auto & log : record.logs())
+    {
+      append(log.data(),log.size());
+    }
+
+  std::size_t before{buffer_.size()};
+
+  switch(options_.format)
+    {
+    case SinkFormat::TEXT:
+      appendText(record);
+      break;
+    case SinkFormat::JSON:
+      appendJSON(record);
+      break;
+    case SinkFormat::BINARY:
+      appendBinary(record);
+      break;
+    }
+
+  u64FileBytes_ += buffer_.size() - before;
+
+  ++u64FileRecords_;
+
+  ++u64Buffered_;
+
+  if(buffer_.size() >= options_.bufferSize)
+    {
+      flush();
+    }
+}
+
+void OpenTestPoint::Toolkit::Log::Sink::appendText(const OpenTestPoint_Toolkit::LogPublisher::Record & record)
+{
+  std::time_t t{static_cast<std::time_t>(record.timestamp() / 1000000)};
+
+  // localtime_r only when the second changes
+  if(t != lastSecond_)
+    {
+      std::tm ltm;
+
+      localtime_r(&t, &ltm);
+
+      snprintf(time_,sizeof(time_),"%02d:%02d:%02d",
+               ltm.tm_hour,
+               ltm.tm_min,
+               ltm.tm_sec);
+
+      lastSecond_ = t;
+    }
+
+  char buf[16];
+
+  int iLength{snprintf(buf,sizeof(buf),".%06u ",
+                       static_cast<unsigned>(record.timestamp() % 1000000))};
+
+  buffer_.append(time_,8);
+  buffer_.append(buf,iLength);
+  buffer_.append(levelName(record.level()));
+  buffer_.append(" [",2);
+  buffer_.append(sLabel_);
+  buffer_.append("] ",2);
+  buffer_.append(sMessage_);
+  buffer_.push_back('\n');
+}
+
+void OpenTestPoint::Toolkit::Log::Sink::appendJSON(const OpenTestPoint_Toolkit::LogPublisher::Record & record)
+{
+  buffer_.append("{\"timestamp\":");
+  buffer_.append(std::to_string(record.timestamp()));
+  buffer_.append(",\"level\":\"");
+  buffer_.append(levelName(record.level()));
+  buffer_.append("\",\"label\":");
+  appendJSONString(buffer_,sLabel_);
+  buffer_.append(",\"message\":");
+  appendJSONString(buffer_,sMessage_);
+  buffer_.append("}\n",2);
+}
+
+void OpenTestPoint::Toolkit::Log::Sink::appendBinary(const OpenTestPoint_Toolkit::LogPublisher::Record & record)
+{
+  binary_.set_timestamp(record.timestamp());
+  binary_.set_level(record.level());
+  binary_.set_label(sLabel_);
+
+  if(!binary_.logs_size())
+    {
+      binary_.add_logs();
+    }
+
+  *binary_.mutable_logs(0) = sMessage_;
+
+  std::size_t size{binary_.ByteSizeLong()};
+
+  std::size_t offset{buffer_.size()};
+
+  buffer_.resize(offset + google::protobuf::io::CodedOutputStream::VarintSize32(size) + size);
+
+  auto pTarget = reinterpret_cast<std::uint8_t *>(&buffer_[offset]);
+
+  pTarget = google::protobuf::io::CodedOutputStream::WriteVarint32ToArray(size,pTarget);
+
+  binary_.SerializeWithCachedSizesToArray(pTarget);
+}
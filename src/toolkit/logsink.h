@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2026 - Adjacent Link LLC, Bridgewater, New Jersey
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  * Neither the name of Adjacent Link LLC nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * See toplevel COPYING for more information.
+ */
+
+#ifndef OPENTESTPOINT_TOOLKIT_LOGSINK_HEADER_
+#define OPENTESTPOINT_TOOLKIT_LOGSINK_HEADER_
+
+#include "otestpoint/toolkit/log/sinkoptions.h"
+#include "otestpoint/toolkit/log/statistics.h"
+#include "logservice.pb.h"
+
+#include <atomic>
+#include <cstdint>
+#include <ctime>
+#include <string>
+
+namespace OpenTestPoint
+{
+  namespace Toolkit
+  {
+    namespace Log
+    {
+      // formats log records into a reusable buffer written to stdout
+      // or a log file, rotating the file by size or record count
+      class Sink
+      {
+      public:
+        Sink(const std::string & sFileName,
+             const SinkOptions & options);
+
+        ~Sink();
+
+        void write(const OpenTestPoint_Toolkit::LogPublisher::Record & record);
+
+        void flush();
+
+        bool pending() const;
+
+        // written, lost and write timing counters, safe to call from
+        // any thread
+        void getStatistics(ServiceStatistics & statistics) const;
+
+      private:
+        std::string sFileName_;
+        SinkOptions options_;
+        int iFd_;
+        std::string buffer_;
+        std::uint64_t u64FileBytes_;
+        std::uint64_t u64FileRecords_;
+
+        // records in buffer_
+        std::uint64_t u64Buffered_;
+
+        std::atomic<std::uint64_t> u64Written_;
+        std::atomic<std::uint64_t> u64Lost_;
+        std::atomic<std::uint64_t> u64Writes_;
+        std::atomic<std::uint64_t> u64WriteTotalUsec_;
+        std::atomic<std::uint64_t> u64WriteMaxUsec_;
+
+        // per record scratch, storage retained across records
+        std::string sLabel_;
+        std::string sMessage_;
+        OpenTestPoint_Toolkit::LogPublisher::Record binary_;
+
+        // HH:MM:SS of the last formatted second
+        std::time_t lastSecond_;
+        char time_[9];
+
+        void open();
+
+        void rotate();
+
+        void appendText(const OpenTestPoint_Toolkit::LogPublisher::Record & record);
+
+        void appendJSON(const OpenTestPoint_Toolkit::LogPublisher::Record & record);
+
+        void appendBinary(const OpenTestPoint_Toolkit::LogPublisher::Record & record);
+      };
+    }
+  }
+}
+
+#endif // OPENTESTPOINT_TOOLKIT_LOGSINK_HEADER_
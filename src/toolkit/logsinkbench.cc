@@ -0,0 +1,198 @@
+/*
+ * Copyright (c) 2026 - Adjacent Link LLC, Bridgewater, New Jersey
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  * Neither the name of Adjacent Link LLC nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * See toplevel COPYING for more information.
+ */
+
+// Measures the log service output cost per record: the previous
+// stream formatting with a flush per line against the buffered sink
+// in each of its formats. Output goes to /dev/null so only
+// formatting and write calls are measured.
+
+#include "logsink.h"
+#include "logservice.pb.h"
+#include "otestpoint/toolkit/log/arguments.h"
+#include "benchmeasure.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <list>
+#include <sstream>
+#include <vector>
+
+namespace
+{
+  using Record = OpenTestPoint_Toolkit::LogPublisher::Record;
+
+  std::vector<Record> records(std::size_t count)
+  {
+    std::vector<Record> records(count);
+
+    auto now = std::chrono::duration_cast<std::chrono::microseconds>
+      (std::chrono::system_clock::now().time_since_epoch()).count();
+
+    for(std::size_t i = 0; i < count; ++i)
+      {
+        auto & record = records[i];
+
+        record.set_timestamp(now + i * 100);
+        record.set_level(OpenTestPoint_Toolkit::LogLevel::TYPE_DEBUG);
+        record.set_label("otestpoint-probe/node1/3");
+
+        if(i % 2)
+          {
+            OpenTestPoint::Toolkit::Log::Arguments arguments{};
+
+            arguments.add(static_cast<unsigned long>(i));
+            arguments.add("Probes.TimeOfDay.node1");
+
+            record.set_format("/manager sending %lu %s");
+            record.set_arguments(arguments.data(),arguments.size());
+          }
+        else
+          {
+            record.add_logs("/probe/timeofday probe");
+          }
+      }
+
+    return records;
+  }
+
+  // the log service output path prior to the sink
+  void stream(std::ostream & log, const Record & record)
+  {
+    std::stringstream ssBuf{};
+
+    std::stringstream ssLabel{};
+
+    ssLabel<<record.label();
+
+    std::list<std::string> logs{record.logs().begin(),
+        record.logs().end()};
+
+    if(record.has_format())
+      {
+        logs.push_front(OpenTestPoint::Toolkit::Log::Arguments::format(record.format().c_str(),
+                                                                        record.arguments().data(),
+                                                                        record.arguments().size()));
+      }
+
+    for(const auto & s : logs)
+      {
+        std::string sRecord{s};
+
+        if(sRecord[0] == '/')
+          {
+            auto pos = sRecord.find(' ');
+
+            ssLabel<<sRecord.substr(0,pos);
+
+            sRecord = pos != std::string::npos ? sRecord.substr(pos+1) : std::string{};
+          }
+
+        if(!sRecord.empty())
+          {
+            if(ssBuf.str().empty())
+              {
+                ssBuf<<sRecord;
+              }
+            else
+              {
+                ssBuf<<" "<<sRecord;
+              }
+          }
+      }
+
+    std::time_t t{static_cast<std::time_t>(record.timestamp() / 1000000)};
+
+    std::tm ltm;
+
+    localtime_r(&t, &ltm);
+
+    char buf[64];
+
+    snprintf(buf, sizeof(buf),"%02d:%02d:%02d.%06u",
+             ltm.tm_hour,
+             ltm.tm_min,
+             ltm.tm_sec,
+             static_cast<unsigned>(record.timestamp() % 1000000));
+
+    log<<buf<<" DEBUG ["<<ssLabel.str()<<"] "<<ssBuf.str()<<std::endl;
+  }
+
+  template<typename Function>
+  void report(const char * pzPath, const std::vector<Record> & records, Function fn)
+  {
+    std::printf("%-8s ns/record=%.1f\n",
+                pzPath,
+                OpenTestPoint::Bench::measure(0,records.size(),
+                                              [&records,&fn](std::size_t i)
+                                              {
+                                                fn(records[i]);
+                                              }));
+  }
+}
+
+int main(int argc, char * argv[])
+{
+  std::size_t count{argc > 1 ? std::strtoul(argv[1],nullptr,10) : 200000};
+
+  auto input = records(count);
+
+  {
+    std::ofstream log{"/dev/null"};
+
+    report("stream",input,[&log](const Record & record){stream(log,record);});
+  }
+
+  const std::pair<const char *,OpenTestPoint::Toolkit::Log::SinkFormat> formats[] =
+    {
+      {"text",OpenTestPoint::Toolkit::Log::SinkFormat::TEXT},
+      {"json",OpenTestPoint::Toolkit::Log::SinkFormat::JSON},
+      {"binary",OpenTestPoint::Toolkit::Log::SinkFormat::BINARY},
+    };
+
+  for(const auto & format : formats)
+    {
+      OpenTestPoint::Toolkit::Log::SinkOptions options{};
+
+      options.format = format.second;
+
+      OpenTestPoint::Toolkit::Log::Sink sink{"/dev/null",options};
+
+      report(format.first,input,[&sink](const Record & record){sink.write(record);});
+    }
+
+  return 0;
+}
@@ -37,8 +37,10 @@
 #include "otestpoint/toolkit/log/client.h"
 #include "otestpoint/toolkit/log/clientbuilder.h"
 #include "otestpoint/toolkit/exception.h"
+#include <cstdint>
 #include <cstdlib>
 #include <cstring>
+#include <frameobject.h>
 
 typedef struct {
   PyObject_HEAD
@@ -115,9 +117,37 @@ PyDoc_STRVAR(Logger_log_doc,
              "message   - Message string to publish.\n\n"
              "Log message strings that contain a / as the first\n"
              "charater in the first word will be appended to the log\n"
-             "topic."
+             "topic.\n\n"
+             "The calling line identifies the call site for rate\n"
+             "limiting, see setratelimit()."
              );
 
+// the calling python line: code object address with the line number
+// in the unused upper bits
+static const void * Logger_callSite()
+{
+  PyFrameObject * pFrame{PyEval_GetFrame()};
+
+  if(!pFrame)
+    {
+      return nullptr;
+    }
+
+#if PY_VERSION_HEX >= 0x03090000
+  PyCodeObject * pCode{PyFrame_GetCode(pFrame)};
+
+  // the frame holds a reference for the duration of the call
+  Py_DECREF(pCode);
+#else
+  PyCodeObject * pCode{pFrame->f_code};
+#endif
+
+  std::uintptr_t site{reinterpret_cast<std::uintptr_t>(pCode) ^
+      (static_cast<std::uintptr_t>(PyFrame_GetLineNumber(pFrame)) << 48)};
+
+  return reinterpret_cast<const void *>(site);
+}
+
 static PyObject * Logger_log(PyObject * self, PyObject * args)
 {
   Logger * pLogger{reinterpret_cast<Logger *>(self)};
@@ -141,13 +171,15 @@ static PyObject * Logger_log(PyObject * self, PyObject * args)
       return nullptr;
     }
 
+  const void * pSite{Logger_callSite()};
+
   Py_BEGIN_ALLOW_THREADS;
 
   try
     {
-      pLogger->pLogClient->log(static_cast<OpenTestPoint::Toolkit::Log::Level>(iLevel),
-                               "%s",
-                               pzMessage);
+      pLogger->pLogClient->logMessage(static_cast<OpenTestPoint::Toolkit::Log::Level>(iLevel),
+                                      pSite,
+                                      pzMessage);
     }
   catch(OpenTestPoint::Toolkit::Exception & exp)
     {
@@ -171,6 +203,55 @@ static PyObject * Logger_log(PyObject * self, PyObject * args)
 }
 
 
+PyDoc_STRVAR(Logger_setratelimit_doc,
+             "setratelimit(level,rate,burst)\n\n"
+             "Limit each call site logging at a level.\n\n"
+             "level     - Log level to limit\n\n"
+             "rate      - Messages per second allowed per call site,\n"
+             "            0 removes the limit.\n\n"
+             "burst     - Messages allowed in a burst.\n\n"
+             "The number of suppressed messages is logged ahead of\n"
+             "the next message the call site is allowed."
+             );
+
+static PyObject * Logger_setratelimit(PyObject * self, PyObject * args)
+{
+  Logger * pLogger{reinterpret_cast<Logger *>(self)};
+
+  int iLevel{};
+
+  double dRate{};
+
+  double dBurst{};
+
+  if(!PyArg_ParseTuple(args,"idd",&iLevel,&dRate,&dBurst))
+    {
+      return nullptr;
+    }
+
+  if(iLevel < 0 || iLevel > 4)
+    {
+      PyErr_SetString(PyExc_ValueError,"invalid log level");
+      return nullptr;
+    }
+
+  try
+    {
+      pLogger->pLogClient->setRateLimit(static_cast<OpenTestPoint::Toolkit::Log::Level>(iLevel),
+                                        dRate,
+                                        dBurst);
+    }
+  catch(OpenTestPoint::Toolkit::Exception & exp)
+    {
+      PyErr_SetString(PyExc_ValueError,exp.what());
+      return nullptr;
+    }
+
+  Py_INCREF(Py_None);
+
+  return Py_None;
+}
+
 static PyMethodDef Logger_methods[] =
   {
    {
@@ -179,6 +260,12 @@ static PyMethodDef Logger_methods[] =
     METH_VARARGS,
     Logger_log_doc,
    },
+   {
+    "setratelimit",
+    (PyCFunction)Logger_setratelimit,
+    METH_VARARGS,
+    Logger_setratelimit_doc,
+   },
    {nullptr,nullptr,0,nullptr}
   };
 